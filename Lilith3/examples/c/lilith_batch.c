@@ -0,0 +1,75 @@
+#include <Python.h>
+#include <math.h>
+#include "lilith.h"
+
+#define NPOINTS 1000
+
+int main(int argc, char* argv[])
+{
+    // Initializing Python/C interface
+    Py_Initialize();
+
+    // Experimental list path, a database compiled from it works as well
+    char experimental_input[] = "../../data/latest.list";
+
+    // Creating an object of the class BatchLikelihood: lilithbatch
+    PyObject* lilithbatch = initialize_lilith_batch(experimental_input);
+
+    // One Higgs state per point with universal couplings CU to up-type
+    // quarks, CD to down-type fermions and CV to vector bosons, scanned along
+    // a line in the (CU, CV) plane. All other couplings are computed.
+    static double couplings[NPOINTS][1][LILITH_NCOUPLINGS];
+    static double masses[NPOINTS][1];
+    static double likelihoods[NPOINTS];
+    int i, j;
+    for(i = 0; i < NPOINTS; i++) {
+        double CU = 0.8 + 0.4*i/(NPOINTS - 1);
+        double CD = 1.;
+        double CV = 1.1 - 0.2*i/(NPOINTS - 1);
+        for(j = 0; j < LILITH_NCOUPLINGS; j++) {
+            couplings[i][0][j] = NAN;
+        }
+        couplings[i][0][LILITH_C_TT] = CU;
+        couplings[i][0][LILITH_C_CC] = CU;
+        couplings[i][0][LILITH_C_BB] = CD;
+        couplings[i][0][LILITH_C_TAUTAU] = CD;
+        couplings[i][0][LILITH_C_MUMU] = CD;
+        couplings[i][0][LILITH_C_WW] = CV;
+        couplings[i][0][LILITH_C_ZZ] = CV;
+        masses[i][0] = 125.;
+    }
+
+    // Getting -2LogL of all points at once
+    if(lilith_batch_likelihood_couplings(lilithbatch, NPOINTS, 1,
+                                         &couplings[0][0][0], &masses[0][0],
+                                         NULL, NULL, likelihoods) == 0) {
+        int best = 0;
+        for(i = 1; i < NPOINTS; i++) {
+            if(likelihoods[i] < likelihoods[best]) {
+                best = i;
+            }
+        }
+        printf("minimal -2*log(L) = %lf at CU = %lf, CV = %lf\n",
+               likelihoods[best], couplings[best][0][LILITH_C_TT],
+               couplings[best][0][LILITH_C_WW]);
+    }
+
+    // The same for signal strengths: the SM for all points
+    static double mu[NPOINTS][1][LILITH_NPRODUCTIONS][LILITH_NDECAYS];
+    int p, d;
+    for(i = 0; i < NPOINTS; i++) {
+        for(p = 0; p < LILITH_NPRODUCTIONS; p++) {
+            for(d = 0; d < LILITH_NDECAYS; d++) {
+                mu[i][0][p][d] = (d == LILITH_INVISIBLE) ? 0. : 1.;
+            }
+        }
+    }
+    if(lilith_batch_likelihood_mu(lilithbatch, NPOINTS, 1, 0,
+                                  &mu[0][0][0][0], likelihoods) == 0) {
+        printf("SM -2*log(L) = %lf\n", likelihoods[0]);
+    }
+
+    // Exiting Python/C interface
+    Py_Finalize();
+    return 0;
+}
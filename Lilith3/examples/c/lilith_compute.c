@@ -1,4 +1,5 @@
 #include <Python.h>
+#include <math.h>
 #include "lilith.h"
 
 int main(int argc, char* argv[])
@@ -89,7 +90,29 @@ int main(int argc, char* argv[])
     float my_likelihood;
     my_likelihood = lilith_computelikelihood(lilithcalc);
     printf("-2*log(L) = %lf\n", my_likelihood);
-  
+
+    // The same input without XML: the reduced couplings as an array in the
+    // order of enum lilith_coupling, NAN for the couplings to be computed
+    double couplings[LILITH_NCOUPLINGS];
+    int i;
+    for(i = 0; i < LILITH_NCOUPLINGS; i++) {
+        couplings[i] = NAN;
+    }
+    couplings[LILITH_C_TT] = CU;
+    couplings[LILITH_C_CC] = CU;
+    couplings[LILITH_C_BB] = CD;
+    couplings[LILITH_C_TAUTAU] = CD;
+    couplings[LILITH_C_MUMU] = 1.;
+    couplings[LILITH_C_ZZ] = CV;
+    couplings[LILITH_C_WW] = CV;
+    couplings[LILITH_C_GAMMAGAMMA] = CGa;
+    couplings[LILITH_C_GG_DECAY] = Cg;
+    couplings[LILITH_C_GG_PROD_LHC8] = Cg;
+    couplings[LILITH_C_GG_PROD_LHC13] = Cg;
+    lilith_readuserinput_couplings(lilithcalc, 1, couplings, &mh, &BRinv,
+                                   &BRund);
+    printf("-2*log(L) without XML = %lf\n",
+           lilith_computelikelihood(lilithcalc));
   
     // Getting exp_ndf
     int exp_ndf;
@@ -32,12 +32,10 @@
 int userread = 0;
 
 /**
-Import Lilith, create a Lilith object and read experimental results
+Add the path to Lilith to sys.path and import the lilith module
 **/
-PyObject* initialize_lilith(char* experimental_input)
+static PyObject* import_lilith(void)
 {
-      PyObject* args;
-
       // |--------------------------------|
       // | Adding Lilith path to sys.path |
       // |--------------------------------|
@@ -55,7 +53,7 @@ PyObject* initialize_lilith(char* experimental_input)
             exit(1);
       }
 
-      if(PyList_Append(sys_path, PyString_FromString(pathtolilith)) < 0) {
+      if(PyList_Append(sys_path, PyUnicode_FromString(pathtolilith)) < 0) {
             printf("Error in appending sys_path and path_to_lh\n");
             exit(1);
       }
@@ -66,7 +64,7 @@ PyObject* initialize_lilith(char* experimental_input)
       // |------------------|
 
       // Defining lilith module
-      PyObject* lilithModuleString = PyString_FromString((char*)"lilith");
+      PyObject* lilithModuleString = PyUnicode_FromString((char*)"lilith");
       // Importing lilith module
       PyObject* lilithModule = PyImport_Import(lilithModuleString);
 
@@ -76,6 +74,92 @@ PyObject* initialize_lilith(char* experimental_input)
             exit(1);
       }
 
+      return lilithModule;
+}
+
+
+/**
+Wrap an array of doubles in a memoryview of the given shape (a tuple, the
+reference is stolen), Py_None for NULL
+**/
+static PyObject* lilith_array(const double* values, int flags, PyObject* shape)
+{
+      Py_ssize_t i, size = sizeof(double);
+      PyObject* bytes;
+      PyObject* view = NULL;
+
+      if(shape == NULL) {
+            return NULL;
+      }
+      if(values == NULL) {
+            Py_DECREF(shape);
+            Py_RETURN_NONE;
+      }
+      for(i = 0; i < PyTuple_Size(shape); i++) {
+            size *= PyLong_AsSsize_t(PyTuple_GetItem(shape, i));
+      }
+      bytes = PyMemoryView_FromMemory((char*)values, size, flags);
+      if(bytes != NULL) {
+            view = PyObject_CallMethod(bytes, "cast", "sO", "d", shape);
+            Py_DECREF(bytes);
+      }
+      Py_DECREF(shape);
+      return view;
+}
+
+
+/**
+Check that all n arrays were created, otherwise release the ones that were
+**/
+static int lilith_arrays_created(PyObject** arrays, int n)
+{
+      int i, j;
+
+      for(i = 0; i < n; i++) {
+            if(arrays[i] == NULL) {
+                  for(j = 0; j < n; j++) {
+                        Py_XDECREF(arrays[j]);
+                  }
+                  return 0;
+            }
+      }
+      return 1;
+}
+
+
+/**
+Check the result of reading the user input
+**/
+static PyObject* lilith_userinput_result(PyObject* lilithcalc,
+                                         PyObject* result)
+{
+      // Checking if error has occured
+      if(result == NULL)
+      {
+        printf("Error during the reading of the user input:\n\n");
+        PyErr_PrintEx(0);
+        printf("\n-2LogL will be set to -1 when evaluated.\n\n");
+        userread = 0;
+        return lilithcalc;
+      }
+
+      else
+      {
+        Py_DECREF(result);
+        userread = 1;
+        return lilithcalc;
+      }
+}
+
+
+/**
+Import Lilith, create a Lilith object and read experimental results
+(from an up to date compiled database next to the list file if there is one)
+**/
+PyObject* initialize_lilith(char* experimental_input)
+{
+      PyObject* args;
+      PyObject* lilithModule = import_lilith();
 
       // |-------------------------------------------------|
       // | Initialize Lilith and read experimental results |
@@ -91,7 +175,7 @@ PyObject* initialize_lilith(char* experimental_input)
       PyObject* lilithsetexpinput = PyObject_GetAttrString(lilithcalc,(char*)"readexpinput");
 
       // Creating the argument for the previous function
-      args = PyTuple_Pack(1, PyString_FromString((char*)experimental_input));
+      args = PyTuple_Pack(1, PyUnicode_FromString((char*)experimental_input));
 
       // Calling the function
       // lastestLHC.list is used by default if no other list was provided
@@ -126,7 +210,7 @@ PyObject* lilith_readuserinput(PyObject* lilithcalc, char* XMLinputstring)
 
       // Passing the user input file to this function
       PyObject* args;
-      args = PyTuple_Pack(1, PyString_FromString(XMLinputstring));
+      args = PyTuple_Pack(1, PyUnicode_FromString(XMLinputstring));
       PyObject_CallObject(readuserinput, args);
 
       // Checking if error has occured
@@ -156,7 +240,7 @@ PyObject* lilith_readuserinput_fromfile(PyObject* lilithcalc, char* XMLinputfile
       PyObject* readuserinput = PyObject_GetAttrString(lilithcalc,(char*)"readuserinputfile");
       // Passing the user input file to this function
       PyObject* args;
-      args = PyTuple_Pack(1, PyString_FromString(XMLinputfile));
+      args = PyTuple_Pack(1, PyUnicode_FromString(XMLinputfile));
       PyObject* lilithcalc_read = PyObject_CallObject(readuserinput, args);
 
       // Checking if error has occured
@@ -175,6 +259,52 @@ PyObject* lilith_readuserinput_fromfile(PyObject* lilithcalc, char* XMLinputfile
 }
 
 
+/**
+Read nstates Higgs states of reduced couplings from arrays, see lilith.h
+**/
+PyObject* lilith_readuserinput_couplings(PyObject* lilithcalc, int nstates,
+                                         const double* couplings,
+                                         const double* masses,
+                                         const double* BRinvisible,
+                                         const double* BRundetected)
+{
+      PyObject* arrays[4] = {
+            lilith_array(couplings, PyBUF_READ,
+                         Py_BuildValue("(ii)", nstates, LILITH_NCOUPLINGS)),
+            lilith_array(masses, PyBUF_READ, Py_BuildValue("(i)", nstates)),
+            lilith_array(BRinvisible, PyBUF_READ,
+                         Py_BuildValue("(i)", nstates)),
+            lilith_array(BRundetected, PyBUF_READ,
+                         Py_BuildValue("(i)", nstates))};
+      PyObject* result = NULL;
+      if(lilith_arrays_created(arrays, 4)) {
+            result = PyObject_CallMethod(
+                  lilithcalc, "readuserinput_couplings", "NNNN", arrays[0],
+                  arrays[1], arrays[2], arrays[3]);
+      }
+      return lilith_userinput_result(lilithcalc, result);
+}
+
+
+/**
+Read nstates Higgs states of signal strengths from arrays, see lilith.h
+**/
+PyObject* lilith_readuserinput_mu(PyObject* lilithcalc, int nstates,
+                                  const double* mu, const double* masses)
+{
+      PyObject* arrays[2] = {
+            lilith_array(mu, PyBUF_READ,
+                         Py_BuildValue("(iii)", nstates, LILITH_NPRODUCTIONS,
+                                       LILITH_NDECAYS)),
+            lilith_array(masses, PyBUF_READ, Py_BuildValue("(i)", nstates))};
+      PyObject* result = NULL;
+      if(lilith_arrays_created(arrays, 2)) {
+            result = PyObject_CallMethod(lilithcalc, "readuserinput_mu", "NN",
+                                         arrays[0], arrays[1]);
+      }
+      return lilith_userinput_result(lilithcalc, result);
+}
+
 /**
 Evaluate -2LogL
 **/
@@ -247,7 +377,7 @@ void lilith_couplings_output(PyObject* lilithcalc, char* outputfilepath)
       PyObject* writecouplings = PyObject_GetAttrString(lilithcalc,(char*)"writecouplings");
       // Passing the output filepath to this function
       PyObject* args;
-      args = PyTuple_Pack(1, PyString_FromString(outputfilepath));
+      args = PyTuple_Pack(1, PyUnicode_FromString(outputfilepath));
 
       PyObject_CallObject(writecouplings, args);
   
@@ -286,10 +416,10 @@ void lilith_likelihood_output(PyObject* lilithcalc, char* outputfilepath, int sl
       // Passing the output filepath to this function
       PyObject* args;
       if(slha==0){
-        args = PyTuple_Pack(2, PyString_FromString(outputfilepath), Py_False);
+        args = PyTuple_Pack(2, PyUnicode_FromString(outputfilepath), Py_False);
         }
       else{
-        args = PyTuple_Pack(2, PyString_FromString(outputfilepath), Py_True);
+        args = PyTuple_Pack(2, PyUnicode_FromString(outputfilepath), Py_True);
         }
       PyObject_CallObject(writeresults, args);
   
@@ -326,10 +456,10 @@ void lilith_mu_output(PyObject* lilithcalc, char* outputfilepath, int tot)
       // Passing the output filepath to this function
       PyObject* args;
       if(tot==0){
-        args = PyTuple_Pack(2, PyString_FromString(outputfilepath), Py_False);
+        args = PyTuple_Pack(2, PyUnicode_FromString(outputfilepath), Py_False);
         }
       else{
-        args = PyTuple_Pack(2, PyString_FromString(outputfilepath), Py_True);
+        args = PyTuple_Pack(2, PyUnicode_FromString(outputfilepath), Py_True);
         }
       PyObject_CallObject(writesignalstrengths, args);
   
@@ -346,3 +476,117 @@ void lilith_mu_output(PyObject* lilithcalc, char* outputfilepath, int tot)
   
 }
 
+
+
+/**
+Import Lilith and create a BatchLikelihood object for the experimental results
+**/
+PyObject* initialize_lilith_batch(char* experimental_input)
+{
+      // only needed to set up the path, the module is imported again below
+      PyObject* lilithModule = import_lilith();
+      Py_DECREF(lilithModule);
+
+      PyObject* batchModule = PyImport_ImportModule("lilith.internal.batch");
+      PyObject* lilithbatch = NULL;
+      if(batchModule != NULL) {
+            // an empty string selects latest.list
+            lilithbatch = PyObject_CallMethod(batchModule, "BatchLikelihood",
+                                              "s", experimental_input);
+            Py_DECREF(batchModule);
+      }
+
+      // Checking if error has occured
+      // If so, Lilith has no been initialized and cannot run: the code will exit
+      if (lilithbatch == NULL) {
+        printf("Error during the initialization of Lilith:\n\n");
+        PyErr_PrintEx(0);
+        printf("\nCode will now exit.\n");
+        exit(1);
+        }
+      else{
+        return lilithbatch;
+        }
+}
+
+
+
+/**
+Check the result of a batch computation of npoints values of -2LogL
+**/
+static int lilith_batch_result(PyObject* result, int npoints,
+                               double* likelihoods)
+{
+      int i;
+
+      // Checking if error has occured
+      // If so, the -2logL is set to -1 and the code keeps on running
+      if(result == NULL) {
+        printf("Error during the computation of the likelihood:\n\n");
+        PyErr_PrintEx(0);
+        printf("\n-2LogL is set to -1 for these points.\n\n");
+        for(i = 0; i < npoints; i++) {
+              likelihoods[i] = -1.;
+        }
+        return -1;
+        }
+      else{
+        Py_DECREF(result);
+        return 0;
+        }
+}
+
+
+/**
+Evaluate -2LogL for the signal strengths of npoints points with nstates Higgs
+states each, see lilith.h
+**/
+int lilith_batch_likelihood_mu(PyObject* lilithbatch, int npoints,
+                               int nstates, int energies, const double* mu,
+                               double* likelihoods)
+{
+      Py_ssize_t size = (Py_ssize_t)npoints*nstates*LILITH_NPRODUCTIONS*
+                        LILITH_NDECAYS*(energies ? LILITH_NENERGIES : 1);
+      PyObject* arrays[2] = {
+            lilith_array(mu, PyBUF_READ, Py_BuildValue("(n)", size)),
+            lilith_array(likelihoods, PyBUF_WRITE,
+                         Py_BuildValue("(i)", npoints))};
+      PyObject* result = NULL;
+      if(lilith_arrays_created(arrays, 2)) {
+            result = PyObject_CallMethod(
+                  lilithbatch, "computelikelihood_mu_buffer", "NiiiN",
+                  arrays[0], npoints, nstates, energies, arrays[1]);
+      }
+      return lilith_batch_result(result, npoints, likelihoods);
+}
+
+
+/**
+Evaluate -2LogL for the reduced couplings of npoints points with nstates Higgs
+states each, see lilith.h
+**/
+int lilith_batch_likelihood_couplings(PyObject* lilithbatch, int npoints,
+                                      int nstates, const double* couplings,
+                                      const double* masses,
+                                      const double* BRinvisible,
+                                      const double* BRundetected,
+                                      double* likelihoods)
+{
+      Py_ssize_t size = (Py_ssize_t)npoints*nstates;
+      PyObject* arrays[5] = {
+            lilith_array(couplings, PyBUF_READ,
+                         Py_BuildValue("(n)", size*LILITH_NCOUPLINGS)),
+            lilith_array(masses, PyBUF_READ, Py_BuildValue("(n)", size)),
+            lilith_array(BRinvisible, PyBUF_READ, Py_BuildValue("(n)", size)),
+            lilith_array(BRundetected, PyBUF_READ, Py_BuildValue("(n)", size)),
+            lilith_array(likelihoods, PyBUF_WRITE,
+                         Py_BuildValue("(i)", npoints))};
+      PyObject* result = NULL;
+      if(lilith_arrays_created(arrays, 5)) {
+            result = PyObject_CallMethod(
+                  lilithbatch, "computelikelihood_couplings_buffer",
+                  "NNNNiiN", arrays[0], arrays[1], arrays[2], arrays[3],
+                  npoints, nstates, arrays[4]);
+      }
+      return lilith_batch_result(result, npoints, likelihoods);
+}
@@ -31,6 +31,11 @@
 PyObject* initialize_lilith(char* );
 PyObject* lilith_readuserinput(PyObject* , char*);
 PyObject* lilith_readuserinput_fromfile(PyObject* , char*);
+PyObject* lilith_readuserinput_couplings(PyObject*, int, const double*,
+                                         const double*, const double*,
+                                         const double*);
+PyObject* lilith_readuserinput_mu(PyObject*, int, const double*,
+                                  const double*);
 
 float lilith_computelikelihood(PyObject*);
 float lilith_exp_ndf(PyObject*);
@@ -38,3 +43,60 @@ void lilith_likelihood_output(PyObject*, char*, int);
 void lilith_mu_output(PyObject*, char*, int);
 void lilith_couplings_output(PyObject*, char*);
 
+
+
+/*
+Input from arrays instead of XML, see lilith/internal/structuredinput.py
+
+lilith_readuserinput_couplings and lilith_readuserinput_mu read the reduced
+couplings or signal strengths of nstates Higgs states from arrays with the
+shapes and orders given below for the batch evaluation, without the leading
+[npoints] dimension and the optional energy dimension. The result is
+evaluated with lilith_computelikelihood.
+
+
+Batch evaluation of many points, see lilith/internal/batch.py
+
+All arrays are contiguous arrays of doubles in row-major (C) order. The
+signal strengths mu have the shape
+  [npoints][nstates][LILITH_NPRODUCTIONS][LILITH_NDECAYS]
+or, if energies is non-zero,
+  [npoints][nstates][LILITH_NENERGIES][LILITH_NPRODUCTIONS][LILITH_NDECAYS]
+with the modes in the order of the enums below. The reduced couplings have
+the shape [npoints][nstates][LILITH_NCOUPLINGS], the couplings after
+LILITH_C_ZZ can be NAN to be computed by Lilith. The masses, BRinvisible and
+BRundetected have the shape [npoints][nstates], the BRs can be NULL for zero.
+The -2LogL of the points are written to likelihoods of size npoints, they are
+NAN for invalid points (e.g. a mass outside of [123, 128] GeV or a NAN
+coupling up to LILITH_C_ZZ). Return 0 on success and -1 on error, in which
+case all likelihoods are set to -1.
+*/
+
+enum lilith_energy { LILITH_RUN1, LILITH_LHC13, LILITH_NENERGIES };
+
+enum lilith_production {
+      LILITH_GGH, LILITH_VBF, LILITH_WH, LILITH_QQZH, LILITH_GGZH,
+      LILITH_TTH, LILITH_THQ, LILITH_THW, LILITH_BBH, LILITH_NPRODUCTIONS
+};
+
+enum lilith_decay {
+      LILITH_GAMMAGAMMA, LILITH_ZZ, LILITH_WW, LILITH_BB, LILITH_TAUTAU,
+      LILITH_GG, LILITH_CC, LILITH_MUMU, LILITH_ZGAMMA, LILITH_INVISIBLE,
+      LILITH_NDECAYS
+};
+
+enum lilith_coupling {
+      LILITH_C_TT, LILITH_C_BB, LILITH_C_CC, LILITH_C_TAUTAU, LILITH_C_MUMU,
+      LILITH_C_WW, LILITH_C_ZZ, LILITH_C_GAMMAGAMMA, LILITH_C_ZGAMMA,
+      LILITH_C_GG_DECAY, LILITH_C_GG_PROD_LHC8, LILITH_C_GG_PROD_LHC13,
+      LILITH_C_VBF, LILITH_C_VBF13, LILITH_C_WH, LILITH_C_QQZH, LILITH_C_THQ,
+      LILITH_C_THQ13, LILITH_C_THW, LILITH_C_THW13, LILITH_C_GGZH,
+      LILITH_C_GGZH13, LILITH_NCOUPLINGS
+};
+
+PyObject* initialize_lilith_batch(char*);
+int lilith_batch_likelihood_mu(PyObject*, int, int, int, const double*,
+                               double*);
+int lilith_batch_likelihood_couplings(PyObject*, int, int, const double*,
+                                      const double*, const double*,
+                                      const double*, double*);
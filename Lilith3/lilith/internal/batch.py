@@ -0,0 +1,490 @@
+##########################################################################
+#
+#  This file is part of Lilith
+#  v1 (2015) by Jeremy Bernon and Beranger Dumont
+#  v2 (2019) by Sabine Kraml, Tran Quang Loc, Dao Thi Nhung, Le Duc Ninh
+#            converted to Python 3 by Marius Bertrand (Jul/Aug 2020)
+#
+#  Web page: http://lpsc.in2p3.fr/projects-th/lilith/
+#
+#  In case of questions email sabine.kraml@lpsc.in2p3.fr
+#
+#
+#    Lilith is free software: you can redistribute it and/or modify
+#    it under the terms of the GNU General Public License as published by
+#    the Free Software Foundation, either version 3 of the License, or
+#    (at your option) any later version.
+#
+#    Lilith is distributed in the hope that it will be useful,
+#    but WITHOUT ANY WARRANTY; without even the implied warranty of
+#    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#    GNU General Public License for more details.
+#
+#    You should have received a copy of the GNU General Public License
+#    along with Lilith.  If not, see <http://www.gnu.org/licenses/>.
+#
+##########################################################################
+
+"""Likelihood of many points at once.
+
+BatchLikelihood evaluates -2 log L for arrays of signal strengths or reduced
+couplings of many parameter points with a fixed number of numpy operations per
+call, instead of reading and processing one XML user input per point. It
+reproduces the results of the Lilith class, with the following differences:
+  - reduced couplings are only available at BEST-QCD precision
+  - invalid points (e.g. outside the range of a Poisson likelihood, with a
+    mass outside of MASS_RANGE or a missing required coupling) give NaN
+    instead of raising an error
+  - the results agree up to round-off from the different order of the
+    operations, typically a few 1e-12 absolute in -2 log L
+"""
+
+import os.path
+import numpy as np
+from ..errors import ExpInputError, UserInputError
+from .readexpinput import ReadExpInput
+from .database import read_database, is_database, mu_index, ENERGIES, \
+    PRODUCTIONS, DECAYS
+from . import brsm as BR_SM
+from . import reducedcouplingsnnlo as RedCoupNNLO
+
+# the reduced couplings along the last axis of the couplings arrays
+# - the first N_REQUIRED have to be given
+# - the others can be NaN, in which case they are computed as for the XML
+#   input: WH = WW, qqZH = ZZ, VBF = WW if WW = ZZ and all other couplings
+#   from tt, bb, cc, tautau, WW and ZZ
+COUPLINGS = ["tt", "bb", "cc", "tautau", "mumu", "WW", "ZZ",
+             "gammagamma", "Zgamma", "gg_decay", "gg_prod_lhc8",
+             "gg_prod_lhc13", "VBF", "VBF13", "WH", "qqZH",
+             "tHq", "tHq13", "tHW", "tHW13", "ggZH", "ggZH13"]
+N_REQUIRED = 7
+
+# the allowed Higgs masses of the reduced couplings input
+MASS_RANGE = (123., 128.)
+
+RUN1_SQRTS = ["1.96", "7", "8", "7.", "8.", "7.0", "8.0", "7+8"]
+
+N_MU = len(ENERGIES) * len(PRODUCTIONS) * len(DECAYS)
+
+# the couplings of the production modes in the order of PRODUCTIONS for
+# each of the ENERGIES
+PROD_COUPLINGS = [
+    ["gg_prod_lhc8", "VBF", "WH", "qqZH", "ggZH", "tt", "tHq", "tHW", "bb"],
+    ["gg_prod_lhc13", "VBF13", "WH", "qqZH", "ggZH13", "tt", "tHq13",
+     "tHW13", "bb"]]
+
+# the couplings of the visible decay modes in the order of DECAYS
+DECAY_COUPLINGS = ["gammagamma", "ZZ", "WW", "bb", "tautau", "gg_decay", "cc",
+                   "mumu", "Zgamma"]
+
+# the form factors of reducedcouplingsnnlo.py: the name of the form factor is
+# prefix + pair + suffix, where the letters of the pair denote the couplings
+# (a single letter for a square)
+_LETTERS = {"T": "tt", "C": "cc", "B": "bb", "L": "tautau", "W": "WW",
+            "Z": "ZZ"}
+_LOOP_PAIRS = ["TT", "CC", "BB", "LL", "WW", "TB", "CB", "TL", "CL", "TW",
+               "CW", "BW", "LW", "BL", "TC"]
+FORMFACTORS = {
+    "gammagamma": ("Cgaga", "", _LOOP_PAIRS),
+    "Zgamma": ("CZga", "", _LOOP_PAIRS),
+    "gg_decay": ("Cgg", "", ["TT", "CC", "BB", "TB", "CB", "TC"]),
+    "gg_prod_lhc8": ("CggF", "_NNLO_LHC8", ["T", "B", "TB"]),
+    "gg_prod_lhc13": ("CggF", "_NNLO_LHC13", ["T", "B", "TB"]),
+    "VBF": ("CVBF", "_NLO", ["W", "Z", "WZ"]),
+    "VBF13": ("CVBF13", "_NLO", ["W", "Z", "WZ"])}
+
+# the fixed quadratic forms of reducedcouplingsnnlo.py
+QUADRATIC_FORMS = {
+    "tHq": [(2.984, "T"), (3.886, "W"), (-5.870, "TW")],
+    "tHq13": [(2.633, "T"), (3.578, "W"), (-5.211, "TW")],
+    "tHW": [(2.426, "T"), (1.818, "W"), (-3.244, "TW")],
+    "tHW13": [(2.909, "T"), (2.310, "W"), (-4.220, "TW")],
+    "ggZH": [(0.372, "T"), (0.0004, "B"), (2.302, "Z"), (0.003, "TB"),
+             (-1.663, "TZ"), (-0.013, "BZ")],
+    "ggZH13": [(0.456, "T"), (0.0004, "B"), (2.455, "Z"), (0.003, "TB"),
+               (-1.902, "TZ"), (-0.011, "BZ")]}
+
+
+def _product(C, pair):
+    return C[_LETTERS[pair[0]]] * C[_LETTERS[pair[-1]]]
+
+
+def _from_expinput(mu):
+    """Convert a measurement of ReadExpInput to the format of
+    read_database."""
+
+    dim = mu["dim"]
+    if dim == 1:
+        axes = ["x"]
+    elif dim == 2:
+        axes = ["x", "y"]
+    else:
+        axes = ["d" + str(i) for i in range(1, dim + 1)]
+    energy = "run1" if mu["sqrts"] in RUN1_SQRTS else "lhc13"
+
+    eff = []
+    for axis in axes:
+        items = list(mu["eff"][axis].items())
+        eff.append((np.array([mu_index(prod, decay, energy)
+                              for (prod, decay), _ in items], dtype=np.intp),
+                    np.array([val for _, val in items])))
+    bestfit = np.array([mu["bestfit"].get(axis, 0.) for axis in axes])
+
+    type = mu["type"] + (str(dim) if dim <= 2 else "N")
+    p = mu["param"]
+    if type == "n1":
+        param = {"left": p["uncertainty"]["left"],
+                 "right": p["uncertainty"]["right"]}
+    elif type == "n2":
+        param = {"a": p["a"], "b": p["b"], "c": p["c"]}
+    elif type == "nN":
+        param = {"inv_cov": p["inv_cov_m"]}
+    elif type == "vn1":
+        param = {"left": abs(p["uncertainty"]["left"]),
+                 "right": p["uncertainty"]["right"]}
+    elif type == "vn2":
+        param = {"left": np.array([abs(p["uncertainty"][a]["left"])
+                                   for a in axes]),
+                 "right": np.array([p["uncertainty"][a]["right"]
+                                    for a in axes]),
+                 "corr": p["correlation"]}
+    elif type == "vnN":
+        param = {"v": np.ravel(p["VGau"]),
+                 "v_prime": np.ravel(p["VGau_prime"]),
+                 "inv_corr": np.linalg.inv(p["corr_m"])}
+    elif type == "p1":
+        param = {"gamma": p["gamma"], "nu": p["nu"]}
+    elif type == "p2":
+        param = {"gamma": np.array([p["gamma"][a] for a in axes]),
+                 "nu": np.array([p["nu"][a] for a in axes]),
+                 "a_corr": p["A_corr"]}
+    elif type in ["f1", "f2"]:
+        param = {"spline": mu["Lxy"]}
+    else:
+        raise ExpInputError(mu["source"], 'likelihood type "' + mu["type"] +
+                            '" is not supported for dim=' + str(dim))
+    return {"source": mu["source"], "type": type, "energy": energy,
+            "mass": mu.get("mass", 125.), "bestfit": bestfit, "eff": eff,
+            "param": param}
+
+
+# -2 log L of the types with parameters of fixed size, evaluated for the
+# deviations d from the best fit of shape (points, measurements, axes) and
+# the parameters stacked along the measurements
+
+def _normal1(d, p):
+    d = d[..., 0]
+    unc = np.where(d < 0, p["left"], p["right"])
+    return d**2 / unc**2
+
+
+def _normal2(d, p):
+    return (p["a"] * d[..., 0]**2 + p["c"] * d[..., 1]**2 +
+            2 * p["b"] * d[..., 0] * d[..., 1])
+
+
+def _varnormal1(d, p):
+    d = d[..., 0]
+    left, right = p["left"], p["right"]
+    return np.where(left == 0, d / right,
+                    np.where(right == 0, -d / left,
+                             d**2 / (left * right + (right - left) * d)))
+
+
+def _varnormal2(d, p):
+    left, right, corr = p["left"], p["right"], p["corr"]
+    v = left * right + (right - left) * d
+    return 1. / (1 - corr**2) * (
+        d[..., 0]**2 / v[..., 0] -
+        2 * corr * d[..., 0] * d[..., 1] / np.sqrt(v[..., 0] * v[..., 1]) +
+        d[..., 1]**2 / v[..., 1])
+
+
+def _poisson1(d, p):
+    d = d[..., 0]
+    alpha = p["nu"] * p["gamma"]
+    return -2. * (-alpha * d + p["nu"] * np.log(1 + alpha * d / p["nu"]))
+
+
+def _poisson2(d, p):
+    gamma, nu, A = p["gamma"], p["nu"], p["a_corr"]
+    alpha = nu * gamma
+    alpha_corr = np.log(1 + A)
+    t1 = -alpha[:, 0] * d[..., 0] + nu[:, 0] * np.log(
+        1 + alpha[:, 0] * d[..., 0] / nu[:, 0])
+    t2a = -alpha[:, 1] * (d[..., 1] + 1 / gamma[:, 1]) * np.exp(
+        alpha_corr * nu[:, 0] -
+        A * alpha[:, 0] * (d[..., 0] + 1 / gamma[:, 0]))
+    t2b = -alpha[:, 1] / gamma[:, 1] * np.exp(
+        alpha_corr * nu[:, 0] - A * alpha[:, 0] / gamma[:, 0])
+    return -2. * (t1 + t2a - t2b + nu[:, 1] * np.log(t2a / t2b))
+
+
+GROUPED_TYPES = {"n1": _normal1, "n2": _normal2, "vn1": _varnormal1,
+                 "vn2": _varnormal2, "p1": _poisson1, "p2": _poisson2}
+
+
+# -2 log L of the other types, evaluated for the deviations d of shape
+# (points, axes) of a single measurement
+
+def _normalN(d, p):
+    return np.einsum("pi,ij,pj->p", d, p["inv_cov"], d)
+
+
+def _varnormalN(d, p):
+    u = d / np.sqrt(p["v"] + p["v_prime"] * d)
+    return np.einsum("pi,ij,pj->p", u, p["inv_corr"], u)
+
+
+def _full1(d, p):
+    if "spline" in p:
+        return np.maximum(p["spline"](d[:, 0]), 0.)
+    x = p["x"]
+    i = np.searchsorted(x, d[:, 0], side="right")
+    h = d[:, 0] - x[np.maximum(i - 1, 0)]
+    y, c, b, a = p["coefficients"][i].T
+    return np.maximum(((a * h + b) * h + c) * h + y, 0.)
+
+
+def _full2(d, p):
+    if "spline" in p:
+        tx, ty = p["spline"].get_knots()
+        return np.maximum(p["spline"](np.clip(d[:, 0], tx[0], tx[-1]),
+                                      np.clip(d[:, 1], ty[0], ty[-1]),
+                                      grid=False), 0.)
+    x, y = p["x"], p["y"]
+    X = np.clip(d[:, 0], x[0], x[-1])
+    Y = np.clip(d[:, 1], y[0], y[-1])
+    i = np.minimum(np.searchsorted(x, X, side="right"), len(x))
+    j = np.minimum(np.searchsorted(y, Y, side="right"), len(y))
+    hx = np.power.outer(X - x[i - 1], np.arange(4))
+    hy = np.power.outer(Y - y[j - 1], np.arange(4))
+    return np.maximum(
+        np.einsum("pkl,pk,pl->p", p["coefficients"][i, j], hx, hy), 0.)
+
+
+SINGLE_TYPES = {"nN": _normalN, "vnN": _varnormalN, "f1": _full1,
+                "f2": _full2}
+
+
+class BatchLikelihood:
+    """Likelihood of arrays of points for fixed experimental input."""
+
+    default_exp_list = ("/".join(
+        os.path.dirname(os.path.abspath(__file__)).split("/")[:-2]) +
+        "/data/latest.list")
+
+    def __init__(self, exp_filepath=None):
+        """Read the experimental input from a .list file or a database
+        compiled from it."""
+
+        if exp_filepath is None or exp_filepath == "":
+            exp_filepath = BatchLikelihood.default_exp_list
+        if is_database(exp_filepath):
+            self.measurements = read_database(exp_filepath)
+        else:
+            exp_input = ReadExpInput()
+            for expfile in exp_input.get_filelist(exp_filepath):
+                exp_input.read_file(expfile)
+            self.measurements = [_from_expinput(mu) for mu in exp_input.mu]
+        self.exp_ndf = sum(len(m["eff"]) for m in self.measurements)
+
+        # the efficiencies of all axes as one matrix, the deviations from the
+        # best fit of all axes are then (mu @ eff.T - bestfit)
+        self.eff = np.zeros((self.exp_ndf, N_MU))
+        self.bestfit = np.concatenate([m["bestfit"]
+                                       for m in self.measurements])
+        first = 0
+        self.groups = {}
+        self.singles = []
+        for k, m in enumerate(self.measurements):
+            dim = len(m["eff"])
+            for axis, (indices, effs) in enumerate(m["eff"]):
+                np.add.at(self.eff[first + axis], indices, effs)
+            if m["type"] in GROUPED_TYPES:
+                self.groups.setdefault(m["type"], []).append((first, m, k))
+            else:
+                self.singles.append((slice(first, first + dim), m, k))
+            first += dim
+        for type, group in list(self.groups.items()):
+            dim = len(group[0][1]["eff"])
+            axes = np.array([f for f, _, _ in group])[:, None] + \
+                np.arange(dim)
+            param = {key: np.array([m["param"][key] for _, m, _ in group])
+                     for key in group[0][1]["param"]}
+            index = np.array([k for _, _, k in group])
+            self.groups[type] = (axes, param, index)
+
+        # the SM branching ratios and form factors, read when first needed
+        self.func_BR = None
+        self.func_formfactors = None
+
+    def computelikelihood_mu(self, mu):
+        """-2 log L for signal strengths.
+
+        mu has the shape (points, Higgs states, production modes, decay
+        modes) with the modes ordered as PRODUCTIONS and DECAYS, or
+        (points, Higgs states, energies, production modes, decay modes) for
+        signal strengths that depend on the ENERGIES. The signal strengths of
+        all Higgs states are summed. Returns an array of -2 log L of shape
+        (points,).
+        """
+
+        return self.computelikelihood_measurements(mu).sum(axis=1)
+
+    def computelikelihood_measurements(self, mu):
+        """-2 log L of the individual measurements for signal strengths.
+
+        mu as for computelikelihood_mu. Returns an array of shape (points,
+        measurements) with the measurements in the order of
+        self.measurements.
+        """
+
+        mu = np.asarray(mu, dtype=float)
+        if mu.ndim == 4:
+            mu = np.broadcast_to(mu[:, :, None], mu.shape[:2] +
+                                 (len(ENERGIES),) + mu.shape[2:])
+        if mu.ndim != 5 or mu.shape[2:] != (len(ENERGIES), len(PRODUCTIONS),
+                                            len(DECAYS)):
+            raise UserInputError("signal strengths of shape " +
+                                 str(mu.shape) + " instead of (points, " +
+                                 "states, [energies,] productions, decays)")
+        mu_tot = mu.sum(axis=1).reshape(len(mu), N_MU)
+
+        d = mu_tot @ self.eff.T - self.bestfit
+        l = np.zeros((len(mu), len(self.measurements)))
+        with np.errstate(all="ignore"):
+            for type, (axes, param, index) in list(self.groups.items()):
+                l[:, index] = GROUPED_TYPES[type](d[:, axes], param)
+            for axes, m, k in self.singles:
+                l[:, k] = SINGLE_TYPES[m["type"]](d[:, axes], m["param"])
+        return l
+
+    def computelikelihood_couplings(self, couplings, mass,
+                                    BRinvisible=0., BRundetected=0.):
+        """-2 log L for reduced couplings, see computemu."""
+
+        return self.computelikelihood_mu(
+            self.computemu(couplings, mass, BRinvisible, BRundetected))
+
+    def computemu(self, couplings, mass, BRinvisible=0., BRundetected=0.):
+        """Signal strengths from reduced couplings at BEST-QCD precision.
+
+        couplings has the shape (points, Higgs states, n) with the reduced
+        couplings ordered as COUPLINGS, where n >= N_REQUIRED and missing or
+        NaN couplings are computed. mass, BRinvisible and BRundetected are
+        broadcast to (points, Higgs states). Returns the signal strengths of
+        shape (points, Higgs states, energies, production modes, decay modes).
+        The signal strengths of points with a mass outside of MASS_RANGE or a
+        missing required coupling are NaN.
+        """
+
+        couplings = np.asarray(couplings, dtype=float)
+        if (couplings.ndim != 3 or couplings.shape[2] < N_REQUIRED or
+                couplings.shape[2] > len(COUPLINGS)):
+            raise UserInputError("reduced couplings of shape " +
+                                 str(couplings.shape) + " instead of " +
+                                 "(points, states, couplings)")
+        shape = couplings.shape[:2]
+        mass = np.broadcast_to(np.asarray(mass, dtype=float), shape)
+
+        # invalid points are evaluated at a valid mass and with SM couplings
+        # to keep the interpolations in range, and are set to NaN afterwards
+        invalid = np.any((~(mass >= MASS_RANGE[0])) |
+                         (~(mass <= MASS_RANGE[1])) |
+                         np.any(np.isnan(couplings[..., :N_REQUIRED]),
+                                axis=-1), axis=1)
+        if np.any(invalid):
+            mass = np.where(invalid[:, None], MASS_RANGE[0], mass)
+            couplings = couplings.copy()
+            couplings[invalid, :, :N_REQUIRED] = 1.
+
+        BRinv = np.broadcast_to(np.asarray(BRinvisible, dtype=float), shape)
+        BRund = np.broadcast_to(np.asarray(BRundetected, dtype=float), shape)
+        C = self.computecouplings(couplings, mass)
+
+        if self.func_BR is None:
+            self.func_BR = BR_SM.getBRfunctions()
+        BR = np.stack([self.func_BR[decay](mass)
+                       for decay in DECAYS[:-1]], axis=-1)
+        C_decay = np.stack([C[c] for c in DECAY_COUPLINGS], axis=-1)
+        width = BR * C_decay**2
+        reduced_width = width.sum(axis=-1) / BR.sum(axis=-1)
+        redBR = np.concatenate(
+            [((1. - BRinv - BRund) / reduced_width)[..., None] * C_decay**2,
+             BRinv[..., None]], axis=-1)
+        C_prod = np.stack([np.stack([C[c] for c in prod_couplings], axis=-1)
+                           for prod_couplings in PROD_COUPLINGS], axis=-2)
+        mu = C_prod[..., None]**2 * redBR[..., None, None, :]
+        mu[invalid] = np.nan
+        return mu
+
+    def computecouplings(self, couplings, mass):
+        """Complete the reduced couplings.
+
+        The N_REQUIRED couplings must not be NaN. Returns a dictionary of all
+        COUPLINGS as arrays of shape (points, Higgs states)."""
+
+        C = {name: couplings[..., i] for i, name in enumerate(COUPLINGS)
+             if i < couplings.shape[2]}
+
+        def complete(name, default):
+            if name not in C:
+                C[name] = default()
+            elif np.any(np.isnan(C[name])):
+                C[name] = np.where(np.isnan(C[name]), default(), C[name])
+
+        complete("WH", lambda: C["WW"])
+        complete("qqZH", lambda: C["ZZ"])
+        for name in FORMFACTORS:
+            if name == "VBF":
+                complete(name, lambda: np.where(
+                    abs(C["WW"] - C["ZZ"]) < 1e-6, C["WW"],
+                    self.formfactorcoupling("VBF", C, mass)))
+            else:
+                complete(name, lambda: self.formfactorcoupling(name, C, mass))
+        for name, form in list(QUADRATIC_FORMS.items()):
+            complete(name, lambda: np.sqrt(np.maximum(
+                sum(coeff * _product(C, pair) for coeff, pair in form), 0.)))
+        return C
+
+    def formfactorcoupling(self, name, C, mass):
+        """A reduced coupling computed from the interpolated form factors of
+        reducedcouplingsnnlo.py."""
+
+        if self.func_formfactors is None:
+            self.func_formfactors = {}
+        if name not in self.func_formfactors:
+            self.func_formfactors[name] = getattr(RedCoupNNLO,
+                                                  name + "_ff")()
+        prefix, suffix, pairs = FORMFACTORS[name]
+        numerator = 0.
+        denominator = 0.
+        for pair in pairs:
+            ff = self.func_formfactors[name][prefix + pair + suffix](
+                mass.ravel()).reshape(mass.shape)
+            numerator = numerator + ff * _product(C, pair)
+            denominator = denominator + ff
+        return np.sqrt(np.maximum(numerator, 0.) / denominator)
+
+    # entry points of the C API, the arrays are passed as buffers of doubles
+
+    def computelikelihood_mu_buffer(self, mu, npoints, nstates, energies,
+                                    result):
+        mu = np.frombuffer(mu, dtype=np.float64)
+        shape = (npoints, nstates) + ((len(ENERGIES),) if energies else ()) \
+            + (len(PRODUCTIONS), len(DECAYS))
+        np.frombuffer(result, dtype=np.float64)[:] = \
+            self.computelikelihood_mu(mu.reshape(shape))
+
+    def computelikelihood_couplings_buffer(self, couplings, mass,
+                                           BRinvisible, BRundetected,
+                                           npoints, nstates, result):
+        shape = (npoints, nstates)
+        couplings = np.frombuffer(couplings, dtype=np.float64)
+        extra = [np.frombuffer(b, dtype=np.float64).reshape(shape)
+                 if b is not None else 0.
+                 for b in [mass, BRinvisible, BRundetected]]
+        np.frombuffer(result, dtype=np.float64)[:] = \
+            self.computelikelihood_couplings(
+                couplings.reshape(shape + (len(COUPLINGS),)), *extra)
@@ -0,0 +1,244 @@
+##########################################################################
+#
+#  This file is part of Lilith
+#  v1 (2015) by Jeremy Bernon and Beranger Dumont
+#  v2 (2019) by Sabine Kraml, Tran Quang Loc, Dao Thi Nhung, Le Duc Ninh
+#            converted to Python 3 by Marius Bertrand (Jul/Aug 2020)
+#
+#  Web page: http://lpsc.in2p3.fr/projects-th/lilith/
+#
+#  In case of questions email sabine.kraml@lpsc.in2p3.fr
+#
+#
+#    Lilith is free software: you can redistribute it and/or modify
+#    it under the terms of the GNU General Public License as published by
+#    the Free Software Foundation, either version 3 of the License, or
+#    (at your option) any later version.
+#
+#    Lilith is distributed in the hope that it will be useful,
+#    but WITHOUT ANY WARRANTY; without even the implied warranty of
+#    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#    GNU General Public License for more details.
+#
+#    You should have received a copy of the GNU General Public License
+#    along with Lilith.  If not, see <http://www.gnu.org/licenses/>.
+#
+##########################################################################
+
+"""Read precompiled databases of the experimental input.
+
+A database is compiled from a .list file by the CompileLilithData program of
+ScannerS (see ScannerS::Interfaces::Lilith::WriteDatabase for the format). It
+contains the fully processed input: the multi-particle efficiencies are split
+into the individual production modes, the Poisson parameters are solved, the
+covariance matrices inverted and the grids of type "f" are stored as cubic
+spline coefficients. The file is memory mapped and all arrays returned by
+read_database are read-only views into it.
+
+A database compiled from a .list file is used in place of it by the Lilith
+class if it is stored next to it with the extension .ldb (e.g.
+data/latest.ldb for data/latest.list) and is up to date, see
+compiled_database.
+"""
+
+import os.path
+import numpy as np
+from ..errors import ExpInputError, ExpInputIOError
+
+MAGIC = b"LILITHDB"
+VERSION = 1
+BYTE_ORDER_MARK = 0x0102030405060708
+
+# the likelihood types in the order of their type codes
+TYPES = ["n1", "n2", "nN", "vn1", "vn2", "vnN", "p1", "p2", "f1", "f2"]
+# the collider energies: Tevatron, 7 and 8 TeV LHC, and 13 TeV LHC
+ENERGIES = ["run1", "lhc13"]
+PRODUCTIONS = ["ggH", "VBF", "WH", "qqZH", "ggZH", "ttH", "tHq", "tHW", "bbH"]
+DECAYS = ["gammagamma", "ZZ", "WW", "bb", "tautau", "gg", "cc", "mumu",
+          "Zgamma", "invisible"]
+
+
+def mu_index(prod, decay, energy):
+    """Position of a signal strength in the flattened array of shape
+    (len(ENERGIES), len(PRODUCTIONS), len(DECAYS)) used for the efficiency
+    indices."""
+
+    return ((ENERGIES.index(energy) * len(PRODUCTIONS) +
+             PRODUCTIONS.index(prod)) * len(DECAYS) + DECAYS.index(decay))
+
+
+class _Record:
+    """Sequential reader of the words of one measurement."""
+
+    def __init__(self, filepath, words, values, begin, end):
+        self.filepath = filepath
+        self.words = words
+        self.values = values
+        self.pos = begin
+        self.end = end
+
+    def fail(self, error):
+        raise ExpInputError(self.filepath, error)
+
+    def _take(self, n):
+        if n > self.end - self.pos:
+            self.fail("truncated database record")
+        begin = self.pos
+        self.pos += n
+        return begin
+
+    def word(self):
+        return int(self.words[self._take(1)])
+
+    def value(self):
+        return float(self.values[self._take(1)])
+
+    def array(self, n):
+        begin = self._take(n)
+        return self.values[begin:begin + n]
+
+    def matrix(self, n):
+        return self.array(n * n).reshape(n, n)
+
+    def string(self):
+        size = self.word()
+        begin = self._take((size + 7) // 8)
+        return self.words[begin:begin + (size + 7) // 8].tobytes()[:size] \
+            .decode()
+
+
+def _read_param(rec, type, dim):
+    """Read the type dependent parameters."""
+
+    # the multi-dimensional types are only used for three or more axes
+    expected = 3 if type[-1] == "N" else int(type[-1])
+    if dim != expected and not (type[-1] == "N" and dim > expected):
+        rec.fail("likelihood type " + type + " for " + str(dim) + " axes")
+    if type in ["n1", "vn1"]:
+        return {"left": rec.value(), "right": rec.value()}
+    if type == "n2":
+        return {"a": rec.value(), "b": rec.value(), "c": rec.value()}
+    if type == "nN":
+        return {"inv_cov": rec.matrix(dim)}
+    if type == "vn2":
+        return {"left": rec.array(2), "right": rec.array(2),
+                "corr": rec.value()}
+    if type == "vnN":
+        return {"v": rec.array(dim), "v_prime": rec.array(dim),
+                "inv_corr": rec.matrix(dim)}
+    if type == "p1":
+        return {"gamma": rec.value(), "nu": rec.value()}
+    if type == "p2":
+        return {"gamma": rec.array(2), "nu": rec.array(2),
+                "a_corr": rec.value()}
+    if type == "f1":
+        n = rec.word()
+        x = rec.array(n)
+        # (y, c, b, a) for the region below the grid and each grid point
+        return {"x": x, "coefficients": rec.array(4*(n+1)).reshape(n+1, 4)}
+    if type == "f2":
+        nx = rec.word()
+        ny = rec.word()
+        x = rec.array(nx)
+        y = rec.array(ny)
+        # [x location][y location][power of x][power of y]
+        co = rec.array(16*(nx+1)*(ny+1)).reshape(nx+1, ny+1, 4, 4)
+        return {"x": x, "y": y, "coefficients": co}
+
+
+def read_database(filepath):
+    """Memory map a database and return the list of its measurements.
+
+    Each measurement is a dictionary with the keys
+      - "source": the XML file it was compiled from
+      - "type": one of TYPES, the number is the dimension (N for >= 3)
+      - "energy": one of ENERGIES
+      - "mass": the Higgs mass of the measurement
+      - "bestfit": the best fit values of all axes (zero for type "f")
+      - "eff": for each axis a pair of arrays of the indices of the signal
+        strengths (see mu_index) and the efficiencies
+      - "param": the type dependent parameters
+    """
+
+    try:
+        words = np.memmap(filepath, dtype="<u8", mode="r")
+    except (IOError, ValueError) as e:
+        raise ExpInputIOError("cannot open the database \"" + filepath +
+                              "\": " + str(e))
+    values = words.view("<f8")
+
+    header = _Record(filepath, words, values, 0, len(words))
+    if words[:1].tobytes() != MAGIC:
+        header.fail("not a Lilith database")
+    header.word() # the magic characters
+    version = header.word()
+    if version != VERSION:
+        header.fail("database version " + str(version) + " instead of " +
+                    str(VERSION))
+    if header.word() != BYTE_ORDER_MARK:
+        header.fail("wrong byte order of the database")
+    n = header.word()
+    offsets = [header.word() for _ in range(n+1)]
+    if offsets[-1] != len(words):
+        header.fail("wrong size of the database")
+
+    measurements = []
+    for begin, end in zip(offsets[:-1], offsets[1:]):
+        if begin < header.pos or begin > end:
+            header.fail("invalid record offsets in the database")
+        rec = _Record(filepath, words, values, begin, end)
+        type_code = rec.word()
+        if type_code >= len(TYPES):
+            rec.fail("unknown likelihood type " + str(type_code))
+        type = TYPES[type_code]
+        energy = rec.word()
+        if energy >= len(ENERGIES):
+            rec.fail("unknown energy " + str(energy))
+        mass = rec.value()
+        dim = rec.word()
+        source = rec.string()
+        bestfit = np.empty(dim)
+        eff = []
+        for i in range(dim):
+            bestfit[i] = rec.value()
+            n_eff = rec.word()
+            pairs = rec.array(2*n_eff)
+            eff.append((pairs.view("<u8")[0::2].astype(np.intp),
+                        np.array(pairs[1::2])))
+        param = _read_param(rec, type, dim)
+        if rec.pos != end:
+            rec.fail("unexpected data after " + source)
+        measurements.append({"source": source, "type": type,
+                             "energy": ENERGIES[energy], "mass": mass,
+                             "bestfit": bestfit, "eff": eff,
+                             "param": param})
+    return measurements
+
+
+def is_database(filepath):
+    """Whether the file starts like a database."""
+
+    try:
+        with open(filepath, "rb") as f:
+            return f.read(len(MAGIC)) == MAGIC
+    except IOError:
+        return False
+
+
+def compiled_database(list_filepath, xml_filepaths):
+    """The up to date database compiled from a .list file, if there is one.
+
+    The database has to be stored next to the .list file with the extension
+    .ldb and be newer than the .list file and all XML files xml_filepaths
+    listed in it. Returns the path of the database or None.
+    """
+
+    db_filepath = os.path.splitext(list_filepath)[0] + ".ldb"
+    try:
+        db_time = os.path.getmtime(db_filepath)
+        if any(os.path.getmtime(f) > db_time
+               for f in [list_filepath] + list(xml_filepaths)):
+            return None
+    except OSError:
+        return None
+    return db_filepath if is_database(db_filepath) else None
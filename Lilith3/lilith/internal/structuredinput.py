@@ -0,0 +1,133 @@
+##########################################################################
+#
+#  This file is part of Lilith
+#  v1 (2015) by Jeremy Bernon and Beranger Dumont
+#  v2 (2019) by Sabine Kraml, Tran Quang Loc, Dao Thi Nhung, Le Duc Ninh
+#            converted to Python 3 by Marius Bertrand (Jul/Aug 2020)
+#
+#  Web page: http://lpsc.in2p3.fr/projects-th/lilith/
+#
+#  In case of questions email sabine.kraml@lpsc.in2p3.fr
+#
+#
+#    Lilith is free software: you can redistribute it and/or modify
+#    it under the terms of the GNU General Public License as published by
+#    the Free Software Foundation, either version 3 of the License, or
+#    (at your option) any later version.
+#
+#    Lilith is distributed in the hope that it will be useful,
+#    but WITHOUT ANY WARRANTY; without even the implied warranty of
+#    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#    GNU General Public License for more details.
+#
+#    You should have received a copy of the GNU General Public License
+#    along with Lilith.  If not, see <http://www.gnu.org/licenses/>.
+#
+##########################################################################
+
+"""User input from arrays instead of XML.
+
+The functions return the same lists of dictionaries as the attributes redC
+and mu of ReadUserInput, with the same default values, without writing and
+parsing an XML document.
+"""
+
+from math import isnan
+import numpy as np
+from ..errors import UserInputError, HiggsMassError
+from .batch import COUPLINGS, N_REQUIRED, MASS_RANGE
+from .database import PRODUCTIONS, DECAYS
+
+accepted_precision = ["LO", "BEST-QCD"]
+
+
+def _per_state(value, n_higgses):
+    if value is None:
+        value = 0.
+    return np.broadcast_to(np.asarray(value, dtype=float), (n_higgses,))
+
+
+def _masses(mass, n_higgses):
+    masses = _per_state(mass, n_higgses)
+    for m in masses:
+        if not MASS_RANGE[0] <= m <= MASS_RANGE[1]:
+            raise HiggsMassError('mass ' + str(m) + ' is not between ' +
+                                 str(MASS_RANGE[0]) + ' and ' +
+                                 str(MASS_RANGE[1]) + ' GeV.')
+    return masses
+
+
+def reducedcouplings(couplings, mass, BRinvisible=0., BRundetected=0.,
+                     precision="BEST-QCD"):
+    """Reduced couplings of shape (Higgs states, n), ordered as COUPLINGS.
+
+    The first N_REQUIRED couplings are mandatory, the others can be NaN or
+    omitted (n < len(COUPLINGS)) to be computed. A one dimensional array is a
+    single Higgs state. mass, BRinvisible and BRundetected are numbers or
+    arrays of one value per Higgs state, None for the BRs is zero.
+    """
+
+    couplings = np.asarray(couplings, dtype=float)
+    if couplings.ndim == 1:
+        couplings = couplings[None]
+    if (couplings.ndim != 2 or couplings.shape[1] < N_REQUIRED or
+            couplings.shape[1] > len(COUPLINGS)):
+        raise UserInputError('reduced couplings of shape ' +
+                             str(couplings.shape) + ' instead of (Higgs ' +
+                             'states, couplings)')
+    if precision not in accepted_precision:
+        raise UserInputError('"' + str(precision) + '" precision is not ' +
+                             'allowed')
+    n_higgses = len(couplings)
+    masses = _masses(mass, n_higgses)
+    BRinv = _per_state(BRinvisible, n_higgses)
+    BRund = _per_state(BRundetected, n_higgses)
+
+    redC = []
+    for i in range(n_higgses):
+        redCp = {name: val for name, val in zip(COUPLINGS,
+                                                 couplings[i].tolist())
+                 if not isnan(val)}
+        for name in COUPLINGS[:N_REQUIRED]:
+            if name not in redCp:
+                raise UserInputError('reduced coupling to "' + name +
+                                     '" is missing')
+        # the same defaults as for the XML input
+        if "WH" not in redCp:
+            redCp["WH"] = redCp["WW"]
+        if "qqZH" not in redCp:
+            redCp["qqZH"] = redCp["ZZ"]
+        if "VBF" not in redCp and abs(redCp["WW"] - redCp["ZZ"]) < 1e-6:
+            redCp["VBF"] = redCp["WW"]
+        redCp["extra"] = {"mass": float(masses[i]), "precision": precision,
+                          "BRinvisible": float(BRinv[i]),
+                          "BRundetected": float(BRund[i])}
+        redC.append(redCp)
+    return redC
+
+
+def signalstrengths(mu, mass):
+    """Signal strengths of shape (Higgs states, production modes, decay
+    modes), ordered as PRODUCTIONS and DECAYS.
+
+    A two dimensional array is a single Higgs state, mass is a number or an
+    array of one value per Higgs state.
+    """
+
+    mu = np.asarray(mu, dtype=float)
+    if mu.ndim == 2:
+        mu = mu[None]
+    if mu.ndim != 3 or mu.shape[1:] != (len(PRODUCTIONS), len(DECAYS)):
+        raise UserInputError('signal strengths of shape ' + str(mu.shape) +
+                             ' instead of (Higgs states, productions, decays)')
+    masses = _masses(mass, len(mu))
+
+    user_mu = []
+    for i in range(len(mu)):
+        values = mu[i].tolist()
+        mup = {(prod, decay): values[p][d]
+               for p, prod in enumerate(PRODUCTIONS)
+               for d, decay in enumerate(DECAYS)}
+        mup["extra"] = {"mass": float(masses[i])}
+        user_mu.append(mup)
+    return user_mu
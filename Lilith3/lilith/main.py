@@ -31,15 +31,20 @@
 import os.path, time, sys
 import importlib
 from warnings import warn
+import numpy as np
 # Lilith library
 from .errors import ExpNdfComputationError, UserMuTotComputationError, \
                    UserInputIOError
 from .internal.readexpinput import ReadExpInput
 from .internal.readuserinput import ReadUserInput
+import lilith.internal.structuredinput as structuredinput
 from .internal.computereducedcouplings import ComputeReducedCouplings
 from .internal.computemufromreducedcouplings import \
     ComputeMuFromReducedCouplings
 from .internal.computelikelihood import compute_likelihood
+from .internal.database import is_database, compiled_database, ENERGIES, \
+    PRODUCTIONS, DECAYS
+from .internal.batch import BatchLikelihood
 import lilith.internal.writeoutput as writeoutput
 import lilith.version as version
 
@@ -69,6 +74,9 @@ class Lilith:
         self.exp_mu = []
         self.exp_ndf = 0
         self.dbversion = "??.??"
+        # the experimental results read from a compiled database instead of
+        # the XML files, see readexpinput
+        self.exp_database = None
 
         # information read from the user input
         # - in signal strengths mode, self.couplings remains empty
@@ -128,6 +136,30 @@ class Lilith:
                 'I/O error({0}): {1}'.format(e.errno, e.strerror) + '; cannot' +
                 ' open the user input file "' + filepath + '".')
 
+    def readuserinput_couplings(self, couplings, mass=125.09, BRinvisible=0.,
+                                BRundetected=0., precision="BEST-QCD"):
+        """Read reduced couplings given as an array instead of XML, see
+        internal/structuredinput.py for the format."""
+
+        t0 = time.time()
+        self.mode = "reducedcouplings"
+        self.user_mu = []
+        self.user_mu_tot = {}
+        self.couplings = structuredinput.reducedcouplings(
+            couplings, mass, BRinvisible, BRundetected, precision)
+        self.tinfo("reading of the user input", time.time() - t0)
+
+    def readuserinput_mu(self, mu, mass=125.09):
+        """Read signal strengths given as an array instead of XML, see
+        internal/structuredinput.py for the format."""
+
+        t0 = time.time()
+        self.mode = "signalstrengths"
+        self.couplings = []
+        self.user_mu = structuredinput.signalstrengths(mu, mass)
+        self.compute_user_mu_tot()
+        self.tinfo("reading of the user input", time.time() - t0)
+
     def computecouplings(self):
         """Computes missing reduced couplings."""
 
@@ -199,14 +231,31 @@ class Lilith:
                     self.user_mu_tot[key] = mup[key]
 
     def readexpinput(self, filepath=default_exp_list):
-        """Read the experimental input specified in a list file."""
+        """Read the experimental input specified in a list file.
+
+        A database compiled from the list file is read instead if it is up to
+        date (see internal/database.py), as is a database given as filepath.
+        The likelihood then agrees with the one from the XML files up to
+        round-off (see internal/batch.py).
+        """
     
         self.info("Processing the experimental input...")
         self.readdbversion()
-        # initialize the reading of the experimental input
-        exp_input = ReadExpInput()
-        # read the list of XML files
-        filelist = exp_input.get_filelist(filepath)
+        self.exp_database = None
+        if is_database(filepath):
+            database = filepath
+        else:
+            # initialize the reading of the experimental input
+            exp_input = ReadExpInput()
+            # read the list of XML files
+            filelist = exp_input.get_filelist(filepath)
+            database = compiled_database(filepath, filelist)
+        if database is not None:
+            self.info("Reading the compiled database " + database + "...")
+            self.exp_database = BatchLikelihood(database)
+            self.exp_mu = []
+            self.exp_ndf = self.exp_database.exp_ndf
+            return
         # read and check each individual XML file
         for expfile in filelist:
             exp_input.read_file(expfile)
@@ -253,12 +302,11 @@ class Lilith:
         if exp_filepath is not None:
             # read the experimental input and get exp_mu
             self.readexpinput(exp_filepath)
-        elif not self.exp_mu:
+        elif not self.exp_mu and self.exp_database is None:
             self.readexpinput()
 
         t0 = time.time()
-        self.results, self.l = compute_likelihood(self.exp_mu,
-                                                  self.user_mu_tot,self.mode)
+        self.results, self.l = self.likelihood(self.user_mu_tot, self.mode)
         self.tinfo("computing the likelihood", time.time() - t0)
         
     def computeSMlikelihood(self, userinput=None, exp_filepath=None,
@@ -270,7 +318,48 @@ class Lilith:
         decay_modes = ["gammagamma", "ZZ", "WW", "bb", "cc", "tautau", "Zgamma", "mumu", "gg","invisible"]
         prod_modes = ["ggH", "VBF", "WH", "qqZH", "ggZH", "ttH", "tHq", "tHW", "bbH"]
         SM_mu = dict(((l1,l2), float(l2!="invisible")) for l1 in prod_modes for l2 in decay_modes)
-        self.results, self.l_SM = compute_likelihood(self.exp_mu, SM_mu, "signalstrengths")
+        self.results, self.l_SM = self.likelihood(SM_mu, "signalstrengths")
+
+    def likelihood(self, user_mu, mode):
+        """Detailed results and -2 log L for the signal strengths user_mu
+        from the experimental input, see compute_likelihood."""
+
+        if self.exp_database is None:
+            return compute_likelihood(self.exp_mu, user_mu, mode)
+
+        # as in compute_likelihood, reduced couplings give separate 13 TeV
+        # signal strengths of some production modes
+        mu = np.zeros((1, 1, len(ENERGIES), len(PRODUCTIONS), len(DECAYS)))
+        for e, energy in enumerate(ENERGIES):
+            for p, prod in enumerate(PRODUCTIONS):
+                key = prod
+                if (mode == "reducedcouplings" and energy == "lhc13" and
+                        prod in ["ggH", "VBF", "tHq", "tHW", "ggZH"]):
+                    key = prod + "13"
+                for d, decay in enumerate(DECAYS):
+                    mu[0, 0, e, p, d] = user_mu.get((key, decay), 0.)
+        l = self.exp_database.computelikelihood_measurements(mu)[0]
+
+        # the database does not contain the experiment names and the exact
+        # energies, they are replaced by the XML file and the energy range
+        results = []
+        for m, cur_l in zip(self.exp_database.measurements, l):
+            dim = len(m["eff"])
+            if dim <= 2:
+                axes = ["x", "y"][:dim]
+            else:
+                axes = ["d" + str(i) for i in range(1, dim + 1)]
+            eff = {}
+            for axis, (indices, effs) in zip(axes, m["eff"]):
+                _, prod, decay = np.unravel_index(
+                    indices, (len(ENERGIES), len(PRODUCTIONS), len(DECAYS)))
+                eff[axis] = {(PRODUCTIONS[p], DECAYS[d]): float(val)
+                             for p, d, val in zip(prod, decay, effs)}
+            results.append(
+                {"experiment": m["source"], "source": m["source"],
+                 "sqrts": m["energy"], "dim": dim, "type": m["type"][:-1],
+                 "eff": eff, "l": float(cur_l)})
+        return results, float(l.sum())
 
 
     def writecouplings(self, filepath):
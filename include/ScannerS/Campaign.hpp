@@ -0,0 +1,85 @@
+#pragma once
+
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace ScannerS {
+
+//! signature of a single ScannerS run, called like `main(argc, argv)`
+using RunFunction = std::function<int(int, char *[])>;
+
+/**
+ * @brief Request to end a run with the given exit code.
+ *
+ * Thrown by ScannerSCMD::Parse() after invalid command line arguments or
+ * `--help` have been handled, instead of exiting the process. RunCampaign()
+ * turns it into the return value of the run.
+ */
+class RunExit : public std::runtime_error {
+public:
+  //! construct from the exit code
+  explicit RunExit(int code)
+      : std::runtime_error{"run ended with exit code " + std::to_string(code)},
+        code_{code} {}
+
+  //! the exit code of the run
+  int Code() const noexcept { return code_; }
+
+private:
+  int code_;
+};
+
+/**
+ * @brief Splits a line of a campaign file into command line arguments.
+ *
+ * Arguments are separated by whitespace, double quotes group arguments that
+ * contain whitespace. Anything after an unquoted `#` or `;` is a comment.
+ *
+ * @param line the line to split
+ * @return std::vector<std::string> the arguments
+ */
+std::vector<std::string> SplitArguments(const std::string &line);
+
+/**
+ * @brief Reads a campaign file.
+ *
+ * Every non-empty line of the file (see SplitArguments()) holds the command
+ * line arguments of one run, without the executable name, eg
+ * ```
+ * R2HDM_T1.tsv --config example_input/R2HDM_T1.ini scan -n 10
+ * R2HDM_T2.tsv --config example_input/R2HDM_T2.ini scan -n 10 --seed 42
+ * ```
+ *
+ * @param filename path to the campaign file
+ * @return std::vector<std::vector<std::string>> the arguments of all runs
+ */
+std::vector<std::vector<std::string>>
+ReadCampaign(const std::string &filename);
+
+/**
+ * @brief Runs a ScannerS main function either once or for a whole campaign.
+ *
+ * If the executable is called as `executable campaign campaignfile`, `run` is
+ * called for every entry of the campaign file (see ReadCampaign()) with the
+ * executable name prepended to the arguments. Otherwise `run` is called once
+ * with the unchanged arguments.
+ *
+ * The runs of a campaign are executed sequentially within the same process.
+ * Expensive one-time initializations, like loading the HiggsBounds and
+ * HiggsSignals data or selecting the MicrOMEGAs model, are thus only performed
+ * once. The runs cannot be executed concurrently, since the Fortran codes
+ * behind these interfaces keep global state. A run that throws is reported and
+ * the campaign continues with the next entry. Invalid command line arguments
+ * (see RunExit) only end the affected run, which counts as failed unless its
+ * exit code is zero (eg for `--help`).
+ *
+ * @param argc number of command line arguments
+ * @param argv command line arguments
+ * @param run the function that performs a single run
+ * @return int 0 if all runs succeeded, 1 otherwise
+ */
+int RunCampaign(int argc, char *argv[], const RunFunction &run);
+
+} // namespace ScannerS
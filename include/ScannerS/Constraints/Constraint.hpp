@@ -1,5 +1,6 @@
 #pragma once
 
+#include "ScannerS/DataMap.hpp"
 #include <iosfwd>
 #include <stdexcept>
 #include <string>
@@ -76,15 +77,44 @@ public:
    * @return constraint passed, taking severity into account
    */
   bool operator()(typename Model::ParameterPoint &point) {
+    if (severity_ == Severity::skip)
+      return ResultWithSeverity(point, true);
+    return ResultWithSeverity(
+        point, static_cast<Derived<Model> *>(this)->Apply(point));
+  }
+
+  //! the severity of the constraint
+  Severity GetSeverity() const noexcept { return severity_; }
+
+  //! whether the last point passed to operator()() passed the constraint,
+  //! without taking the severity into account (true if skipped)
+  bool LastResult() const noexcept { return lastResult_; }
+
+protected:
+  //! Constructor that sets the severity
+  explicit Constraint(Severity severity) : severity_{severity} {}
+
+  /**
+   * @brief Handles the #Severity for an already calculated result.
+   *
+   * Used by operator()() and by constraints that calculate results for many
+   * points at once.
+   *
+   * @param point the parameter point
+   * @param passed whether the point passed the constraint
+   * @return constraint passed, taking severity into account
+   */
+  bool ResultWithSeverity(typename Model::ParameterPoint &point, bool passed) {
+    lastResult_ = passed;
     switch (severity_) {
     case Severity::apply:
-      return static_cast<Derived<Model> *>(this)->Apply(point);
-    case Severity::ignore:
-      if (static_cast<Derived<Model> *>(this)->Apply(point))
-        point.data.Store("valid_"s + Derived<Model>::constraintId, 1);
-      else
-        point.data.Store("valid_"s + Derived<Model>::constraintId, 0);
+      return passed;
+    case Severity::ignore: {
+      static const auto validKey =
+          DataMap::Key{"valid_"s + Derived<Model>::constraintId};
+      point.data.Store(validKey, passed ? 1 : 0);
       return true;
+    }
     case Severity::skip:
       return true;
     default:
@@ -92,12 +122,9 @@ public:
     }
   }
 
-protected:
-  //! Constructor that sets the severity
-  explicit Constraint(Severity severity) : severity_{severity} {}
-
 private:
   Severity severity_;
+  bool lastResult_ = true;
 };
 
 } // namespace ScannerS::Constraints
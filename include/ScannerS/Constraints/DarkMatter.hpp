@@ -64,8 +64,9 @@ public:
   /**
    * @brief Constructor that initializes MicrOMEGAs to the correct model
    *
-   * **NEVER** create more than one of these objects, MicrOMEGAs can't handle
-   * that.
+   * The model is only selected once per process, such that a new object can
+   * be created for every run of a campaign. However, **NEVER** use more than
+   * one of these objects at a time, MicrOMEGAs can't handle that.
    *
    * @param severity the constraint severity
    * @param relativeDDMassRes approximate relative mass resolution of the direct
@@ -75,7 +76,8 @@ public:
   explicit DarkMatter(Severity severity, double relativeDDMassRes = 0.2)
       : Constraint<DarkMatter, Model>{severity}, relativeDDMassRes_{
                                                      relativeDDMassRes} {
-    Interfaces::MicrOMEGAs::SelectModel(Model::micromegasModelName);
+    [[maybe_unused]] static const bool selected =
+        (Interfaces::MicrOMEGAs::SelectModel(Model::micromegasModelName), true);
   }
 
   /**
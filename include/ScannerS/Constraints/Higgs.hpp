@@ -2,9 +2,14 @@
 
 #include "ScannerS/Constants.hpp"
 #include "ScannerS/Constraints/Constraint.hpp"
+#include "ScannerS/DataMap.hpp"
 #include "ScannerS/Interfaces/HiggsBoundsSignals.hpp" // IWYU pramga: export
+#include <array>
+#include <chrono>
 #include <cstddef>
+#include <ostream>
 #include <string>
+#include <vector>
 
 using namespace std::string_literals;
 
@@ -25,6 +30,19 @@ namespace ScannerS::Constraints {
  * specifying the number of neutral and charged Higgs bosons, as well as
  * `Model::namesHzero` and `Model::namesHplus` arrays of strings containing
  * corresponding names.
+ *
+ * HiggsBounds and HiggsSignals are run as two separate stages with their own
+ * #Severity (see SetStageSeverity(), set as `--HiggsBounds` and
+ * `--HiggsSignals` on the command line). HiggsSignals is not run for points
+ * that are already excluded by HiggsBounds unless the results are kept
+ * anyway, ie if the severity of the constraint is Severity::ignore.
+ *
+ * The HiggsBounds analyses can be restricted to the LEP (`onlyL`) or hadron
+ * collider (`onlyH`) searches, set as `--hb-experiments` on the command line.
+ * HiggsSignals is only initialized if its stage is not skipped on
+ * construction. The loaded analyses are stored as `hb_experiments` (see
+ * Interfaces::HiggsBoundsSignals::HBExperiments) and `hs_loaded` with every
+ * point, such that the output records them as columns of its header.
  */
 template <class Model> class Higgs : public Constraint<Higgs, Model> {
 public:
@@ -37,10 +55,110 @@ public:
   //! reference SM \f$\chi^2\f$ from mass measurements
   static constexpr double chisqMassSM = 0.;
 
-  //! Constructor that sets the severity and \f$ \chi^2_\mathrm{crit} \f$. The
-  //! chisqCut argument can be set directly in the main function.
-  Higgs<Model>(Severity severity, double chisqCut)
-      : Constraint<Higgs, Model>{severity}, _chisqCut{chisqCut} {}
+  //! the stages of this constraint
+  enum class Stage { HiggsBounds = 0, HiggsSignals = 1 };
+  //! IDs of the stages, used to set their severities
+  static constexpr std::array stageIds{"HiggsBounds", "HiggsSignals"};
+  //! the severities of the stages in the order of #stageIds
+  using StageSeverities = std::array<Severity, stageIds.size()>;
+
+  /**
+   * @brief Constructor that sets the severity and \f$ \chi^2_\mathrm{crit} \f$.
+   *
+   * The chisqCut argument can be set directly in the main function.
+   *
+   * @param severity the severity of the constraint
+   * @param chisqCut the maximal \f$ \chi^2 - \chi^2_\mathrm{SM} \f$
+   * @param cacheSize maximal number of HiggsBounds/HiggsSignals results that
+   * are cached, see Interfaces::HiggsBoundsSignals::CacheSettings
+   * @param cacheQuantization relative quantization of the cache key
+   * @param hbExperiments the HiggsBounds analyses, one of `LandH`, `onlyL`
+   * or `onlyH`, see Interfaces::HiggsBoundsSignals::HBExperiments
+   */
+  Higgs<Model>(Severity severity, double chisqCut, std::size_t cacheSize = 0,
+               double cacheQuantization = 0.,
+               const std::string &hbExperiments = "LandH")
+      : Higgs<Model>{severity, {Severity::apply, Severity::apply}, chisqCut,
+                     cacheSize, cacheQuantization, hbExperiments} {}
+
+  /**
+   * @brief Constructor that also sets the severities of the stages.
+   *
+   * HiggsBounds and HiggsSignals are initialized once with the analyses
+   * required by the stage severities, see SetStageSeverity().
+   *
+   * @param severity the severity of the constraint
+   * @param stageSeverities the severities of the stages
+   * @param chisqCut the maximal \f$ \chi^2 - \chi^2_\mathrm{SM} \f$
+   * @param cacheSize see above
+   * @param cacheQuantization see above
+   * @param hbExperiments see above
+   */
+  Higgs<Model>(Severity severity, const StageSeverities &stageSeverities,
+               double chisqCut, std::size_t cacheSize = 0,
+               double cacheQuantization = 0.,
+               const std::string &hbExperiments = "LandH")
+      : Constraint<Higgs, Model>{severity}, _chisqCut{chisqCut},
+        hbhs_{SharedHBHS(
+            {Interfaces::HiggsBoundsSignals::HBExperimentsFromString(
+                 hbExperiments),
+             stageSeverities[static_cast<std::size_t>(Stage::HiggsSignals)] !=
+                 Severity::skip})} {
+    for (std::size_t i = 0; i != stageSeverities.size(); ++i)
+      stages_[i].severity = stageSeverities[i];
+    hbhs_.SetResultCache({cacheSize, cacheQuantization});
+  }
+
+  /**
+   * @brief Set the severity of a single stage.
+   *
+   * Severity::ignore stores the result of the stage as `valid_HiggsBounds`
+   * or `valid_HiggsSignals` without rejecting the point, Severity::skip does
+   * not run the stage at all. Both stages are applied by default.
+   *
+   * This never reinitializes HiggsBounds or HiggsSignals. Skipping the
+   * HiggsSignals stage on construction avoids its initialization, enabling
+   * it later throws a `std::runtime_error` in that case.
+   */
+  void SetStageSeverity(Stage stage, Severity severity) {
+    if (stage == Stage::HiggsSignals && severity != Severity::skip &&
+        !hbhs_.Analyses().hs)
+      throw(std::runtime_error(
+          "HiggsSignals was not initialized since its stage was skipped"));
+    stages_[static_cast<std::size_t>(stage)].severity = severity;
+  }
+
+  //! number of runs and accumulated run time of a stage
+  struct StageStatistics {
+    std::size_t runs = 0; //!< number of runs
+    double seconds = 0.;  //!< total run time in seconds
+  };
+
+  //! statistics of the given stage
+  const StageStatistics &Statistics(Stage stage) const noexcept {
+    return stages_[static_cast<std::size_t>(stage)].stats;
+  }
+
+  //! number of points for which HiggsSignals was not run since they were
+  //! excluded by HiggsBounds
+  std::size_t SkippedHS() const noexcept { return skippedHS_; }
+
+  //! print the number of runs and timings of the stages
+  void PrintStatistics(std::ostream &out) const {
+    out << "Higgs constraint statistics:";
+    for (std::size_t i = 0; i != stageIds.size(); ++i) {
+      const auto &stats = stages_[i].stats;
+      out << " " << stageIds[i] << " ran " << stats.runs << " times ("
+          << stats.seconds << "s),";
+    }
+    out << " " << skippedHS_
+        << " HiggsSignals runs skipped for excluded points";
+    const auto &cache = hbhs_.ResultCacheStatistics();
+    if (cache.hits + cache.misses > 0)
+      out << ", " << cache.hits << " of " << cache.hits + cache.misses
+          << " results taken from the cache";
+    out << std::endl;
+  }
 
   /**
    * @brief Obtains the constraints from Higgs searches and Higgs measurements.
@@ -69,50 +187,145 @@ public:
    */
   bool Apply(typename Model::ParameterPoint &p) {
     auto hbin = Model::HiggsBoundsInput(p, hbhs_);
-    auto res = hbhs_.RunHBHS(hbin);
-
-    p.data.Store("hb_result", res.result[0]);
-    p.data.Store("hb_channel", res.chan[0]);
-    for (size_t i = 0; i != HiggsBS::nHzero; ++i) {
-      p.data.Store("hb_"s + Model::namesHzero[i] + "_result",
-                   res.result[i + 1]);
-      p.data.Store("hb_"s + Model::namesHzero[i] + "_channel", res.chan[i + 1]);
-      p.data.Store("hb_"s + Model::namesHzero[i] + "_obsratio",
-                   res.obsratio[i + 1]);
-      p.data.Store("hb_"s + Model::namesHzero[i] + "_ncombined",
-                   res.ncombined[i + 1]);
+    hbhs_.SetInput(hbin);
+    const auto &keys = Keys();
+    const auto &analyses = hbhs_.Analyses();
+    p.data.Store(keys.hbExperiments, static_cast<int>(analyses.hbExperiments));
+    p.data.Store(keys.hsLoaded, analyses.hs ? 1 : 0);
+
+    bool passedHB = true;
+    auto &hb = stages_[static_cast<std::size_t>(Stage::HiggsBounds)];
+    if (hb.severity != Severity::skip) {
+      const auto start = Clock::now();
+      const auto res = hbhs_.RunHB();
+      hb.Record(start);
+      for (size_t i = 0; i != keys.hbResult.size(); ++i) {
+        p.data.Store(keys.hbResult[i], res.result[i]);
+        p.data.Store(keys.hbChannel[i], res.chan[i]);
+        if (i != 0) {
+          p.data.Store(keys.hbObsratio[i - 1], res.obsratio[i]);
+          p.data.Store(keys.hbNcombined[i - 1], res.ncombined[i]);
+        }
+      }
+      passedHB = StageResult(p, hb.severity, keys.validHB, res.result[0] == 1);
     }
-    for (size_t i = 0; i != HiggsBS::nHplus; ++i) {
-      p.data.Store("hb_"s + Model::namesHplus[i] + "_result",
-                   res.result[i + HiggsBS::nHzero + 1]);
-      p.data.Store("hb_"s + Model::namesHplus[i] + "_channel",
-                   res.chan[i + HiggsBS::nHzero + 1]);
-      p.data.Store("hb_"s + Model::namesHplus[i] + "_obsratio",
-                   res.obsratio[i + HiggsBS::nHzero + 1]);
-      p.data.Store("hb_"s + Model::namesHplus[i] + "_ncombined",
-                   res.ncombined[i + HiggsBS::nHzero + 1]);
+    if (!passedHB && this->GetSeverity() == Severity::apply) {
+      ++skippedHS_; // the point is rejected anyway
+      return false;
     }
-    p.data.Store("hs_chisqMu", res.chisqMu);
-    p.data.Store("hs_chisqMass", res.chisqMass);
-    double deltaChisq = res.chisq - chisqMuSM - chisqMassSM;
-    p.data.Store("hs_deltaChisq", deltaChisq);
-    for (size_t i = 0; i != HiggsBS::nHzero; ++i) {
-      p.data.Store("mu_"s + Model::namesHzero[i] + "_WW", res.mu_WW[i]);
-      p.data.Store("mu_"s + Model::namesHzero[i] + "_ZZ", res.mu_ZZ[i]);
-      p.data.Store("mu_"s + Model::namesHzero[i] + "_gamgam", res.mu_gaga[i]);
-      p.data.Store("mu_"s + Model::namesHzero[i] + "_tautau", res.mu_tautau[i]);
-      p.data.Store("mu_"s + Model::namesHzero[i] + "_bb", res.mu_bb[i]);
-      p.data.Store("mu_"s + Model::namesHzero[i] + "_bb_VH", res.mu_bb_VH[i]);
+
+    bool passedHS = true;
+    auto &hs = stages_[static_cast<std::size_t>(Stage::HiggsSignals)];
+    if (hs.severity != Severity::skip) {
+      const auto start = Clock::now();
+      const auto res = hbhs_.RunHS();
+      hs.Record(start);
+      p.data.Store(keys.hsChisqMu, res.chisqMu);
+      p.data.Store(keys.hsChisqMass, res.chisqMass);
+      double deltaChisq = res.chisq - chisqMuSM - chisqMassSM;
+      p.data.Store(keys.hsDeltaChisq, deltaChisq);
+      for (size_t i = 0; i != HiggsBS::nHzero; ++i) {
+        p.data.Store(keys.muWW[i], res.mu_WW[i]);
+        p.data.Store(keys.muZZ[i], res.mu_ZZ[i]);
+        p.data.Store(keys.muGamgam[i], res.mu_gaga[i]);
+        p.data.Store(keys.muTautau[i], res.mu_tautau[i]);
+        p.data.Store(keys.muBB[i], res.mu_bb[i]);
+        p.data.Store(keys.muBBVH[i], res.mu_bb_VH[i]);
+      }
+      passedHS = StageResult(p, hs.severity, keys.validHS,
+                             deltaChisq < _chisqCut);
     }
-    return (res.result[0] == 1) && (deltaChisq < _chisqCut);
+    return passedHB && passedHS;
   }
 
 private:
   using HiggsBS =
       Interfaces::HiggsBoundsSignals::HiggsBoundsSignals<Model::nHzero,
                                                          Model::nHplus>;
-  HiggsBS hbhs_{};
+  //! HiggsBounds and HiggsSignals keep global state, all Higgs constraints
+  //! (eg from different runs of a campaign) share a single initialization,
+  //! which is only reinitialized if the requested analyses change
+  static HiggsBS &
+  SharedHBHS(const Interfaces::HiggsBoundsSignals::AnalysisSettings &analyses) {
+    static HiggsBS hbhs{analyses};
+    hbhs.Initialize(analyses);
+    return hbhs;
+  }
+
+  using Clock = std::chrono::steady_clock;
+  struct StageState {
+    Severity severity = Severity::apply;
+    StageStatistics stats;
+
+    void Record(Clock::time_point start) {
+      ++stats.runs;
+      stats.seconds +=
+          std::chrono::duration<double>(Clock::now() - start).count();
+    }
+  };
+  std::array<StageState, stageIds.size()> stages_;
+  std::size_t skippedHS_ = 0;
+
+  //! handles the severity of a stage
+  static bool StageResult(typename Model::ParameterPoint &p, Severity severity,
+                          const DataMap::Key &validKey, bool passed) {
+    if (severity == Severity::ignore) {
+      p.data.Store(validKey, passed ? 1 : 0);
+      return true;
+    }
+    return passed;
+  }
+
+  //! precompiled keys of the stored data
+  struct DataKeys {
+    std::vector<DataMap::Key> hbResult;
+    std::vector<DataMap::Key> hbChannel;
+    std::vector<DataMap::Key> hbObsratio;
+    std::vector<DataMap::Key> hbNcombined;
+    DataMap::Key hsChisqMu{"hs_chisqMu"};
+    DataMap::Key hsChisqMass{"hs_chisqMass"};
+    DataMap::Key hsDeltaChisq{"hs_deltaChisq"};
+    DataMap::Key validHB{"valid_"s + stageIds[0]};
+    DataMap::Key validHS{"valid_"s + stageIds[1]};
+    DataMap::Key hbExperiments{"hb_experiments"};
+    DataMap::Key hsLoaded{"hs_loaded"};
+    std::vector<DataMap::Key> muWW;
+    std::vector<DataMap::Key> muZZ;
+    std::vector<DataMap::Key> muGamgam;
+    std::vector<DataMap::Key> muTautau;
+    std::vector<DataMap::Key> muBB;
+    std::vector<DataMap::Key> muBBVH;
+
+    DataKeys() {
+      hbResult.emplace_back("hb_result");
+      hbChannel.emplace_back("hb_channel");
+      auto addHB = [this](const std::string &name) {
+        hbResult.emplace_back("hb_"s + name + "_result");
+        hbChannel.emplace_back("hb_"s + name + "_channel");
+        hbObsratio.emplace_back("hb_"s + name + "_obsratio");
+        hbNcombined.emplace_back("hb_"s + name + "_ncombined");
+      };
+      for (size_t i = 0; i != HiggsBS::nHzero; ++i)
+        addHB(Model::namesHzero[i]);
+      for (size_t i = 0; i != HiggsBS::nHplus; ++i)
+        addHB(Model::namesHplus[i]);
+      for (size_t i = 0; i != HiggsBS::nHzero; ++i) {
+        const auto prefix = "mu_"s + Model::namesHzero[i];
+        muWW.emplace_back(prefix + "_WW");
+        muZZ.emplace_back(prefix + "_ZZ");
+        muGamgam.emplace_back(prefix + "_gamgam");
+        muTautau.emplace_back(prefix + "_tautau");
+        muBB.emplace_back(prefix + "_bb");
+        muBBVH.emplace_back(prefix + "_bb_VH");
+      }
+    }
+  };
+  static const DataKeys &Keys() {
+    static const DataKeys keys{};
+    return keys;
+  }
   double _chisqCut;
+  HiggsBS &hbhs_;
 };
 
 } // namespace ScannerS::Constraints
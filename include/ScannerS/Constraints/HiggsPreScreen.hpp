@@ -0,0 +1,209 @@
+#pragma once
+
+#include "ScannerS/Constraints/Constraint.hpp"
+#include "ScannerS/DataMap.hpp"
+#include "ScannerS/Interfaces/Lilith.hpp"
+#include "ScannerS/Tools/LilithCouplings.hpp"
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace ScannerS::Constraints {
+
+//! Implementation details of the HiggsPreScreen constraint
+namespace HiggsPreScreenDetail {
+
+//! reference SM Higgs mass
+constexpr double mhref = 125.09;
+
+//! coupling modifiers of a neutral scalar relative to the SM Higgs
+struct Kappas {
+  double V;   //!< gauge boson coupling
+  double u_e; //!< CP-even up-type quark coupling
+  double u_o; //!< CP-odd up-type quark coupling
+  double d_e; //!< CP-even down-type quark coupling
+  double d_o; //!< CP-odd down-type quark coupling
+  double l_e; //!< CP-even lepton coupling
+  double l_o; //!< CP-odd lepton coupling
+};
+
+//! the registered keys `c_<name>VV`, ... of the couplings of a neutral scalar
+class CouplingKeys {
+public:
+  //! register the keys of the scalar with the given name
+  explicit CouplingKeys(const std::string &name);
+
+  //! whether the couplings of the scalar are stored
+  bool Stored(const DataMap &data) const { return data.Contains(VV_); }
+
+  //! the stored coupling modifiers, unset CP-odd couplings are zero
+  Kappas Read(const DataMap &data) const;
+
+private:
+  DataMap::Key VV_, uu_e_, uu_o_, dd_e_, dd_o_, ll_e_, ll_o_;
+};
+
+/**
+ * @brief Approximate Lilith couplings of a scalar close to 125 GeV.
+ *
+ * The CP-even couplings are completed by Tools::LilithCouplings::Complete(),
+ * which computes the loop-induced couplings like Lilith. CP-odd couplings are
+ * added in quadrature to the fermionic decays and to ttH and bbH production.
+ * They enter the gluon and photon couplings through the ratio of the
+ * leading-order CP-odd and CP-even top loop form factors. Charged Higgs loops
+ * are neglected and the mass is clamped to the range of the Lilith grids.
+ *
+ * @param lc the Lilith grids
+ * @param k the coupling modifiers
+ * @param mh the mass of the scalar in GeV
+ * @return Tools::LilithCouplings::Higgs the complete couplings
+ */
+Tools::LilithCouplings::Higgs Couplings(const Tools::LilithCouplings &lc,
+                                        const Kappas &k, double mh);
+
+//! the signal strengths of a single scalar with the Couplings()
+Interfaces::Lilith::SignalStrengths Mu(const Tools::LilithCouplings &lc,
+                                       const Kappas &k, double mh);
+
+/**
+ * @brief Signal strengths summed over the neutral scalars close to 125 GeV.
+ *
+ * The signal strengths of all scalars with stored couplings and masses in
+ * [Tools::LilithCouplings::minMass, Tools::LilithCouplings::maxMass] are
+ * computed from their Couplings() and added up with
+ * Tools::LilithCouplings::TotalMu(). If there is no scalar in this range, the
+ * one closest to 125.09 GeV is used at the clamped mass. Throws a
+ * `std::runtime_error` if no couplings are stored.
+ *
+ * @tparam Model see HiggsPreScreen
+ * @param lc the Lilith grids
+ * @param p the parameter point
+ * @return Interfaces::Lilith::SignalStrengths the summed signal strengths
+ */
+template <class Model>
+Interfaces::Lilith::SignalStrengths
+TotalMu(const Tools::LilithCouplings &lc,
+        const typename Model::ParameterPoint &p) {
+  using Tools::LilithCouplings;
+  static const auto keys = [] {
+    auto result = std::vector<CouplingKeys>{};
+    result.reserve(Model::namesHzero.size());
+    for (const auto &name : Model::namesHzero)
+      result.emplace_back(name);
+    return result;
+  }();
+  const auto masses = Model::MassesHzero(p);
+  auto higgs = std::array<LilithCouplings::Higgs, Model::namesHzero.size()>{};
+  size_t n = 0;
+  size_t closest = masses.size();
+  for (size_t i = 0; i != masses.size(); ++i) {
+    if (!keys[i].Stored(p.data))
+      continue;
+    if (masses[i] >= LilithCouplings::minMass &&
+        masses[i] <= LilithCouplings::maxMass)
+      higgs[n++] = Couplings(lc, keys[i].Read(p.data), masses[i]);
+    else if (closest == masses.size() ||
+             std::abs(masses[i] - mhref) < std::abs(masses[closest] - mhref))
+      closest = i;
+  }
+  if (n == 0 && closest != masses.size())
+    higgs[n++] = Couplings(lc, keys[closest].Read(p.data), masses[closest]);
+  if (n == 0)
+    throw(std::runtime_error("The couplings of the neutral scalars have to "
+                             "be calculated before their signal strengths"));
+  return lc.TotalMu(higgs.data(), n);
+}
+
+} // namespace HiggsPreScreenDetail
+
+/**
+ * @brief Fast approximate pre-screen for the Higgs constraint.
+ *
+ * Approximates the rate \f$\chi^2\f$ of Constraints::Higgs from the couplings
+ * of the neutral scalars without calling HDECAY, HiggsBounds or HiggsSignals.
+ * The signal strengths of all scalars with masses in
+ * [Tools::LilithCouplings::minMass, Tools::LilithCouplings::maxMass], which
+ * covers the mass resolution of the HiggsSignals observables, are added up
+ * (see HiggsPreScreenDetail::TotalMu()) and evaluated with the Lilith
+ * likelihood of the
+ * `data/latest.list` of the given Lilith directory. Only
+ * points with an approximate \f$ \Delta\chi^2 \f$ below the \f$\chi^2\f$ cut
+ * plus a margin are passed. It is meant to be applied directly before
+ * `Model::RunHdecay` and Constraints::Higgs, with a margin large enough to
+ * absorb the differences to the full calculation. Since the Lilith and
+ * HiggsSignals inputs are not identical, the margin should be checked against
+ * a scan with HiggsSignals when the experimental input of either changes.
+ * The pre-screen is therefore skipped by default and has to be enabled
+ * together with an explicit margin.
+ *
+ * Stores the approximate \f$ \Delta\chi^2 \f$ as `prescreen_deltaChisq`.
+ *
+ * **Requires CalcCouplings to be called beforehand.**
+ *
+ * @tparam Model a model class with a `Model::MassesHzero(p)` function that
+ * returns the neutral scalar masses in the order of `Model::namesHzero`. For
+ * each scalar `Hi` that is a candidate for the SM-like Higgs the couplings
+ * `c_HiVV`, `c_Hiuu_e`, `c_Hidd_e` and `c_Hill_e` (and optionally the CP-odd
+ * `c_Hiuu_o`, `c_Hidd_o` and `c_Hill_o`) have to be stored in the point.
+ */
+template <class Model>
+class HiggsPreScreen : public Constraint<HiggsPreScreen, Model> {
+public:
+  static constexpr auto constraintId = "HiggsPreScreen"; //!< unique ID
+  //! the pre-screen is only used if it is explicitly enabled
+  static constexpr auto defaultSeverity = Severity::skip;
+
+  //! reference SM Higgs mass
+  static constexpr double mhref = HiggsPreScreenDetail::mhref;
+
+  /**
+   * @brief Construct a new Higgs pre-screen.
+   *
+   * Throws a `std::runtime_error` if the pre-screen is not skipped and the
+   * margin is not finite, since there is no margin that is safe in general.
+   * The Lilith data is only read if the pre-screen is not skipped.
+   *
+   * @param severity the severity
+   * @param chisqCut the \f$\chi^2\f$ cut used in Constraints::Higgs
+   * @param margin the additional margin in \f$\Delta\chi^2\f$
+   * @param lilithDir the Lilith directory that provides the grids and the
+   * experimental input
+   */
+  HiggsPreScreen(Severity severity, double chisqCut, double margin,
+                 const std::string &lilithDir =
+                     Interfaces::Lilith::DefaultDir())
+      : Constraint<HiggsPreScreen, Model>{severity}, chisqCut_{chisqCut},
+        margin_{margin}, key_{"prescreen_deltaChisq"} {
+    if (severity == Severity::skip)
+      return;
+    if (!std::isfinite(margin))
+      throw(std::runtime_error("The Higgs pre-screen requires an explicit "
+                               "margin in Delta chisq"));
+    couplings_ = &Tools::SharedLilithCouplings(lilithDir);
+    likelihood_ = &Interfaces::Lilith::SharedLikelihood(
+        Interfaces::Lilith::DefaultList(lilithDir), lilithDir);
+    chisqSM_ = (*likelihood_)(Interfaces::Lilith::SignalStrengths::SMLike());
+  }
+
+  //! apply the pre-screen
+  bool Apply(typename Model::ParameterPoint &p) const {
+    const double deltaChisq =
+        (*likelihood_)(HiggsPreScreenDetail::TotalMu<Model>(*couplings_, p)) -
+        chisqSM_;
+    p.data.Store(key_, deltaChisq);
+    return deltaChisq < chisqCut_ + margin_;
+  }
+
+private:
+  double chisqCut_;
+  double margin_;
+  const Tools::LilithCouplings *couplings_ = nullptr;
+  const Interfaces::Lilith::Likelihood *likelihood_ = nullptr;
+  double chisqSM_ = 0.;
+  DataMap::Key key_;
+};
+
+} // namespace ScannerS::Constraints
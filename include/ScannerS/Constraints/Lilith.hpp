@@ -0,0 +1,78 @@
+#pragma once
+
+#include "ScannerS/Constraints/Constraint.hpp"
+#include "ScannerS/DataMap.hpp"
+#include "ScannerS/Interfaces/Lilith.hpp"
+#include "ScannerS/Tools/LilithCouplings.hpp"
+#include <string>
+
+namespace ScannerS::Constraints {
+
+/**
+ * @brief Higgs signal strength constraint from the Lilith likelihood.
+ *
+ * Evaluates the likelihood of the bundled Lilith (see
+ * Interfaces::Lilith::Likelihood) natively in C++. The experimental input is
+ * read once and shared between all instances using the same list file.
+ * Applying the constraint is const and can be done concurrently from multiple
+ * threads.
+ *
+ * Stores \f$ -2\log L \f$ as `lilith_chisq`. A point passes if its
+ * \f$ -2\log L \f$ exceeds the one of the SM (see
+ * Interfaces::Lilith::SignalStrengths::SMLike()) by less than the given cut.
+ * The constraint is skipped by default, the Lilith data is only read if it is
+ * used.
+ *
+ * @tparam Model a model class with a static function
+ * `Model::LilithSignalStrengths(p, lc)` that returns the
+ * Interfaces::Lilith::SignalStrengths of the point `p` summed over all
+ * scalars that contribute to the observed Higgs signal, eg from their reduced
+ * couplings with Tools::LilithCouplings::TotalMu() of the given grids `lc`.
+ */
+template <class Model> class Lilith : public Constraint<Lilith, Model> {
+public:
+  static constexpr auto constraintId = "Lilith"; //!< unique constraint ID
+  //! the constraint is only used if it is explicitly enabled
+  static constexpr auto defaultSeverity = Severity::skip;
+
+  /**
+   * @brief Construct a new Lilith constraint.
+   *
+   * @param severity the severity
+   * @param chisqCut the maximal \f$ -2\log L + 2\log L_\mathrm{SM} \f$
+   * @param expList the Lilith `.list` file of the experimental input or a
+   * database compiled from it (see Interfaces::Lilith::WriteDatabase())
+   * @param lilithDir the Lilith directory that provides the grids
+   */
+  Lilith(Severity severity, double chisqCut,
+         const std::string &expList = Interfaces::Lilith::DefaultList(),
+         const std::string &lilithDir = Interfaces::Lilith::DefaultDir())
+      : Constraint<Lilith, Model>{severity}, chisqCut_{chisqCut},
+        key_{"lilith_chisq"} {
+    if (severity == Severity::skip)
+      return;
+    couplings_ = &Tools::SharedLilithCouplings(lilithDir);
+    likelihood_ = &Interfaces::Lilith::SharedLikelihood(expList, lilithDir);
+    chisqSM_ = (*likelihood_)(Interfaces::Lilith::SignalStrengths::SMLike());
+  }
+
+  //! apply the constraint
+  bool Apply(typename Model::ParameterPoint &p) const {
+    const double chisq =
+        (*likelihood_)(Model::LilithSignalStrengths(p, *couplings_));
+    p.data.Store(key_, chisq);
+    return chisq - chisqSM_ < chisqCut_;
+  }
+
+  //! \f$ -2\log L \f$ of the SM, zero if the constraint is skipped
+  double ChisqSM() const noexcept { return chisqSM_; }
+
+private:
+  double chisqCut_;
+  const Tools::LilithCouplings *couplings_ = nullptr;
+  const Interfaces::Lilith::Likelihood *likelihood_ = nullptr;
+  double chisqSM_ = 0.;
+  DataMap::Key key_;
+};
+
+} // namespace ScannerS::Constraints
@@ -2,10 +2,14 @@
 
 #include "ScannerS/Constants.hpp"
 #include "ScannerS/Constraints/Constraint.hpp"
+#include "ScannerS/DataMap.hpp"
+#include "ScannerS/Tools/PointBatch.hpp"
 #include <Eigen/Core>
 #include <array>
 #include <cmath>
+#include <complex>
 #include <cstddef>
+#include <iterator>
 #include <stdexcept>
 #include <string>
 #include <vector>
@@ -44,6 +48,87 @@ double G(double I, double J, double Q);
 //!  \f$ \hat{G}(I,Q) \f$ of eq. (C5) @relatedalso ScannerS::Constraints::STU
 double G2(double I, double Q);
 
+//! maximal number of terms that LoopTermBatch evaluates at once
+constexpr int chunkSize = 64;
+//! array with the capacity of one chunk, which needs no heap allocations
+using ChunkArray = Eigen::Array<double, Eigen::Dynamic, 1, Eigen::ColMajor,
+                                chunkSize>;
+
+//! vectorized \f$ \arctan(x) \f$ accurate to double precision
+Eigen::ArrayXd Atan(const Eigen::ArrayXd &x);
+//! vectorized F() for many arguments @relatedalso ScannerS::Constraints::STU
+Eigen::ArrayXd F(const Eigen::ArrayXd &I, const Eigen::ArrayXd &J);
+//! vectorized FuncF() for many arguments
+//! @relatedalso ScannerS::Constraints::STU
+Eigen::ArrayXd FuncF(const Eigen::ArrayXd &t, const Eigen::ArrayXd &r);
+//! vectorized G() for many arguments @relatedalso ScannerS::Constraints::STU
+Eigen::ArrayXd G(const Eigen::ArrayXd &I, const Eigen::ArrayXd &J,
+                 const Eigen::ArrayXd &Q);
+//! vectorized G2() for many arguments @relatedalso ScannerS::Constraints::STU
+Eigen::ArrayXd G2(const Eigen::ArrayXd &I, const Eigen::ArrayXd &Q);
+
+//! Atan() for a chunk @relatedalso ScannerS::Constraints::STU
+ChunkArray Atan(const ChunkArray &x);
+//! F() for a chunk @relatedalso ScannerS::Constraints::STU
+ChunkArray F(const ChunkArray &I, const ChunkArray &J);
+//! FuncF() for a chunk @relatedalso ScannerS::Constraints::STU
+ChunkArray FuncF(const ChunkArray &t, const ChunkArray &r);
+//! G() for a chunk @relatedalso ScannerS::Constraints::STU
+ChunkArray G(const ChunkArray &I, const ChunkArray &J, const ChunkArray &Q);
+//! G2() for a chunk @relatedalso ScannerS::Constraints::STU
+ChunkArray G2(const ChunkArray &I, const ChunkArray &Q);
+
+//! the loop functions appearing in the oblique parameters
+enum class LoopFunction { F, G, G2, Log };
+
+/**
+ * @brief Collects the loop function terms of S, T and U for many points.
+ *
+ * Each term is a loop function with its arguments and the coefficients with
+ * which it contributes to \f$ S \f$, \f$ T \f$ and \f$ U \f$ of a point.
+ * Evaluate() then calls the vectorized loop functions for chunks of up to
+ * #chunkSize terms of the same type. Once the storage has grown to the size
+ * of a batch, collecting and evaluating the terms does not allocate.
+ */
+class LoopTermBatch {
+public:
+  /**
+   * @brief Adds a term.
+   *
+   * @param fn the loop function, arguments that are not used by the function
+   * are ignored (`Log` uses only I)
+   * @param point index of the point
+   * @param I first argument
+   * @param J second argument
+   * @param Q third argument
+   * @param cS coefficient in S
+   * @param cT coefficient in T
+   * @param cU coefficient in U
+   */
+  void Add(LoopFunction fn, size_t point, double I, double J, double Q,
+           double cS, double cT, double cU);
+
+  /**
+   * @brief Evaluates all terms.
+   *
+   * @param nPoints the number of points
+   * @param sums set to the sums of all terms contributing to S, T and U for
+   * each point, its storage is reused
+   */
+  void Evaluate(size_t nPoints, std::vector<std::array<double, 3>> &sums) const;
+
+  //! removes all terms, keeping the capacity
+  void Clear();
+
+private:
+  struct Terms {
+    std::vector<double> I, J, Q;
+    std::vector<double> cS, cT, cU;
+    std::vector<size_t> point;
+  };
+  std::array<Terms, 4> terms_;
+};
+
 /**
  * @brief Input parameters for the oblique parameter calculation.
  *
@@ -64,6 +149,30 @@ struct STUParameters {
   //! charged Higgs masses \f$ \mu_{b+1} \f$ *excluding* the EW goldstone
   std::vector<double> mHcharged;
 };
+
+/**
+ * @brief Fixed-size variant of STUParameters.
+ *
+ * Stores the mixing matrices in fixed-size Eigen types and the masses in
+ * `std::array`s, such that no heap allocations are needed. A model can return
+ * this from its `STUInput` instead of STUParameters.
+ *
+ * @tparam nd number of doublets \f$ n_d \f$
+ * @tparam m number of neutral mass eigenstates \f$ m \f$ including the
+ * goldstone
+ * @tparam n number of charged mass eigenstates \f$ n \f$ including the
+ * goldstone
+ */
+template <int nd, int m, int n> struct FixedSTUParameters {
+  //! the \f$ n_d\times m \f$ matrix \f$\mathcal{V}\f$ defined in eq. (22)
+  Eigen::Matrix<std::complex<double>, nd, m> mV;
+  //! the \f$ n_d\times n \f$ matrix \f$\mathcal{U}\f$ defined in eq. (21)
+  Eigen::Matrix<double, nd, n> mU;
+  //! neutral Higgs masses \f$ m_{a+1} \f$ *excluding* the EW goldstone
+  std::array<double, m - 1> mHzero;
+  //! charged Higgs masses \f$ \mu_{b+1} \f$ *excluding* the EW goldstone
+  std::array<double, n - 1> mHcharged;
+};
 } // namespace STUDetail
 
 /**
@@ -74,9 +183,9 @@ struct STUParameters {
  * [0802.4353](https://arxiv.org/pdf/0802.4353.pdf).
  *
  * @tparam Model A model class with functions
- * `Model::STUInput(p)->STUParameters` and Model::EWPValid(p)->bool` for a
- * corresponding ParameterPoint `p`. The second one should return whether the
- * oblique parameter approximation is valid.
+ * `Model::STUInput(p)->STUParameters` (or STUDetail::FixedSTUParameters) and
+ * Model::EWPValid(p)->bool` for a corresponding ParameterPoint `p`. The second
+ * one should return whether the oblique parameter approximation is valid.
  */
 template <class Model> class STU : public Constraint<STU, Model> {
 public:
@@ -86,9 +195,13 @@ public:
   //! the reference Higgs mass
   explicit STU(Severity severity, double chisqCrit = Constants::chisq2Sigma3d,
                double mhref = STUDetail::STUFit::mhref)
-      : Constraint<STU, Model>{severity}, chisqCrit_{chisqCrit}, mhref2{mhref *
-                                                                        mhref} {
-  }
+      : Constraint<STU, Model>{severity}, mhref2{mhref * mhref},
+        chisqCrit_{chisqCrit},
+        refS_{-std::log(mhref2) - STUDetail::G2(mhref2, Constants::mZsq)},
+        refT_{-3 * (STUDetail::F(Constants::mZsq, mhref2) -
+                    STUDetail::F(Constants::mWsq, mhref2))},
+        refU_{-(STUDetail::G2(mhref2, Constants::mWsq) -
+                STUDetail::G2(mhref2, Constants::mZsq))} {}
 
   /**
    * @brief Obtains the STU limit.
@@ -101,8 +214,122 @@ public:
    * \f$ \chi^2_\mathrm{crit} \f$
    */
   bool Apply(typename Model::ParameterPoint &p) {
-    auto in = Model::STUInput(p);
+    Prepare(Model::STUInput(p));
+    return Store(p, CalcS(), CalcT(), CalcU());
+  }
+
+  /**
+   * @brief Applies the constraint to many points at once.
+   *
+   * Equivalent to calling the constraint on each point, including the
+   * handling of the severity. The loop functions of all points are evaluated
+   * together in vectorized form through STUDetail::LoopTermBatch.
+   *
+   * @param points a range of parameter points
+   * @return std::vector<bool> whether each point passed the constraint
+   */
+  template <class Points> std::vector<bool> ApplyBatch(Points &points) {
+    const auto severity = this->GetSeverity();
+    if (severity == Severity::skip)
+      return std::vector<bool>(std::size(points), true);
+
+    batch_.Clear();
+    size_t nPoints = 0;
+    for (auto &p : points) {
+      Prepare(Model::STUInput(p));
+      AddTerms(nPoints++);
+    }
+    batch_.Evaluate(nPoints, sums_);
 
+    auto result = std::vector<bool>(nPoints);
+    size_t i = 0;
+    for (auto &p : points) {
+      const auto stu = Oblique(sums_[i]);
+      result[i++] =
+          this->ResultWithSeverity(p, Store(p, stu[0], stu[1], stu[2]));
+    }
+    return result;
+  }
+
+  /**
+   * @brief Applies the constraint to the candidates of a Tools::PointBatch.
+   *
+   * Calculates S, T and U of all remaining candidates from the parameter
+   * columns through `Model::STUInput(cols, i)`, evaluating the loop functions
+   * in vectorized form. If the constraint is applied, candidates with \f$
+   * \chi^2 \geq \chi^2_\mathrm{crit} \f$ are removed from the batch before
+   * any parameter points are materialized. The results are stored in the
+   * materialized points through BatchResult().
+   *
+   * @param batch the batch of candidates
+   * @return size_t the number of remaining candidates
+   */
+  size_t ApplyBatch(Tools::PointBatch<Model> &batch) {
+    const auto &survivors = batch.Survivors();
+    if (this->GetSeverity() == Severity::skip)
+      return survivors.size();
+
+    batch_.Clear();
+    for (size_t k = 0; k != survivors.size(); ++k) {
+      Prepare(Model::STUInput(batch.Columns(), survivors[k]));
+      AddTerms(k);
+    }
+    batch_.Evaluate(survivors.size(), sums_);
+    batchResults_.resize(batch.size());
+    for (size_t k = 0; k != survivors.size(); ++k)
+      batchResults_[survivors[k]] = Oblique(sums_[k]);
+
+    if (this->GetSeverity() != Severity::apply)
+      return survivors.size();
+    return batch.Filter([this](const auto &, size_t i) {
+      const auto &stu = batchResults_[i];
+      return STUDetail::Chisq(stu[0], stu[1], stu[2]) < chisqCrit_;
+    });
+  }
+
+  /**
+   * @brief The result of the last ApplyBatch() for a materialized point.
+   *
+   * Stores the same values as Apply() and handles the severity, such that
+   * ApplyBatch() followed by BatchResult() for every materialized candidate
+   * is equivalent to calling the constraint on each point.
+   *
+   * @param p the parameter point materialized from the batch
+   * @param i the index of the point in the batch
+   * @return constraint passed, taking severity into account
+   */
+  bool BatchResult(typename Model::ParameterPoint &p, size_t i) {
+    if (this->GetSeverity() == Severity::skip)
+      return true;
+    const auto &stu = batchResults_.at(i);
+    return this->ResultWithSeverity(p, Store(p, stu[0], stu[1], stu[2]));
+  }
+
+private:
+  static constexpr int m_ = static_cast<int>(Model::nHzero) + 1;
+  static constexpr int n_ = static_cast<int>(Model::nHplus) + 1;
+  const double mhref2;
+  const double chisqCrit_;
+  // point-independent reference Higgs contributions
+  const double refS_;
+  const double refT_;
+  const double refU_;
+  STUDetail::LoopTermBatch batch_;
+  // the sums of the loop terms of the last batch
+  std::vector<std::array<double, 3>> sums_;
+  // S, T and U of the candidates of the last batch by their index
+  std::vector<std::array<double, 3>> batchResults_;
+
+  Eigen::Matrix<double, m_, m_> ImVVsq;
+  Eigen::Matrix<double, n_, m_> UVsq;
+  Eigen::Matrix<double, n_, n_> UUsq;
+  Eigen::Matrix<double, n_, 1> dUU;
+  Eigen::Matrix<double, m_, 1> dVV;
+
+  std::array<double, n_> mcsq;
+  std::array<double, m_> m0sq;
+
+  template <class Parameters> void Prepare(const Parameters &in) {
     if (in.mHzero.size() != m_ - 1) {
       throw(std::runtime_error(
           "Number of masses does not match number of neutral Higgs bosons " +
@@ -129,30 +356,75 @@ public:
     UUsq = (in.mU.adjoint() * in.mU).cwiseAbs2();
     dUU = (in.mU.adjoint() * in.mU).diagonal();
     dVV = (in.mV.adjoint() * in.mV).diagonal().real();
+  }
 
-    p.data.Store("S", CalcS());
-    p.data.Store("T", CalcT());
-    p.data.Store("U", CalcU());
-    p.data.Store("STU_chisq",
-                 STUDetail::Chisq(p.data["S"], p.data["T"], p.data["U"]));
+  bool Store(typename Model::ParameterPoint &p, double S, double T,
+             double U) const {
+    static const auto keyS = DataMap::Key{"S"};
+    static const auto keyT = DataMap::Key{"T"};
+    static const auto keyU = DataMap::Key{"U"};
+    static const auto keyChisq = DataMap::Key{"STU_chisq"};
+    const double chisq = STUDetail::Chisq(S, T, U);
+    p.data.Store(keyS, S);
+    p.data.Store(keyT, T);
+    p.data.Store(keyU, U);
+    p.data.Store(keyChisq, chisq);
 
-    return Model::EWPValid(p) && p.data["STU_chisq"] < chisqCrit_;
+    return Model::EWPValid(p) && chisq < chisqCrit_;
   }
 
-private:
-  static constexpr int m_ = static_cast<int>(Model::nHzero) + 1;
-  static constexpr int n_ = static_cast<int>(Model::nHplus) + 1;
-  const double mhref2;
-  const double chisqCrit_;
-
-  Eigen::Matrix<double, m_, m_> ImVVsq;
-  Eigen::Matrix<double, n_, m_> UVsq;
-  Eigen::Matrix<double, n_, n_> UUsq;
-  Eigen::Matrix<double, n_, 1> dUU;
-  Eigen::Matrix<double, m_, 1> dVV;
+  // S, T and U from the sums of the terms added by AddTerms
+  std::array<double, 3> Oblique(const std::array<double, 3> &sum) const {
+    return {(sum[0] + refS_) / 24 / Constants::pi,
+            (sum[1] + refT_) / 16 / Constants::pi / Constants::s2tw /
+                Constants::mWsq,
+            (sum[2] + refU_) / 24 / Constants::pi};
+  }
 
-  std::array<double, n_> mcsq;
-  std::array<double, m_> m0sq;
+  // the terms of CalcS, CalcT and CalcU without the prefactors and reference
+  // contributions
+  void AddTerms(size_t point) {
+    using STUDetail::LoopFunction;
+    constexpr double mZsq = Constants::mZsq;
+    constexpr double mWsq = Constants::mWsq;
+    auto add = [this, point](LoopFunction fn, double I, double J, double Q,
+                             double cS, double cT, double cU) {
+      batch_.Add(fn, point, I, J, Q, cS, cT, cU);
+    };
+    for (size_t a = 1; a < n_; ++a) {
+      const double c = pow(2 * Constants::s2tw - dUU(a), 2);
+      add(LoopFunction::G, mcsq[a], mcsq[a], mZsq, c, 0, -c);
+      add(LoopFunction::Log, mcsq[a], 0, 0, -2 * dUU(a), 0, 0);
+    }
+    for (size_t a1 = 1; a1 < n_ - 1; ++a1) {
+      for (size_t a2 = a1 + 1; a2 < n_; ++a2) {
+        const double c = 2 * UUsq(a1, a2);
+        add(LoopFunction::G, mcsq[a1], mcsq[a2], mZsq, c, 0, -c);
+        add(LoopFunction::F, mcsq[a1], mcsq[a2], 0, 0, -c, 0);
+      }
+    }
+    for (size_t b1 = 1; b1 < m_ - 1; ++b1) {
+      for (size_t b2 = b1 + 1; b2 < m_; ++b2) {
+        const double c = ImVVsq(b1, b2);
+        add(LoopFunction::G, m0sq[b1], m0sq[b2], mZsq, c, 0, -c);
+        add(LoopFunction::F, m0sq[b1], m0sq[b2], 0, 0, -c, 0);
+      }
+    }
+    for (size_t b = 1; b < m_; ++b) {
+      const double c = ImVVsq(0, b);
+      add(LoopFunction::Log, m0sq[b], 0, 0, dVV(b), 0, 0);
+      add(LoopFunction::G2, m0sq[b], 0, mZsq, c, 0, -c);
+      add(LoopFunction::G2, m0sq[b], 0, mWsq, 0, 0, c);
+      add(LoopFunction::F, mZsq, m0sq[b], 0, 0, 3 * c, 0);
+      add(LoopFunction::F, mWsq, m0sq[b], 0, 0, -3 * c, 0);
+    }
+    for (size_t a = 1; a < n_; ++a) {
+      for (size_t b = 1; b < m_; ++b) {
+        add(LoopFunction::G, mcsq[a], m0sq[b], mWsq, 0, 0, UVsq(a, b));
+        add(LoopFunction::F, mcsq[a], m0sq[b], 0, 0, UVsq(a, b), 0);
+      }
+    }
+  }
 
   // eq. 30
   // line by line with prefactors from eq. 8 incl.
@@ -180,11 +452,10 @@ private:
     for (size_t b = 1; b < m_; ++b) {
       S0 += dVV(b) * log(m0sq[b]);
     }
-    S0 -= log(mhref2);
     for (size_t b = 1; b < m_; ++b) {
       S0 += ImVVsq(0, b) * G2(m0sq[b], Constants::mZsq);
     }
-    S0 -= G2(mhref2, Constants::mZsq);
+    S0 += refS_;
     return S0 / 24 / Constants::pi;
   }
 
@@ -212,7 +483,7 @@ private:
       T0 += 3 * ImVVsq(0, b) *
             (F(Constants::mZsq, m0sq[b]) - F(Constants::mWsq, m0sq[b]));
     }
-    T0 -= 3 * (F(Constants::mZsq, mhref2) - F(Constants::mWsq, mhref2));
+    T0 += refT_;
     return T0 / 16 / ScannerS::Constants::pi / Constants::s2tw /
            Constants::mWsq;
   }
@@ -246,7 +517,7 @@ private:
       U0 += ImVVsq(0, b) *
             (G2(m0sq[b], Constants::mWsq) - G2(m0sq[b], Constants::mZsq));
     }
-    U0 -= G2(mhref2, Constants::mWsq) - G2(mhref2, Constants::mZsq);
+    U0 += refU_;
     return U0 / 24 / ScannerS::Constants::pi;
   }
 };
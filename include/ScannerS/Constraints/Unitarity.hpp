@@ -2,6 +2,7 @@
 
 #include "ScannerS/Constants.hpp"
 #include "ScannerS/Constraints/Constraint.hpp"
+#include "ScannerS/DataMap.hpp"
 
 namespace ScannerS::Constraints {
 
@@ -37,10 +38,14 @@ public:
    */
   bool Apply(typename Model::ParameterPoint &p) {
     double maxEV = Model::MaxUnitarityEV(p.L);
-    p.data.Store("maxEV", maxEV);
+    static const auto key = DataMap::Key{"maxEV"};
+    p.data.Store(key, maxEV);
     return maxEV < unitarityLimit_;
   }
 
+  //! the upper limit on `maxEV`
+  double Limit() const noexcept { return unitarityLimit_; }
+
 private:
   const double unitarityLimit_;
 };
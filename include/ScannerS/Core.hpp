@@ -1,5 +1,6 @@
 #pragma once
 
+#include "ScannerS/Campaign.hpp"              // IWYU pragma: export
 #include "ScannerS/Constants.hpp"             // IWYU pragma: export
 #include "ScannerS/DataMap.hpp"               // IWYU pragma: export
 #include "ScannerS/Output.hpp"                // IWYU pragma: export
@@ -1,12 +1,33 @@
 #pragma once
 
+#include <cstddef>
+#include <iterator>
+#include <limits>
 #include <map>
+#include <memory>
 #include <stdexcept>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace ScannerS {
 
-//! An associative container where elemnts cannot be modified after insertion
+/**
+ * @brief An associative container where elemnts cannot be modified after
+ * insertion
+ *
+ * Keys that are registered in the process-wide schema through a DataMap::Key
+ * are stored in a flat array indexed by their slot. Storing and retrieving
+ * values through a DataMap::Key is thus a simple array access. All other keys
+ * are stored in a map. Both kinds of keys can be accessed through their names
+ * as well, and iteration always proceeds in alphabetical order of the keys.
+ *
+ * The slot storage of destroyed DataMaps is recycled by the next DataMaps
+ * created on the same thread. Creating a DataMap for every candidate point and
+ * storing only registered keys thus does not allocate once the pool has warmed
+ * up. This only covers the DataMap itself, the model code and the external
+ * tools called by the constraints may still allocate.
+ */
 class DataMap {
 public:
   using Map = std::map<std::string, double>;
@@ -14,6 +35,34 @@ public:
   using key_type = Map::key_type;       //!< type of the keys
   using mapped_type = Map::mapped_type; //!< type of the mapped values
 
+  DataMap() = default;                               //!< empty DataMap
+  DataMap(const DataMap &) = default;                //!< copy constructor
+  DataMap(DataMap &&) noexcept = default;            //!< move constructor
+  DataMap &operator=(const DataMap &) = default;     //!< copy assignment
+  DataMap &operator=(DataMap &&) noexcept = default; //!< move assignment
+  //! Destructor that returns the slot storage to a per-thread pool
+  ~DataMap();
+
+  /**
+   * @brief A key that is registered in the schema.
+   *
+   * Registering the same name multiple times yields the same slot. Keys should
+   * be registered once (eg as `static const` objects) and then reused for all
+   * parameter points. Registration is thread-safe.
+   */
+  class Key {
+  public:
+    //! register the name in the schema
+    explicit Key(const key_type &name);
+    //! the name of the key
+    const key_type &Name() const;
+    //! the slot index of the key
+    std::size_t Slot() const noexcept { return slot_; }
+
+  private:
+    std::size_t slot_;
+  };
+
   /** Return the value corresponding to the key.
    * If key does not exist this throws a DataMapError.
    *
@@ -21,6 +70,23 @@ public:
    * @return const mapped_type& the value corresponding to key
    */
   const mapped_type &operator[](const key_type &key) const;
+  //! Fast overload for registered keys @copydoc operator[]()
+  const mapped_type &operator[](const Key &key) const {
+    const auto slot = key.Slot();
+    if (slot < slots_.size() && slots_[slot].set)
+      return slots_[slot].value;
+    return (*this)[key.Name()];
+  }
+
+  //! Whether an element with the given key exists
+  bool Contains(const key_type &key) const;
+  //! Fast overload for registered keys @copydoc Contains()
+  bool Contains(const Key &key) const {
+    const auto slot = key.Slot();
+    if (slot < slots_.size() && slots_[slot].set)
+      return true;
+    return slot >= extraSchemaSize_ && Contains(key.Name());
+  }
 
   /** Adds a new element {key : value}.
    * If key already exists this throws a DataMapError.
@@ -31,6 +97,16 @@ public:
   void Store(const key_type &key, mapped_type value);
   //! Overload for Rvalue keys @copydoc Store()
   void Store(key_type &&key, mapped_type value);
+  //! Fast overload for registered keys @copydoc Store()
+  void Store(const Key &key, mapped_type value) {
+    const auto slot = key.Slot();
+    if (slot >= slots_.size())
+      Grow();
+    auto &entry = slots_[slot];
+    if (entry.set || slot >= extraSchemaSize_)
+      return StoreChecked(slot, value);
+    entry = {value, true};
+  }
 
   /** Stores all entries of the source.
    * Throws a DataMapError it one of the keys already exists.
@@ -39,13 +115,72 @@ public:
    */
   void Merge(Map &&source);
 
+  //! Const iterator over the entries in alphabetical order of the keys
+  class const_iterator {
+  public:
+    //! an entry in the DataMap
+    using value_type = std::pair<const key_type &, const mapped_type &>;
+    using reference = value_type;                        //!< same as value
+    using pointer = void;                                //!< not supported
+    using difference_type = std::ptrdiff_t;              //!< difference type
+    using iterator_category = std::forward_iterator_tag; //!< forward iterator
+
+    //! dereference
+    value_type operator*() const;
+    //! pre-increment
+    const_iterator &operator++();
+    //! post-increment
+    const_iterator operator++(int) {
+      auto tmp = *this;
+      ++*this;
+      return tmp;
+    }
+    //! comparison
+    bool operator==(const const_iterator &other) const {
+      return pos_ == other.pos_ && extra_ == other.extra_;
+    }
+    //! comparison
+    bool operator!=(const const_iterator &other) const {
+      return !(*this == other);
+    }
+
+  private:
+    friend class DataMap;
+    const_iterator(const DataMap *map, std::size_t pos,
+                   Map::const_iterator extra);
+    void SkipUnset();
+    bool SlotFirst() const;
+
+    static constexpr std::size_t endPos =
+        std::numeric_limits<std::size_t>::max();
+
+    const DataMap *map_;
+    // the registered slots in alphabetical order when the iterator was created
+    std::shared_ptr<const std::vector<std::size_t>> sorted_;
+    std::size_t pos_;
+    Map::const_iterator extra_;
+  };
+
   //! Const begin iterator
-  auto begin() const noexcept { return data_.begin(); }
+  const_iterator begin() const;
   //! Const end iterator
-  auto end() const noexcept { return data_.end(); }
+  const_iterator end() const;
 
 private:
-  Map data_ = Map{};
+  struct Entry {
+    double value;
+    bool set;
+  };
+  std::vector<Entry> slots_ = std::vector<Entry>{};
+  Map extra_ = Map{};
+  //! size of the schema when the first unregistered key was stored, any keys
+  //! registered later could also be present in extra_
+  std::size_t extraSchemaSize_ = std::numeric_limits<std::size_t>::max();
+
+  void Grow();
+  static std::vector<std::vector<Entry>> *Buffers();
+  void StoreChecked(std::size_t slot, mapped_type value);
+  void StoreExtra(key_type &&key, mapped_type value);
 };
 
 //! Error class thrown by DataMap.
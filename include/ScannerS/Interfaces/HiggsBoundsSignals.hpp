@@ -5,8 +5,18 @@
 #include <Eigen/Core>
 #include <array>
 #include <complex>
+#include <cmath>
 #include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
 #include <unsupported/Eigen/CXX11/Tensor>
+#include <utility>
+#include <vector>
 
 /**
  * @brief C++ wrappers around the HiggsBounds/HiggsSignals library.
@@ -20,6 +30,13 @@ namespace ScannerS::Interfaces::HiggsBoundsSignals {
 //! @cond
 template <int nHzero, int nHplus> struct HBInput;
 template <int nHzero, int nHplus> struct HBInputEffC;
+
+namespace Detail {
+//! the HiggsBoundsSignals object whose input HiggsBounds currently holds
+inline const void *inputOwner = nullptr;
+//! number of (re)initializations of HiggsBounds and HiggsSignals
+inline std::size_t nInitializations = 0;
+} // namespace Detail
 //! @endcond
 
 /**
@@ -100,6 +117,46 @@ struct VHCxns {
 template <size_t nHzero, size_t nHplus>
 struct HBHSResult : public HBResult<nHzero, nHplus>, HSResult<nHzero> {};
 
+//! Settings of the HiggsBoundsSignals result cache
+struct CacheSettings {
+  //! maximal number of cached inputs, `0` disables the cache
+  std::size_t maxEntries = 0;
+  //! relative precision to which floating point inputs are rounded before
+  //! comparing them, `0` only reuses results for identical inputs
+  double quantization = 0.;
+};
+
+//! Hit statistics of the HiggsBoundsSignals result cache
+struct CacheStatistics {
+  std::size_t hits = 0;   //!< number of results taken from the cache
+  std::size_t misses = 0; //!< number of results that had to be calculated
+};
+
+//! The sets of analyses HiggsBounds can be initialized with
+enum class HBExperiments : int {
+  onlyL = 1, //!< only LEP analyses
+  onlyH = 2, //!< only hadron collider analyses
+  LandH = 3  //!< LEP and hadron collider analyses
+};
+
+/**
+ * @brief Parse HBExperiments from its name.
+ *
+ * Throws a `std::runtime_error` for unknown names.
+ *
+ * @param name one of `LandH`, `onlyL` or `onlyH`
+ */
+HBExperiments HBExperimentsFromString(const std::string &name);
+
+//! The analyses loaded by HiggsBoundsSignals
+struct AnalysisSettings {
+  //! the HiggsBounds analyses
+  HBExperiments hbExperiments = HBExperiments::LandH;
+  //! initialize HiggsSignals, HiggsBoundsSignals::RunHS() throws a
+  //! `std::runtime_error` otherwise
+  bool hs = true;
+};
+
 /**
  * Main interface class to the
  * [HiggsBounds](https://gitlab.com/higgsbounds/higgsbounds) and
@@ -112,25 +169,150 @@ public:
   static constexpr size_t nHzero = nHzero_; //!< number of neutral Higgs bosons
   static constexpr size_t nHplus = nHplus_; //!< number of charged Higgs bosons
 
-  //! Constructor that initializes HiggsBounds and HiggsSignals
-  HiggsBoundsSignals() {
-    initialize_HiggsBounds(nHzero, nHplus, 3 /* LandH */);
-    initialize_HiggsSignals_latestresults(nHzero, nHplus);
+  //! Constructor that initializes HiggsBounds and HiggsSignals with the given
+  //! analyses
+  explicit HiggsBoundsSignals(const AnalysisSettings &analyses = {}) {
+    Initialize(analyses);
+  }
+
+  /**
+   * @brief Reinitialize HiggsBounds and HiggsSignals with the given analyses.
+   *
+   * Restricting the analyses reduces the initialization time as well as the
+   * time per point. Does nothing if the analyses did not change. Otherwise,
+   * the global state of HiggsBounds and HiggsSignals is reset, which affects
+   * all HiggsBoundsSignals objects.
+   */
+  void Initialize(const AnalysisSettings &analyses) {
+    if (initialized_ && analyses.hbExperiments == analyses_.hbExperiments &&
+        analyses.hs == analyses_.hs)
+      return;
+    if (initialized_) {
+      finish_HiggsBounds();
+      if (analyses_.hs)
+        finish_HiggsSignals();
+    }
+    initialize_HiggsBounds(nHzero, nHplus,
+                           static_cast<int>(analyses.hbExperiments));
+    if (analyses.hs)
+      initialize_HiggsSignals_latestresults(nHzero, nHplus);
+    analyses_ = analyses;
+    initialized_ = true;
+    ++Detail::nInitializations;
+    Detail::inputOwner = this;
+    ResetInputCache();
+    cache_.clear();
+  }
+
+  //! the currently loaded analyses
+  const AnalysisSettings &Analyses() const noexcept { return analyses_; }
+
+  //! Destructor
+  ~HiggsBoundsSignals() {
+    if (Detail::inputOwner == this)
+      Detail::inputOwner = nullptr;
+  }
+
+  //! Copy constructor, the copy resends its complete first input
+  HiggsBoundsSignals(const HiggsBoundsSignals &) = default;
+  //! Copy assignment, the copy resends its complete first input
+  HiggsBoundsSignals &operator=(const HiggsBoundsSignals &) = default;
+
+  /**
+   * @brief Send the complete input during the next RunHBHS().
+   *
+   * HiggsBounds keeps its input between runs. RunHBHS() therefore only passes
+   * the blocks of the input (one block per `HiggsBounds_*_input*` subroutine)
+   * that differ from the previously sent input. This is reset automatically
+   * if another HiggsBoundsSignals object has used HiggsBounds in between or
+   * if the type of the input changes, but has to be called manually if the
+   * HiggsBounds input is modified by other means.
+   */
+  void ResetInputCache() noexcept {
+    for (auto &block : sent_)
+      block.clear();
+  }
+
+  /**
+   * @brief Enable or disable the result cache.
+   *
+   * If enabled, RunHB() and RunHS() store their results keyed by a hash of
+   * the input passed to SetInput(). The (quantized) input is stored alongside
+   * and compared on every lookup, such that hash collisions cannot return the
+   * results of a different input. Repeated inputs then return the stored
+   * results without running HiggsBounds or HiggsSignals. For a non-zero
+   * quantization, floating point inputs that agree to roughly this relative
+   * precision are treated as identical. The cache is cleared once it holds
+   * `maxEntries` inputs.
+   *
+   * Changing the settings clears the cache and its statistics.
+   */
+  void SetResultCache(const CacheSettings &settings) {
+    cacheSettings_ = settings;
+    cache_.clear();
+    cacheStats_ = {};
+  }
+
+  //! hit statistics of the result cache
+  const CacheStatistics &ResultCacheStatistics() const noexcept {
+    return cacheStats_;
   }
 
   /**
    * @brief Run HiggsBounds and HiggsSignals using the given input.
    *
+   * Equivalent to SetInput() followed by RunHB() and RunHS().
+   *
    * @tparam Input a type for which an overload of
    * HiggsBoundsSignals::HiggsBoundsInput exists, currently either HBInput or
    * HBInputEffC.
    */
   template <class Input> HBHSResult<nHzero, nHplus> RunHBHS(const Input &hbin) {
-    HiggsBoundsInput(hbin);
+    SetInput(hbin);
     HBHSResult<nHzero, nHplus> result;
+    static_cast<HBResult<nHzero, nHplus> &>(result) = RunHB();
+    static_cast<HSResult<nHzero> &>(result) = RunHS();
+    return result;
+  }
+
+  /**
+   * @brief Pass the input to HiggsBounds and HiggsSignals.
+   *
+   * The input is used by all following calls to RunHB() and RunHS().
+   *
+   * @tparam Input either HBInput or HBInputEffC
+   */
+  template <class Input> void SetInput(const Input &hbin) {
+    HiggsBoundsInput(hbin);
+  }
+
+  //! Run HiggsBounds on the current input.
+  HBResult<nHzero, nHplus> RunHB() {
+    auto *cached = CachedResults();
+    if (cached && cached->hb) {
+      ++cacheStats_.hits;
+      return *cached->hb;
+    }
+    HBResult<nHzero, nHplus> result;
     run_HiggsBounds_full(result.result.data(), result.chan.data(),
                          result.obsratio.data(), result.ncombined.data());
+    if (cached) {
+      ++cacheStats_.misses;
+      cached->hb = result;
+    }
+    return result;
+  }
 
+  //! Run HiggsSignals on the current input.
+  HSResult<nHzero> RunHS() {
+    if (!analyses_.hs)
+      throw(std::runtime_error("HiggsSignals has not been initialized"));
+    auto *cached = CachedResults();
+    if (cached && cached->hs) {
+      ++cacheStats_.hits;
+      return *cached->hs;
+    }
+    HSResult<nHzero> result;
     double Pvalue;
     run_HiggsSignals_full(&result.chisqMu, &result.chisqMass, &result.chisq,
                           &result.nobs, &Pvalue);
@@ -141,6 +323,10 @@ public:
                                &result.mu_tautau[i], &result.mu_bb[i],
                                &result.mu_bb_VH[i]);
     }
+    if (cached) {
+      ++cacheStats_.misses;
+      cached->hs = result;
+    }
     return result;
   }
 
@@ -219,98 +405,277 @@ private:
   static constexpr std::array<double, nHzero_ *nHzero_> zero = {};
   enum collider : int { TEV = 2, LHC7 = 7, LHC8 = 8, LHC13 = 13 };
 
+  // the HiggsBounds input subroutines
+  enum InputBlock : std::size_t {
+    neutralProperties,
+    neutralSMBR,
+    neutralEffC,
+    neutralNonSMBR,
+    neutralLEP,
+    neutralTEV,
+    neutralLHC7,
+    neutralLHC8,
+    neutralLHC13,
+    charged,
+    chargedLHC13,
+    nInputBlocks
+  };
+  enum class InputType { none, hadr, effC };
+
+  // the input last sent for each block
+  std::array<std::vector<unsigned char>, nInputBlocks> sent_;
+  InputType sentType_ = InputType::none;
+
+  AnalysisSettings analyses_;
+  bool initialized_ = false;
+
+  struct CachedResult {
+    // the quantized input the results belong to
+    std::vector<std::uint64_t> key;
+    std::optional<HBResult<nHzero, nHplus>> hb;
+    std::optional<HSResult<nHzero>> hs;
+  };
+  CacheSettings cacheSettings_;
+  CacheStatistics cacheStats_;
+  std::unordered_map<std::uint64_t, CachedResult> cache_;
+  // hash and quantized values of the current input
+  std::uint64_t inputHash_ = 0;
+  std::vector<std::uint64_t> inputKey_;
+
+  // the cache entry for the current input, nullptr if the cache is disabled
+  CachedResult *CachedResults() {
+    if (cacheSettings_.maxEntries == 0)
+      return nullptr;
+    auto entry = cache_.find(inputHash_);
+    if (entry == cache_.end()) {
+      if (cache_.size() >= cacheSettings_.maxEntries)
+        cache_.clear();
+      entry = cache_.emplace(inputHash_, CachedResult{inputKey_, {}, {}}).first;
+    } else if (entry->second.key != inputKey_) {
+      // hash collision, the entry is replaced by the current input
+      entry->second = CachedResult{inputKey_, {}, {}};
+    }
+    return &entry->second;
+  }
+
+  void HashValue(std::uint64_t bits) {
+    inputKey_.push_back(bits);
+    // splitmix64 finalizer
+    bits += 0x9e3779b97f4a7c15ULL;
+    bits = (bits ^ (bits >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    bits = (bits ^ (bits >> 27)) * 0x94d049bb133111ebULL;
+    bits ^= bits >> 31;
+    inputHash_ ^= bits + 0x9e3779b97f4a7c15ULL + (inputHash_ << 6) +
+                  (inputHash_ >> 2);
+  }
+
+  void HashValue(double x) {
+    const double q = cacheSettings_.quantization;
+    if (q > 0 && std::isfinite(x) && x != 0) {
+      int exponent;
+      const double mantissa = std::frexp(x, &exponent);
+      HashValue(static_cast<std::uint64_t>(std::llround(mantissa / q)));
+      HashValue(static_cast<std::uint64_t>(exponent));
+      return;
+    }
+    std::uint64_t bits;
+    x += 0.; // -0 -> +0
+    std::memcpy(&bits, &x, sizeof(bits));
+    HashValue(bits);
+  }
+
+  void HashValue(int x) {
+    HashValue(static_cast<std::uint64_t>(static_cast<std::int64_t>(x)));
+  }
+
+  template <class T> void HashInput(const T &x) {
+    if constexpr (std::is_arithmetic_v<T>)
+      HashValue(x);
+    else
+      for (Eigen::Index i = 0; i != static_cast<Eigen::Index>(x.size()); ++i)
+        HashValue(x.data()[i]);
+  }
+
+  // start sending an input of the given type
+  void BeginInput(InputType type) {
+    if (Detail::inputOwner != this || sentType_ != type)
+      ResetInputCache();
+    Detail::inputOwner = this;
+    sentType_ = type;
+    inputHash_ = static_cast<std::uint64_t>(type);
+    inputKey_.assign(1, inputHash_);
+  }
+
+  template <class T>
+  static std::pair<const void *, std::size_t> Bytes(const T &x) noexcept {
+    if constexpr (std::is_arithmetic_v<T>)
+      return {&x, sizeof(T)};
+    else
+      return {x.data(), x.size() * sizeof(*x.data())};
+  }
+
+  // compares the args to the input last sent for the block and stores them,
+  // also adds them to the hash of the input if the result cache is enabled
+  template <class... Args>
+  bool Changed(InputBlock block, const Args &...args) {
+    if (cacheSettings_.maxEntries != 0)
+      (HashInput(args), ...);
+    auto &sent = sent_[block];
+    const std::size_t size = (Bytes(args).second + ...);
+    bool changed = sent.size() != size;
+    if (changed)
+      sent.resize(size);
+    auto *pos = sent.data();
+    auto compare = [&changed, &pos](const auto &arg) {
+      const auto [data, n] = Bytes(arg);
+      if (n != 0 && (changed || std::memcmp(pos, data, n) != 0)) {
+        changed = true;
+        std::memcpy(pos, data, n);
+      }
+      pos += n;
+    };
+    (compare(args), ...);
+    return changed;
+  }
+
   void HiggsBoundsInput(const HBInput<nHzero_, nHplus_> &hbin) {
+    BeginInput(InputType::hadr);
     if (nHzero > 0) {
-      HiggsBounds_neutral_input_properties(
-          hbin.Mh.data(), hbin.GammaTotal_hj.data(), hbin.CP_value.data());
-      HiggsBounds_neutral_input_SMBR(
-          hbin.BR_hjss.data(), hbin.BR_hjcc.data(), hbin.BR_hjbb.data(),
-          hbin.BR_hjtt.data(), hbin.BR_hjmumu.data(), hbin.BR_hjtautau.data(),
-          hbin.BR_hjWW.data(), hbin.BR_hjZZ.data(), hbin.BR_hjZga.data(),
-          hbin.BR_hjgaga.data(), hbin.BR_hjgg.data());
-      HiggsBounds_neutral_input_nonSMBR(
-          hbin.BR_hjinvisible.data(), hbin.BR_hkhjhi.data(),
-          hbin.BR_hjhiZ.data(), hbin.BR_hjemu.data(), hbin.BR_hjetau.data(),
-          hbin.BR_hjmutau.data(), hbin.BR_hjHpiW.data());
-      HiggsBounds_neutral_input_LEP(
-          hbin.XS_ee_hjZ_ratio.data(), hbin.XS_ee_bbhj_ratio.data(),
-          hbin.XS_ee_tautauhj_ratio.data(), hbin.XS_ee_hjhi_ratio.data());
-      HiggsBounds_neutral_input_hadr(
-          TEV, hbin.TEV_CS_hj_ratio.data(), hbin.TEV_CS_gg_hj_ratio.data(),
-          hbin.TEV_CS_bb_hj_ratio.data(), hbin.TEV_CS_hjW_ratio.data(),
-          hbin.TEV_CS_hjZ_ratio.data(), hbin.TEV_CS_vbf_ratio.data(),
-          hbin.TEV_CS_tthj_ratio.data(), hbin.TEV_CS_thj_tchan_ratio.data(),
-          hbin.TEV_CS_thj_schan_ratio.data(), zero.data(), zero.data(),
-          zero.data(), hbin.TEV_CS_hjhi.data());
-      HiggsBounds_neutral_input_hadr(
-          LHC7, hbin.LHC7_CS_hj_ratio.data(), hbin.LHC7_CS_gg_hj_ratio.data(),
-          hbin.LHC7_CS_bb_hj_ratio.data(), hbin.LHC7_CS_hjW_ratio.data(),
-          hbin.LHC7_CS_hjZ_ratio.data(), hbin.LHC7_CS_vbf_ratio.data(),
-          hbin.LHC7_CS_tthj_ratio.data(), hbin.LHC7_CS_thj_tchan_ratio.data(),
-          hbin.LHC7_CS_thj_schan_ratio.data(), zero.data(), zero.data(),
-          zero.data(), hbin.LHC7_CS_hjhi.data());
-      HiggsBounds_neutral_input_hadr(
-          LHC8, hbin.LHC8_CS_hj_ratio.data(), hbin.LHC8_CS_gg_hj_ratio.data(),
-          hbin.LHC8_CS_bb_hj_ratio.data(), hbin.LHC8_CS_hjW_ratio.data(),
-          hbin.LHC8_CS_hjZ_ratio.data(), hbin.LHC8_CS_vbf_ratio.data(),
-          hbin.LHC8_CS_tthj_ratio.data(), hbin.LHC8_CS_thj_tchan_ratio.data(),
-          hbin.LHC8_CS_thj_schan_ratio.data(), zero.data(), zero.data(),
-          zero.data(), hbin.LHC8_CS_hjhi.data());
-      HiggsBounds_neutral_input_hadr(
-          LHC13, hbin.LHC13_CS_hj_ratio.data(),
-          hbin.LHC13_CS_gg_hj_ratio.data(), hbin.LHC13_CS_bb_hj_ratio.data(),
-          hbin.LHC13_CS_hjW_ratio.data(), hbin.LHC13_CS_hjZ_ratio.data(),
-          hbin.LHC13_CS_vbf_ratio.data(), hbin.LHC13_CS_tthj_ratio.data(),
-          hbin.LHC13_CS_thj_tchan_ratio.data(),
-          hbin.LHC13_CS_thj_schan_ratio.data(),
-          hbin.LHC13_CS_qq_hjZ_ratio.data(), hbin.LHC13_CS_gg_hjZ_ratio.data(),
-          hbin.LHC13_CS_tWhj_ratio.data(), hbin.LHC13_CS_hjhi.data());
-    }
-    if (nHplus > 0) {
-      HiggsBounds_charged_input(
-          hbin.Mhplus.data(), hbin.GammaTotal_Hpj.data(),
-          hbin.CS_ee_HpjHmj_ratio.data(), hbin.BR_tWpb, hbin.BR_tHpjb.data(),
-          hbin.BR_Hpjcs.data(), hbin.BR_Hpjcb.data(), hbin.BR_Hpjtaunu.data(),
-          hbin.BR_Hpjtb.data(), hbin.BR_HpjWZ.data(), hbin.BR_HpjhiW.data());
-      HiggsBounds_charged_input_hadr(
-          LHC13, hbin.LHC13_CS_Hpjtb.data(), hbin.LHC13_CS_Hpjcb.data(),
-          hbin.LHC13_CS_Hpjbjet.data(), hbin.LHC13_CS_Hpjcjet.data(),
-          hbin.LHC13_CS_Hpjjetjet.data(), hbin.LHC13_CS_HpjW.data(),
-          hbin.LHC13_CS_HpjZ.data(), hbin.LHC13_CS_vbf_Hpj.data(),
-          hbin.LHC13_CS_HpjHmj.data(), hbin.LHC13_CS_Hpjhi.data());
+      if (Changed(neutralProperties, hbin.Mh, hbin.GammaTotal_hj,
+                  hbin.CP_value))
+        HiggsBounds_neutral_input_properties(
+            hbin.Mh.data(), hbin.GammaTotal_hj.data(), hbin.CP_value.data());
+      if (Changed(neutralSMBR, hbin.BR_hjss, hbin.BR_hjcc, hbin.BR_hjbb,
+                  hbin.BR_hjtt, hbin.BR_hjmumu, hbin.BR_hjtautau, hbin.BR_hjWW,
+                  hbin.BR_hjZZ, hbin.BR_hjZga, hbin.BR_hjgaga, hbin.BR_hjgg))
+        HiggsBounds_neutral_input_SMBR(
+            hbin.BR_hjss.data(), hbin.BR_hjcc.data(), hbin.BR_hjbb.data(),
+            hbin.BR_hjtt.data(), hbin.BR_hjmumu.data(),
+            hbin.BR_hjtautau.data(), hbin.BR_hjWW.data(), hbin.BR_hjZZ.data(),
+            hbin.BR_hjZga.data(), hbin.BR_hjgaga.data(), hbin.BR_hjgg.data());
+      NonSMBRInput(hbin);
+      if (Changed(neutralLEP, hbin.XS_ee_hjZ_ratio, hbin.XS_ee_bbhj_ratio,
+                  hbin.XS_ee_tautauhj_ratio, hbin.XS_ee_hjhi_ratio))
+        HiggsBounds_neutral_input_LEP(
+            hbin.XS_ee_hjZ_ratio.data(), hbin.XS_ee_bbhj_ratio.data(),
+            hbin.XS_ee_tautauhj_ratio.data(), hbin.XS_ee_hjhi_ratio.data());
+      if (Changed(neutralTEV, hbin.TEV_CS_hj_ratio, hbin.TEV_CS_gg_hj_ratio,
+                  hbin.TEV_CS_bb_hj_ratio, hbin.TEV_CS_hjW_ratio,
+                  hbin.TEV_CS_hjZ_ratio, hbin.TEV_CS_vbf_ratio,
+                  hbin.TEV_CS_tthj_ratio, hbin.TEV_CS_thj_tchan_ratio,
+                  hbin.TEV_CS_thj_schan_ratio, hbin.TEV_CS_hjhi))
+        HiggsBounds_neutral_input_hadr(
+            TEV, hbin.TEV_CS_hj_ratio.data(), hbin.TEV_CS_gg_hj_ratio.data(),
+            hbin.TEV_CS_bb_hj_ratio.data(), hbin.TEV_CS_hjW_ratio.data(),
+            hbin.TEV_CS_hjZ_ratio.data(), hbin.TEV_CS_vbf_ratio.data(),
+            hbin.TEV_CS_tthj_ratio.data(), hbin.TEV_CS_thj_tchan_ratio.data(),
+            hbin.TEV_CS_thj_schan_ratio.data(), zero.data(), zero.data(),
+            zero.data(), hbin.TEV_CS_hjhi.data());
+      if (Changed(neutralLHC7, hbin.LHC7_CS_hj_ratio, hbin.LHC7_CS_gg_hj_ratio,
+                  hbin.LHC7_CS_bb_hj_ratio, hbin.LHC7_CS_hjW_ratio,
+                  hbin.LHC7_CS_hjZ_ratio, hbin.LHC7_CS_vbf_ratio,
+                  hbin.LHC7_CS_tthj_ratio, hbin.LHC7_CS_thj_tchan_ratio,
+                  hbin.LHC7_CS_thj_schan_ratio, hbin.LHC7_CS_hjhi))
+        HiggsBounds_neutral_input_hadr(
+            LHC7, hbin.LHC7_CS_hj_ratio.data(),
+            hbin.LHC7_CS_gg_hj_ratio.data(), hbin.LHC7_CS_bb_hj_ratio.data(),
+            hbin.LHC7_CS_hjW_ratio.data(), hbin.LHC7_CS_hjZ_ratio.data(),
+            hbin.LHC7_CS_vbf_ratio.data(), hbin.LHC7_CS_tthj_ratio.data(),
+            hbin.LHC7_CS_thj_tchan_ratio.data(),
+            hbin.LHC7_CS_thj_schan_ratio.data(), zero.data(), zero.data(),
+            zero.data(), hbin.LHC7_CS_hjhi.data());
+      if (Changed(neutralLHC8, hbin.LHC8_CS_hj_ratio, hbin.LHC8_CS_gg_hj_ratio,
+                  hbin.LHC8_CS_bb_hj_ratio, hbin.LHC8_CS_hjW_ratio,
+                  hbin.LHC8_CS_hjZ_ratio, hbin.LHC8_CS_vbf_ratio,
+                  hbin.LHC8_CS_tthj_ratio, hbin.LHC8_CS_thj_tchan_ratio,
+                  hbin.LHC8_CS_thj_schan_ratio, hbin.LHC8_CS_hjhi))
+        HiggsBounds_neutral_input_hadr(
+            LHC8, hbin.LHC8_CS_hj_ratio.data(),
+            hbin.LHC8_CS_gg_hj_ratio.data(), hbin.LHC8_CS_bb_hj_ratio.data(),
+            hbin.LHC8_CS_hjW_ratio.data(), hbin.LHC8_CS_hjZ_ratio.data(),
+            hbin.LHC8_CS_vbf_ratio.data(), hbin.LHC8_CS_tthj_ratio.data(),
+            hbin.LHC8_CS_thj_tchan_ratio.data(),
+            hbin.LHC8_CS_thj_schan_ratio.data(), zero.data(), zero.data(),
+            zero.data(), hbin.LHC8_CS_hjhi.data());
+      if (Changed(neutralLHC13, hbin.LHC13_CS_hj_ratio,
+                  hbin.LHC13_CS_gg_hj_ratio, hbin.LHC13_CS_bb_hj_ratio,
+                  hbin.LHC13_CS_hjW_ratio, hbin.LHC13_CS_hjZ_ratio,
+                  hbin.LHC13_CS_vbf_ratio, hbin.LHC13_CS_tthj_ratio,
+                  hbin.LHC13_CS_thj_tchan_ratio, hbin.LHC13_CS_thj_schan_ratio,
+                  hbin.LHC13_CS_qq_hjZ_ratio, hbin.LHC13_CS_gg_hjZ_ratio,
+                  hbin.LHC13_CS_tWhj_ratio, hbin.LHC13_CS_hjhi))
+        HiggsBounds_neutral_input_hadr(
+            LHC13, hbin.LHC13_CS_hj_ratio.data(),
+            hbin.LHC13_CS_gg_hj_ratio.data(), hbin.LHC13_CS_bb_hj_ratio.data(),
+            hbin.LHC13_CS_hjW_ratio.data(), hbin.LHC13_CS_hjZ_ratio.data(),
+            hbin.LHC13_CS_vbf_ratio.data(), hbin.LHC13_CS_tthj_ratio.data(),
+            hbin.LHC13_CS_thj_tchan_ratio.data(),
+            hbin.LHC13_CS_thj_schan_ratio.data(),
+            hbin.LHC13_CS_qq_hjZ_ratio.data(),
+            hbin.LHC13_CS_gg_hjZ_ratio.data(), hbin.LHC13_CS_tWhj_ratio.data(),
+            hbin.LHC13_CS_hjhi.data());
     }
+    ChargedInput(hbin);
   }
 
   void HiggsBoundsInput(const HBInputEffC<nHzero_, nHplus_> &hbin) {
+    BeginInput(InputType::effC);
     if (nHzero > 0) {
-      HiggsBounds_neutral_input_properties(
-          hbin.Mh.data(), hbin.GammaTotal_hj.data(), hbin.CP_value.data());
-      HiggsBounds_neutral_input_effC(
-          hbin.ghjss_s.data(), hbin.ghjss_p.data(), hbin.ghjcc_s.data(),
-          hbin.ghjcc_p.data(), hbin.ghjbb_s.data(), hbin.ghjbb_p.data(),
-          hbin.ghjtt_s.data(), hbin.ghjtt_p.data(), hbin.ghjmumu_s.data(),
-          hbin.ghjmumu_p.data(), hbin.ghjtautau_s.data(),
-          hbin.ghjtautau_p.data(), hbin.ghjWW.data(), hbin.ghjZZ.data(),
-          hbin.ghjZga.data(), hbin.ghjgaga.data(), hbin.ghjgg.data(),
-          hbin.ghjhiZ.data());
+      if (Changed(neutralProperties, hbin.Mh, hbin.GammaTotal_hj,
+                  hbin.CP_value))
+        HiggsBounds_neutral_input_properties(
+            hbin.Mh.data(), hbin.GammaTotal_hj.data(), hbin.CP_value.data());
+      if (Changed(neutralEffC, hbin.ghjss_s, hbin.ghjss_p, hbin.ghjcc_s,
+                  hbin.ghjcc_p, hbin.ghjbb_s, hbin.ghjbb_p, hbin.ghjtt_s,
+                  hbin.ghjtt_p, hbin.ghjmumu_s, hbin.ghjmumu_p,
+                  hbin.ghjtautau_s, hbin.ghjtautau_p, hbin.ghjWW, hbin.ghjZZ,
+                  hbin.ghjZga, hbin.ghjgaga, hbin.ghjgg, hbin.ghjhiZ))
+        HiggsBounds_neutral_input_effC(
+            hbin.ghjss_s.data(), hbin.ghjss_p.data(), hbin.ghjcc_s.data(),
+            hbin.ghjcc_p.data(), hbin.ghjbb_s.data(), hbin.ghjbb_p.data(),
+            hbin.ghjtt_s.data(), hbin.ghjtt_p.data(), hbin.ghjmumu_s.data(),
+            hbin.ghjmumu_p.data(), hbin.ghjtautau_s.data(),
+            hbin.ghjtautau_p.data(), hbin.ghjWW.data(), hbin.ghjZZ.data(),
+            hbin.ghjZga.data(), hbin.ghjgaga.data(), hbin.ghjgg.data(),
+            hbin.ghjhiZ.data());
+      NonSMBRInput(hbin);
+    }
+    ChargedInput(hbin);
+  }
+
+  template <class Input> void NonSMBRInput(const Input &hbin) {
+    if (Changed(neutralNonSMBR, hbin.BR_hjinvisible, hbin.BR_hkhjhi,
+                hbin.BR_hjhiZ, hbin.BR_hjemu, hbin.BR_hjetau, hbin.BR_hjmutau,
+                hbin.BR_hjHpiW))
       HiggsBounds_neutral_input_nonSMBR(
           hbin.BR_hjinvisible.data(), hbin.BR_hkhjhi.data(),
           hbin.BR_hjhiZ.data(), hbin.BR_hjemu.data(), hbin.BR_hjetau.data(),
           hbin.BR_hjmutau.data(), hbin.BR_hjHpiW.data());
-    }
-    if (nHplus > 0) {
+  }
+
+  template <class Input> void ChargedInput(const Input &hbin) {
+    if (nHplus == 0)
+      return;
+    if (Changed(charged, hbin.Mhplus, hbin.GammaTotal_Hpj,
+                hbin.CS_ee_HpjHmj_ratio, hbin.BR_tWpb, hbin.BR_tHpjb,
+                hbin.BR_Hpjcs, hbin.BR_Hpjcb, hbin.BR_Hpjtaunu, hbin.BR_Hpjtb,
+                hbin.BR_HpjWZ, hbin.BR_HpjhiW))
       HiggsBounds_charged_input(
           hbin.Mhplus.data(), hbin.GammaTotal_Hpj.data(),
           hbin.CS_ee_HpjHmj_ratio.data(), hbin.BR_tWpb, hbin.BR_tHpjb.data(),
           hbin.BR_Hpjcs.data(), hbin.BR_Hpjcb.data(), hbin.BR_Hpjtaunu.data(),
           hbin.BR_Hpjtb.data(), hbin.BR_HpjWZ.data(), hbin.BR_HpjhiW.data());
+    if (Changed(chargedLHC13, hbin.LHC13_CS_Hpjtb, hbin.LHC13_CS_Hpjcb,
+                hbin.LHC13_CS_Hpjbjet, hbin.LHC13_CS_Hpjcjet,
+                hbin.LHC13_CS_Hpjjetjet, hbin.LHC13_CS_HpjW,
+                hbin.LHC13_CS_HpjZ, hbin.LHC13_CS_vbf_Hpj,
+                hbin.LHC13_CS_HpjHmj, hbin.LHC13_CS_Hpjhi))
       HiggsBounds_charged_input_hadr(
           LHC13, hbin.LHC13_CS_Hpjtb.data(), hbin.LHC13_CS_Hpjcb.data(),
           hbin.LHC13_CS_Hpjbjet.data(), hbin.LHC13_CS_Hpjcjet.data(),
           hbin.LHC13_CS_Hpjjetjet.data(), hbin.LHC13_CS_HpjW.data(),
           hbin.LHC13_CS_HpjZ.data(), hbin.LHC13_CS_vbf_Hpj.data(),
           hbin.LHC13_CS_HpjHmj.data(), hbin.LHC13_CS_Hpjhi.data());
-    }
   }
 };
 
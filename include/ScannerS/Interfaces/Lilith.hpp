@@ -0,0 +1,328 @@
+#pragma once
+
+#include "ScannerS/Tools/UniformSpline.hpp"
+#include <Eigen/Core>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <variant>
+#include <vector>
+
+/**
+ * @brief Native implementation of the Lilith Higgs signal strength
+ * likelihood.
+ *
+ * Reads the experimental input of the bundled [Lilith](
+ * https://github.com/sabinekraml/Lilith-2) (`Lilith3/data`) and evaluates the
+ * likelihood of `lilith/internal/computelikelihood.py` for given signal
+ * strengths without calling into Python.
+ */
+namespace ScannerS::Interfaces::Lilith {
+
+//! the production modes of the signal strengths
+enum class Production : std::size_t {
+  ggH,
+  VBF,
+  WH,
+  qqZH,
+  ggZH,
+  ttH,
+  tHq,
+  tHW,
+  bbH
+};
+constexpr std::size_t nProductions = 9; //!< number of production modes
+
+//! the decay modes of the signal strengths
+enum class Decay : std::size_t {
+  gammagamma,
+  ZZ,
+  WW,
+  bb,
+  tautau,
+  gg,
+  cc,
+  mumu,
+  Zgamma,
+  invisible
+};
+constexpr std::size_t nDecays = 10; //!< number of decay modes
+
+//! the collider energies with separate signal strengths
+enum class Energy : std::size_t {
+  run1, //!< Tevatron and the 7 and 8 TeV LHC
+  lhc13 //!< 13 TeV LHC
+};
+constexpr std::size_t nEnergies = 2; //!< number of collider energies
+
+/**
+ * @brief Signal strengths \f$ \mu = \sigma\times\mathrm{BR} /
+ * (\sigma\times\mathrm{BR})_\mathrm{SM} \f$ for all production and decay
+ * modes.
+ *
+ * For invisible decays the signal strength is \f$ \sigma/\sigma_\mathrm{SM}
+ * \times\mathrm{BR}(h\to\mathrm{inv.}) \f$. Lilith expects the sum over all
+ * scalars that contribute to the observed signal.
+ */
+struct SignalStrengths {
+  //! the signal strengths, see Index()
+  std::array<double, nEnergies * nProductions * nDecays> mu{};
+
+  //! position of a signal strength in #mu
+  static constexpr std::size_t Index(Production prod, Decay decay,
+                                     Energy energy) noexcept {
+    return (static_cast<std::size_t>(energy) * nProductions +
+            static_cast<std::size_t>(prod)) *
+               nDecays +
+           static_cast<std::size_t>(decay);
+  }
+
+  //! access a signal strength
+  double &operator()(Production prod, Decay decay, Energy energy) noexcept {
+    return mu[Index(prod, decay, energy)];
+  }
+  //! access a signal strength
+  double operator()(Production prod, Decay decay,
+                    Energy energy) const noexcept {
+    return mu[Index(prod, decay, energy)];
+  }
+
+  //! set a signal strength at all collider energies
+  void Set(Production prod, Decay decay, double value) noexcept;
+
+  //! the SM values of Lilith, one for all visible and zero for invisible decays
+  static SignalStrengths SMLike() noexcept;
+
+  //! add the signal strengths of another scalar
+  SignalStrengths &operator+=(const SignalStrengths &other) noexcept;
+};
+
+//! Gaussian likelihood with asymmetric uncertainties, Lilith type `n`
+struct Normal1D {
+  double left;  //!< uncertainty below the best fit
+  double right; //!< uncertainty above the best fit
+};
+
+//! two dimensional Gaussian likelihood, Lilith type `n`
+struct Normal2D {
+  double a; //!< coefficient of \f$ \Delta x^2 \f$
+  double b; //!< coefficient of \f$ 2\Delta x\Delta y \f$
+  double c; //!< coefficient of \f$ \Delta y^2 \f$
+};
+
+//! multi-dimensional Gaussian likelihood, Lilith type `n`
+struct NormalND {
+  Eigen::MatrixXd invCov; //!< inverse covariance matrix
+};
+
+//! variable Gaussian of Barlow (physics/0406120, Eq. 18), Lilith type `vn`
+struct VarNormal1D {
+  double left;  //!< absolute value of the uncertainty below the best fit
+  double right; //!< uncertainty above the best fit
+};
+
+//! two dimensional variable Gaussian, Lilith type `vn`
+struct VarNormal2D {
+  std::array<double, 2> left;  //!< absolute values of the lower uncertainties
+  std::array<double, 2> right; //!< upper uncertainties
+  double corr;                 //!< correlation
+};
+
+/**
+ * @brief Multi-dimensional variable Gaussian, Lilith type `vn`.
+ *
+ * The covariance matrix \f$ C_{ij} = s_i \rho_{ij} s_j \f$ with \f$ s_i^2 =
+ * V_i + V'_i\Delta_i \f$ depends on the deviations \f$ \Delta_i \f$ from the
+ * best fit. Since \f$ \Delta^T C^{-1} \Delta = u^T \rho^{-1} u \f$ with
+ * \f$ u_i = \Delta_i / s_i \f$, only the constant correlation matrix has to be
+ * inverted.
+ */
+struct VarNormalND {
+  Eigen::VectorXd v;       //!< \f$ V_i = \sigma^+_i|\sigma^-_i| \f$
+  Eigen::VectorXd vPrime;  //!< \f$ V'_i = \sigma^+_i-|\sigma^-_i| \f$
+  Eigen::MatrixXd invCorr; //!< inverse correlation matrix
+};
+
+//! generalized Poisson of Barlow (physics/0406120, Eq. 10a), Lilith type `p`
+struct Poisson1D {
+  double gamma; //!< the solution of the bifurcation equation
+  double nu;    //!< \f$ \nu \f$
+};
+
+//! two dimensional correlated generalized Poisson, Lilith type `p`
+struct Poisson2D {
+  std::array<double, 2> gamma; //!< the solutions of the bifurcation equation
+  std::array<double, 2> nu;    //!< \f$ \nu \f$ of each axis
+  double aCorr;                //!< the correlation parameter \f$ A \f$
+};
+
+//! tabulated \f$ -2\log L \f$, Lilith type `f`
+struct Full1D {
+  Tools::UniformSpline spline; //!< not-a-knot spline of the grid
+};
+
+//! tabulated two dimensional \f$ -2\log L \f$, Lilith type `f`
+struct Full2D {
+  Tools::UniformSpline2D spline; //!< not-a-knot spline of the grid
+};
+
+//! one of the likelihood types
+using LikelihoodType =
+    std::variant<Normal1D, Normal2D, NormalND, VarNormal1D, VarNormal2D,
+                 VarNormalND, Poisson1D, Poisson2D, Full1D, Full2D>;
+
+//! efficiency-weighted signal strength measured along one axis
+struct Axis {
+  //! the efficiencies as pairs of SignalStrengths::Index() and efficiency
+  std::vector<std::pair<std::size_t, double>> efficiencies;
+  double bestfit = 0.; //!< the best fit value, zero for type `f`
+
+  //! the efficiency-weighted signal strength
+  double Mu(const SignalStrengths &mu) const noexcept {
+    double result = 0.;
+    for (const auto &[index, eff] : efficiencies)
+      result += eff * mu.mu[index];
+    return result;
+  }
+};
+
+//! the input from one experimental input file
+struct Measurement {
+  std::string source;      //!< the file the measurement was read from
+  std::vector<Axis> axes;  //!< the measured signal strengths
+  LikelihoodType type;     //!< the likelihood
+  double mass = 125.;      //!< Higgs mass of the measurement
+  Energy energy;           //!< collider energy of the measurement
+
+  //! \f$ -2\log L \f$ of the measurement
+  double operator()(const SignalStrengths &mu) const;
+};
+
+//! the directory of the bundled Lilith, set at compile time
+std::string DefaultDir();
+
+/**
+ * @brief Read an experimental Lilith input file.
+ *
+ * The multi-particle production labels (`VVH`, `VH`, `ZH`, `tH`, `top`) are
+ * split into the individual production modes using the SM cross section
+ * ratios of Lilith at the mass of the measurement. Throws a
+ * `std::runtime_error` for invalid input.
+ *
+ * @param file path to the XML file
+ * @param lilithDir the Lilith directory that contains the cross section grids
+ * in `lilith/internal/Grids`
+ * @return Measurement the measurement
+ */
+Measurement ReadMeasurement(const std::string &file,
+                            const std::string &lilithDir = DefaultDir());
+
+/**
+ * @brief The Lilith likelihood for a set of experimental input files.
+ *
+ * The input is only read on construction, all member functions are const and
+ * can be called concurrently from any number of threads.
+ *
+ * The likelihood for measurements at 13 TeV uses the SignalStrengths for
+ * Energy::lhc13 of all production modes. The Python implementation only
+ * distinguishes the collider energy for ggH, VBF, tHq, tHW and ggZH and uses
+ * the same values for both energies when given signal strengths as input.
+ */
+class Likelihood {
+public:
+  //! construct from the given measurements
+  explicit Likelihood(std::vector<Measurement> measurements);
+
+  /**
+   * @brief Read all files of a Lilith `.list` file.
+   *
+   * Relative paths are relative to the directory of the list file, `#` starts
+   * a comment. The cross section grids are read from `lilithDir` (see
+   * ReadMeasurement()).
+   */
+  static Likelihood FromList(const std::string &listFile,
+                             const std::string &lilithDir = DefaultDir());
+
+  /**
+   * @brief Load a database written by WriteDatabase().
+   *
+   * Throws a `std::runtime_error` if the file is not a valid database of the
+   * current #databaseVersion.
+   */
+  static Likelihood FromDatabase(const std::string &file);
+
+  //! \f$ -2\log L \f$ summed over all measurements
+  double operator()(const SignalStrengths &mu) const;
+
+  //! \f$ -2\log L \f$ of each measurement
+  std::vector<double> Contributions(const SignalStrengths &mu) const;
+
+  //! the number of measured signal strengths
+  std::size_t NObservables() const noexcept;
+
+  //! the measurements
+  const std::vector<Measurement> &Measurements() const noexcept {
+    return measurements_;
+  }
+
+private:
+  std::vector<Measurement> measurements_;
+};
+
+//! version of the database format written by WriteDatabase()
+constexpr std::uint64_t databaseVersion = 1;
+
+/**
+ * @brief Write a binary database of the likelihood.
+ *
+ * The database contains the fully processed input (split multi-particle
+ * efficiencies, solved Poisson parameters, inverted covariance matrices and
+ * spline coefficients), such that loading it requires no parsing or numerics.
+ * It is read by Likelihood::FromDatabase() and by `lilith/internal/database.py`
+ * of the bundled Lilith.
+ *
+ * The file is a sequence of 64 bit words in native (little endian) byte order,
+ * each either an unsigned integer or a double. This allows to memory map it as
+ * a whole, all offsets below count words:
+ *  - the header: the characters `LILITHDB`, the #databaseVersion, the byte
+ *    order mark `0x0102030405060708`, the number of measurements `N` and the
+ *    `N + 1` offsets of the measurement records and the end of the file
+ *  - for each measurement: the type (the index in LikelihoodType), the
+ *    Energy, the mass, the number of axes, the length of Measurement::source in
+ *    bytes followed by its characters padded to a multiple of 8, then for each
+ *    axis the best fit, the number of efficiencies and the pairs of
+ *    SignalStrengths::Index() and efficiency, and finally the parameters of the
+ *    type in the order of their declaration. Matrices are stored row-major
+ *    without their dimension. Splines store the number of grid points, the grid
+ *    and their coefficients (ordered as Tools::UniformSpline::Coefficients or
+ *    Tools::UniformSpline2D::AllCoefficients()), two dimensional splines store
+ *    both grid sizes before the grids.
+ *
+ * @param likelihood the likelihood to store
+ * @param file the output path
+ */
+void WriteDatabase(const Likelihood &likelihood, const std::string &file);
+
+//! whether the file starts like a database written by WriteDatabase()
+bool IsDatabase(const std::string &file);
+
+//! the `latest.list` of the Lilith in `lilithDir`
+std::string DefaultList(const std::string &lilithDir = DefaultDir());
+
+/**
+ * @brief Shared Likelihood instances.
+ *
+ * Every input is only read once, on the first call with its path. Safe to call
+ * from multiple threads.
+ *
+ * @param input a Lilith `.list` file (see Likelihood::FromList()) or a
+ * database (see Likelihood::FromDatabase())
+ * @param lilithDir the Lilith directory that contains the cross section grids,
+ * only used for `.list` files
+ */
+const Likelihood &SharedLikelihood(const std::string &input = DefaultList(),
+                                   const std::string &lilithDir = DefaultDir());
+
+} // namespace ScannerS::Interfaces::Lilith
@@ -1,7 +1,9 @@
 #pragma once
 
+#include "ScannerS/Constraints/HiggsPreScreen.hpp"
 #include "ScannerS/DataMap.hpp"
 #include "ScannerS/Models/TwoHDM.hpp"
+#include "ScannerS/Tools/Surrogate.hpp"
 #include <Eigen/Core>
 #include <array>
 #include <complex>
@@ -19,6 +21,7 @@ template <size_t nHzero, size_t nHplus> class HiggsBoundsSignals;
 
 namespace Tools {
 class SushiTables;
+const SushiTables &SharedSushiTables();
 } // namespace Tools
 
 namespace Constraints::STUDetail {
@@ -103,6 +106,24 @@ public:
     double v;        //!< @copybrief AngleInput::v
   };
 
+  /**
+   * @brief Input parametrization in terms of the quartic couplings.
+   *
+   * Used to sample directly in the region allowed by Constraints::BFB and
+   * Constraints::Unitarity. The neutral masses and mixing angles are obtained
+   * by diagonalizing the neutral mass matrix in
+   * Tools::LambdaBasis::C2HDMInput(), which returns a corresponding
+   * AngleInput. \f$\Im(m_{12}^2)\f$ is fixed through the minimum conditions.
+   */
+  struct LambdaInput {
+    //! quartic couplings \f$\lambda_{1,2,3,4},\Re(\lambda_5),\Im(\lambda_5)\f$
+    std::array<double, 6> L;
+    double tbeta;    //!< @copybrief AngleInput::tbeta
+    double re_m12sq; //!< @copybrief AngleInput::re_m12sq
+    Yuk type;        //!< @copybrief AngleInput::type
+    double v;        //!< @copybrief AngleInput::v
+  };
+
   //! A C2HDM parameter point
   struct ParameterPoint {
     //! mass-ordered neutral Higgs masses \f$m_{H_{1,2,3}}\f$ in GeV
@@ -147,6 +168,13 @@ public:
     std::string ToString() const;
   };
 
+  //! numeric features of a parameter point for Tools::Surrogate
+  static void SurrogateFeatures(const ParameterPoint &p,
+                                std::vector<double> &features) {
+    Tools::AssignFeatures(features, p.mHi, p.mHp, p.tbeta, p.R, p.alpha, p.L,
+                          p.m12sq, p.m11sq, p.m22sq, p.type, p.v, p.data);
+  }
+
   /**
    * @brief Checks if the generation in the ParameterPoint constructor was
    * successful, **ALWAYS CALL THIS**.
@@ -241,6 +269,22 @@ public:
    */
   static void CalcCouplings(ParameterPoint &p);
 
+  //! the neutral scalar masses in the order of #namesHzero, used by
+  //! Constraints::HiggsPreScreen
+  static std::array<double, nHzero> MassesHzero(const ParameterPoint &p) {
+    return p.mHi;
+  }
+
+  //! the Lilith signal strengths summed over the neutral scalars close to
+  //! 125 GeV for Constraints::Lilith, see
+  //! Constraints::HiggsPreScreenDetail::TotalMu(). **Requires CalcCouplings to
+  //! be called beforehand.**
+  static Interfaces::Lilith::SignalStrengths
+  LilithSignalStrengths(const ParameterPoint &p,
+                        const Tools::LilithCouplings &lc) {
+    return Constraints::HiggsPreScreenDetail::TotalMu<C2HDM>(lc, p);
+  }
+
   /**
    * @brief Calculate and store some LHC production cross sections
    *
@@ -301,7 +345,8 @@ public:
   static std::vector<double> BsmptInput(const ParameterPoint &p);
 
 private:
-  static const Tools::SushiTables cxnH0_;
+  static inline const Tools::SushiTables &cxnH0_ =
+      Tools::SharedSushiTables();
 };
 } // namespace Models
 } // namespace ScannerS
@@ -2,6 +2,7 @@
 
 #include "ScannerS/DataMap.hpp"
 #include "ScannerS/Models/N2HDM.hpp"
+#include "ScannerS/Tools/Surrogate.hpp"
 #include <Eigen/Core>
 #include <array>
 #include <complex>
@@ -113,6 +114,13 @@ public:
     std::string ToString() const;
   };
 
+  //! numeric features of a parameter point for Tools::Surrogate
+  static void SurrogateFeatures(const ParameterPoint &p,
+                                std::vector<double> &features) {
+    Tools::AssignFeatures(features, p.mHsm, p.mHi, p.mHp, p.R, p.L, p.A,
+                          p.m11sq, p.m22sq, p.mssq, p.v, p.alpha, p.data);
+  }
+
   /**
    * @brief Checks if the generation in the ParameterPoint constructor was
    * successful, **ALWAYS CALL THIS**.
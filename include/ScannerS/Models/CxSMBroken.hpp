@@ -2,10 +2,12 @@
 
 #include "ScannerS/DataMap.hpp"
 #include "ScannerS/Models/CxSM.hpp"
+#include "ScannerS/Tools/Surrogate.hpp"
 #include <Eigen/Core>
 #include <array>
 #include <cstddef>
 #include <string>
+#include <vector>
 
 namespace ScannerS {
 
@@ -20,6 +22,7 @@ struct STUParameters;
 
 namespace Tools {
 class SushiTables;
+const SushiTables &SharedSushiTables();
 }
 
 namespace Models {
@@ -98,6 +101,13 @@ public:
     std::string ToString() const;
   };
 
+  //! numeric features of a parameter point for Tools::Surrogate
+  static void SurrogateFeatures(const ParameterPoint &p,
+                                std::vector<double> &features) {
+    Tools::AssignFeatures(features, p.mHi, p.R, p.alpha, p.v, p.vs, p.va, p.L,
+                          p.a1, p.msq, p.b1, p.b2, p.data);
+  }
+
   /**
    * @brief Checks if the generation in the ParameterPoint constructor was
    * successful, **ALWAYS CALL THIS**.
@@ -171,7 +181,8 @@ public:
   static std::vector<double> BsmptInput(const ParameterPoint &p);
 
 private:
-  static const Tools::SushiTables cxnH0_;
+  static inline const Tools::SushiTables &cxnH0_ =
+      Tools::SharedSushiTables();
 };
 } // namespace Models
 } // namespace ScannerS
@@ -2,6 +2,7 @@
 
 #include "ScannerS/DataMap.hpp"
 #include "ScannerS/Models/CxSM.hpp"
+#include "ScannerS/Tools/Surrogate.hpp"
 #include <array>
 #include <cstddef>
 #include <map>
@@ -18,6 +19,7 @@ template <size_t nHneut, size_t nHplus> class HiggsBoundsSignals;
 
 namespace Tools {
 class SushiTables;
+const SushiTables &SharedSushiTables();
 }
 
 namespace Constraints::STUDetail {
@@ -95,6 +97,13 @@ public:
     std::string ToString() const;
   };
 
+  //! numeric features of a parameter point for Tools::Surrogate
+  static void SurrogateFeatures(const ParameterPoint &p,
+                                std::vector<double> &features) {
+    Tools::AssignFeatures(features, p.mHl, p.mHh, p.mHX, p.alpha, p.v, p.vs,
+                          p.L, p.msq, p.b1, p.b2, p.data);
+  }
+
   /**
    * @brief Model implementation for Constraints::STU
    * @param p the parameter point
@@ -174,7 +183,8 @@ public:
 private:
   static const std::array<std::string, 12> parNames_;
 
-  static const Tools::SushiTables cxnH0_;
+  static inline const Tools::SushiTables &cxnH0_ =
+      Tools::SharedSushiTables();
 };
 } // namespace Models
 } // namespace ScannerS
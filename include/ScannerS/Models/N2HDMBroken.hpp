@@ -1,8 +1,10 @@
 #pragma once
 
+#include "ScannerS/Constraints/HiggsPreScreen.hpp"
 #include "ScannerS/DataMap.hpp"
 #include "ScannerS/Models/N2HDM.hpp"
 #include "ScannerS/Models/TwoHDM.hpp"
+#include "ScannerS/Tools/Surrogate.hpp"
 #include <Eigen/Core>
 #include <array>
 #include <cstddef>
@@ -16,6 +18,7 @@ struct STUParameters;
 
 namespace Tools {
 class SushiTables;
+const SushiTables &SharedSushiTables();
 } // namespace Tools
 
 namespace Interfaces {
@@ -159,6 +162,14 @@ public:
     std::string ToString() const;
   };
 
+  //! numeric features of a parameter point for Tools::Surrogate
+  static void SurrogateFeatures(const ParameterPoint &p,
+                                std::vector<double> &features) {
+    Tools::AssignFeatures(features, p.mHi, p.mA, p.mHp, p.tbeta, p.R, p.alpha,
+                          p.type, p.vs, p.v, p.m12sq, p.L, p.m11sq, p.m22sq,
+                          p.mssq, p.data);
+  }
+
   /**
    * @brief Checks if the generation in the ParameterPoint constructor was
    * successful, **ALWAYS CALL THIS**.
@@ -215,6 +226,22 @@ public:
    */
   static void CalcCouplings(ParameterPoint &p);
 
+  //! the neutral scalar masses in the order of #namesHzero, used by
+  //! Constraints::HiggsPreScreen
+  static std::array<double, nHzero> MassesHzero(const ParameterPoint &p) {
+    return {p.mA, p.mHi[0], p.mHi[1], p.mHi[2]};
+  }
+
+  //! the Lilith signal strengths summed over the neutral scalars close to
+  //! 125 GeV for Constraints::Lilith, see
+  //! Constraints::HiggsPreScreenDetail::TotalMu(). **Requires CalcCouplings to
+  //! be called beforehand.**
+  static Interfaces::Lilith::SignalStrengths
+  LilithSignalStrengths(const ParameterPoint &p,
+                        const Tools::LilithCouplings &lc) {
+    return Constraints::HiggsPreScreenDetail::TotalMu<N2HDMBroken>(lc, p);
+  }
+
   /**
    * @brief Calculate and store some LHC production cross sections
    *
@@ -265,7 +292,8 @@ public:
   static std::vector<double> BsmptInput(const ParameterPoint &p);
 
 private:
-  static const Tools::SushiTables cxnH0_;
+  static inline const Tools::SushiTables &cxnH0_ =
+      Tools::SharedSushiTables();
 };
 } // namespace Models
 } // namespace ScannerS
@@ -3,6 +3,7 @@
 #include "ScannerS/DataMap.hpp"
 #include "ScannerS/Interfaces/HiggsBoundsSignals.hpp"
 #include "ScannerS/Models/N2HDM.hpp"
+#include "ScannerS/Tools/Surrogate.hpp"
 #include <Eigen/Core>
 #include <array>
 #include <map>
@@ -13,6 +14,7 @@ namespace ScannerS {
 
 namespace Tools {
 class SushiTables;
+const SushiTables &SharedSushiTables();
 }
 
 namespace Constraints::STUDetail {
@@ -103,6 +105,13 @@ public:
     std::string ToString() const;
   };
 
+  //! numeric features of a parameter point for Tools::Surrogate
+  static void SurrogateFeatures(const ParameterPoint &p,
+                                std::vector<double> &features) {
+    Tools::AssignFeatures(features, p.mHi, p.mHD, p.mAD, p.mHDp, p.alpha, p.R,
+                          p.vs, p.v, p.L, p.m11sq, p.m22sq, p.mssq, p.data);
+  }
+
   /**
    * @brief Model implementation for Constraints::STU
    *
@@ -189,7 +198,8 @@ public:
   static constexpr auto micromegasModelName = "N2HDMDarkD";
 
 private:
-  static const Tools::SushiTables cxnH0_;
+  static inline const Tools::SushiTables &cxnH0_ =
+      Tools::SharedSushiTables();
 };
 } // namespace Models
 } // namespace ScannerS
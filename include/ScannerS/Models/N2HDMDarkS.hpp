@@ -4,6 +4,7 @@
 #include "ScannerS/Interfaces/HiggsBoundsSignals.hpp"
 #include "ScannerS/Models/N2HDM.hpp"
 #include "ScannerS/Models/TwoHDM.hpp"
+#include "ScannerS/Tools/Surrogate.hpp"
 #include <Eigen/Core>
 #include <array>
 #include <map>
@@ -17,6 +18,7 @@ struct STUParameters;
 
 namespace Tools {
 class SushiTables;
+const SushiTables &SharedSushiTables();
 } // namespace Tools
 
 namespace Models {
@@ -110,6 +112,14 @@ public:
     std::string ToString() const;
   };
 
+  //! numeric features of a parameter point for Tools::Surrogate
+  static void SurrogateFeatures(const ParameterPoint &p,
+                                std::vector<double> &features) {
+    Tools::AssignFeatures(features, p.mHi, p.mA, p.mHp, p.mHD, p.tbeta, p.alpha,
+                          p.R, p.type, p.v, p.m12sq, p.L, p.m11sq, p.m22sq,
+                          p.mssq, p.data);
+  }
+
   /**
    * @brief Model implementation for Constraints::STU
    *
@@ -203,7 +213,8 @@ public:
   static constexpr auto micromegasModelName = "N2HDMDarkS_T1";
 
 private:
-  static const Tools::SushiTables cxnH0_;
+  static inline const Tools::SushiTables &cxnH0_ =
+      Tools::SharedSushiTables();
 };
 } // namespace Models
 } // namespace ScannerS
@@ -3,6 +3,7 @@
 #include "ScannerS/DataMap.hpp"
 #include "ScannerS/Interfaces/HiggsBoundsSignals.hpp"
 #include "ScannerS/Models/N2HDM.hpp"
+#include "ScannerS/Tools/Surrogate.hpp"
 #include <array>
 #include <map>
 #include <string>
@@ -84,6 +85,13 @@ public:
     std::string ToString() const;
   };
 
+  //! numeric features of a parameter point for Tools::Surrogate
+  static void SurrogateFeatures(const ParameterPoint &p,
+                                std::vector<double> &features) {
+    Tools::AssignFeatures(features, p.mHsm, p.mHDD, p.mAD, p.mHDp, p.mHDS, p.L,
+                          p.m11sq, p.m22sq, p.mssq, p.v, p.data);
+  }
+
   /**
    * @brief Model implementation for Constraints::STU
    *
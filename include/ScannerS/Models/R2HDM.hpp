@@ -1,7 +1,9 @@
 #pragma once
 
+#include "ScannerS/Constraints/HiggsPreScreen.hpp"
 #include "ScannerS/DataMap.hpp"
 #include "ScannerS/Models/TwoHDM.hpp"
+#include "ScannerS/Tools/Surrogate.hpp"
 #include <array>
 #include <cstddef>
 #include <string>
@@ -15,11 +17,13 @@ template <size_t nHzero, size_t nHplus> class HiggsBoundsSignals;
 
 namespace Tools {
 class SushiTables;
+const SushiTables &SharedSushiTables();
 } // namespace Tools
 
 namespace Constraints::STUDetail {
 struct STUParameters;
-}
+template <int nd, int m, int n> struct FixedSTUParameters;
+} // namespace Constraints::STUDetail
 
 namespace Models {
 /**
@@ -77,6 +81,22 @@ public:
     double v;      //!< @copybrief AngleInput::v
   };
 
+  /**
+   * @brief Input parametrization in terms of the quartic couplings.
+   *
+   * Used to sample directly in the region allowed by Constraints::BFB and
+   * Constraints::Unitarity. The physical masses and the mixing angle are
+   * obtained through Tools::LambdaBasis::R2HDMInput(), which returns a
+   * corresponding AngleInput.
+   */
+  struct LambdaInput {
+    std::array<double, 5> L; //!< quartic couplings \f$\lambda_{1,2,3,4,5}\f$
+    double tbeta;            //!< @copybrief AngleInput::tbeta
+    double m12sq;            //!< @copybrief AngleInput::m12sq
+    Yuk type;                //!< @copybrief AngleInput::type
+    double v;                //!< @copybrief AngleInput::v
+  };
+
   //! A R2HDM parameter point
   struct ParameterPoint {
     //! light neutral CP-even Higgs mass \f$m_h\f$ in GeV
@@ -120,6 +140,81 @@ public:
     std::string ToString() const;
   };
 
+  //! numeric features of a parameter point for Tools::Surrogate
+  static void SurrogateFeatures(const ParameterPoint &p,
+                                std::vector<double> &features) {
+    Tools::AssignFeatures(features, p.mHl, p.mHh, p.mA, p.mHp, p.tbeta, p.m12sq,
+                          p.alpha, p.L, p.m11sq, p.m22sq, p.type, p.v, p.data);
+  }
+
+  /**
+   * @brief Converts PhysicalInput to the equivalent AngleInput.
+   *
+   * The input mixing angle is obtained as \f$ \alpha^\mathrm{in} = \beta -
+   * \arcsin c(H_b VV) \f$.
+   */
+  static AngleInput ToAngleInput(const PhysicalInput &in);
+
+  //! quartic couplings and mass terms of the scalar potential
+  struct Potential {
+    std::array<double, 5> L; //!< @copybrief ParameterPoint::L
+    double m11sq;            //!< @copybrief ParameterPoint::m11sq
+    double m22sq;            //!< @copybrief ParameterPoint::m22sq
+  };
+
+  /**
+   * @brief The potential parameters in terms of the physical parameters.
+   *
+   * Implements the relations of the ParameterPoint constructor from
+   * AngleInput for already ordered CP-even states, see FillBatch().
+   *
+   * @param mHl the light CP-even mass
+   * @param mHh the heavy CP-even mass
+   * @param mA the CP-odd mass
+   * @param mHp the charged mass
+   * @param alpha the mixing angle with \f$ -\pi/2 \leq \alpha < \pi/2 \f$
+   * @param tbeta \f$\tan\beta\f$
+   * @param m12sq \f$m_{12}^2\f$
+   * @param v the EW vev
+   * @return Potential the potential parameters
+   */
+  static Potential PotentialParameters(double mHl, double mHh, double mA,
+                                       double mHp, double alpha, double tbeta,
+                                       double m12sq, double v);
+
+  //! The parameters of many points stored as structure-of-arrays, see
+  //! Tools::PointBatch. The members correspond to those of ParameterPoint.
+  struct BatchColumns {
+    std::vector<double> mHl;              //!< @copybrief ParameterPoint::mHl
+    std::vector<double> mHh;              //!< @copybrief ParameterPoint::mHh
+    std::vector<double> mA;               //!< @copybrief ParameterPoint::mA
+    std::vector<double> mHp;              //!< @copybrief ParameterPoint::mHp
+    std::vector<double> tbeta;            //!< @copybrief ParameterPoint::tbeta
+    std::vector<double> m12sq;            //!< @copybrief ParameterPoint::m12sq
+    std::vector<double> alpha;            //!< @copybrief ParameterPoint::alpha
+    std::array<std::vector<double>, 5> L; //!< @copybrief ParameterPoint::L
+    std::vector<double> m11sq;            //!< @copybrief ParameterPoint::m11sq
+    std::vector<double> m22sq;            //!< @copybrief ParameterPoint::m22sq
+    std::vector<Yuk> type;                //!< @copybrief ParameterPoint::type
+    std::vector<double> v;                //!< @copybrief ParameterPoint::v
+
+    //! the quartic couplings of the i-th point
+    std::array<double, 5> LAt(size_t i) const {
+      return {L[0][i], L[1][i], L[2][i], L[3][i], L[4][i]};
+    }
+  };
+
+  /**
+   * @brief Batched version of the ParameterPoint constructor from AngleInput.
+   *
+   * Orders the CP-even states and calculates the quartic couplings and mass
+   * parameters for all inputs using PotentialParameters().
+   *
+   * @param in the inputs
+   * @param cols the columns, resized to the number of inputs
+   */
+  static void FillBatch(const std::vector<AngleInput> &in, BatchColumns &cols);
+
   /**
    * @brief Model implementation for Constraints::BFB
    *
@@ -159,6 +254,17 @@ public:
   static Constraints::STUDetail::STUParameters
   STUInput(const ParameterPoint &p);
 
+  /**
+   * @brief Model implementation for Constraints::STU on the columns of a
+   * Tools::PointBatch
+   * @param cols the parameter columns
+   * @param i the index of the point
+   * @return Constraints::STUDetail::FixedSTUParameters<2, 4, 2> input
+   * parameters for the STU calculation
+   */
+  static Constraints::STUDetail::FixedSTUParameters<2, 4, 2>
+  STUInput(const BatchColumns &cols, size_t i);
+
   /**
    * @brief Model implementation for Constraints::STU
    * @param p the parameter point
@@ -191,6 +297,22 @@ public:
    */
   static void CalcCouplings(ParameterPoint &p);
 
+  //! the neutral scalar masses in the order of #namesHzero, used by
+  //! Constraints::HiggsPreScreen
+  static std::array<double, nHzero> MassesHzero(const ParameterPoint &p) {
+    return {p.mHl, p.mHh, p.mA};
+  }
+
+  //! the Lilith signal strengths summed over the neutral scalars close to
+  //! 125 GeV for Constraints::Lilith, see
+  //! Constraints::HiggsPreScreenDetail::TotalMu(). **Requires CalcCouplings to
+  //! be called beforehand.**
+  static Interfaces::Lilith::SignalStrengths
+  LilithSignalStrengths(const ParameterPoint &p,
+                        const Tools::LilithCouplings &lc) {
+    return Constraints::HiggsPreScreenDetail::TotalMu<R2HDM>(lc, p);
+  }
+
   /**
    * @brief Calculate and store some LHC production cross sections
    *
@@ -234,7 +356,8 @@ public:
   static std::vector<double> BsmptInput(const ParameterPoint &p);
 
 private:
-  static const Tools::SushiTables cxnH0_;
+  static inline const Tools::SushiTables &cxnH0_ =
+      Tools::SharedSushiTables();
 };
 } // namespace Models
 } // namespace ScannerS
@@ -2,10 +2,12 @@
 
 #include "ScannerS/DataMap.hpp"
 #include "ScannerS/Models/TRSM.hpp"
+#include "ScannerS/Tools/Surrogate.hpp"
 #include <Eigen/Core>
 #include <array>
 #include <cstddef>
 #include <string>
+#include <vector>
 
 namespace ScannerS {
 namespace Interfaces {
@@ -100,6 +102,13 @@ public:
     std::string ToString() const;
   };
 
+  //! numeric features of a parameter point for Tools::Surrogate
+  static void SurrogateFeatures(const ParameterPoint &p,
+                                std::vector<double> &features) {
+    Tools::AssignFeatures(features, p.mHi, p.R, p.theta, p.v, p.vs, p.vx, p.L,
+                          p.muHsq, p.muSsq, p.muXsq, p.data);
+  }
+
   /**
    * @brief Model implementation for Constraints::STU
    *
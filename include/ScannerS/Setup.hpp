@@ -1,14 +1,19 @@
 #pragma once
 
 #include "ScannerS/Constraints/Constraint.hpp"
+#include "ScannerS/DataMap.hpp"
 #include "ScannerS/Output.hpp"
 #include "ScannerS/Tools/CLI11.hpp" // IWYU pragma: export
 #include "ScannerS/Tools/ParameterReader.hpp"
+#include "ScannerS/Tools/Prior.hpp"
+#include "ScannerS/Tools/Surrogate.hpp"
 #include <cstddef>
+#include <limits>
 #include <map>
 #include <random>
 #include <string>
 #include <string_view>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -27,7 +32,9 @@ class ScannerSCMD {
   char **argv_;
 
   std::map<std::string, Constraints::Severity> severities_;
-  std::map<std::string, std::pair<double, double>> paramRanges_;
+  std::map<std::string, std::vector<std::string>> paramSpecs_;
+  std::map<std::string, Tools::Prior> priors_;
+  Tools::Surrogate::Settings surrogate_;
 
   std::string infile;
 
@@ -38,8 +45,13 @@ protected:
   //! constructor that sets a model description and the command line arguments
   ScannerSCMD(const std::string &description, int argc, char *argv[]);
 
-  //! register a severity for the named constraint
-  void ConstraintSeverity(const std::string &name);
+  //! get the prior for the named parameter, creating it on first use
+  Tools::Prior &GetPrior(const std::string &name, bool integer);
+
+  //! register a severity for the named constraint with the given default
+  void ConstraintSeverity(
+      const std::string &name,
+      Constraints::Severity defaultSeverity = Constraints::Severity::apply);
   //! return the severity of the names constraint
   Constraints::Severity Severe(const std::string &name) const;
 
@@ -49,23 +61,84 @@ protected:
 public:
   size_t npoints = 1; //!< number of scan points
   std::mt19937 rGen;  //!< the random number generator
+  //! \f$\Delta\chi^2\f$ margin of Constraints::HiggsPreScreen, has to be
+  //! given explicitly if the pre-screen is used
+  double preScreenMargin = std::numeric_limits<double>::quiet_NaN();
+  //! the Lilith directory that provides the grids and the experimental input
+  //! of Constraints::HiggsPreScreen, defaults to the bundled Lilith
+  std::string lilithDir;
+  //! maximal number of cached results of Constraints::Higgs, `0` disables
+  //! the cache
+  size_t higgsCacheSize = 0;
+  //! relative quantization of the Constraints::Higgs cache key
+  double higgsCacheQuantization = 0.;
+  //! HiggsBounds analyses used by Constraints::Higgs
+  std::string hbExperiments = "LandH";
 
-  //! adds the given input parameters to the command line arguments
+  /**
+   * @brief adds the given input parameters to the command line arguments
+   *
+   * Each parameter takes a prior specification as described in Tools::Prior,
+   * the simplest one being `min max` for a uniform distribution.
+   */
   void AddParameters(const std::vector<std::string> &parNames);
 
   //! get an integer distribution for the named parameter
-  std::uniform_int_distribution<int> GetIntParameter(const std::string &name);
+  Tools::ParameterDistribution<int> GetIntParameter(const std::string &name);
   //! get a floating point distribution for the named paramter
-  std::uniform_real_distribution<double>
+  Tools::ParameterDistribution<double>
   GetDoubleParameter(const std::string &name);
 
-  //! parses the command line arguments and config file
+  /**
+   * @brief Stores the Jacobian of the current parameter point.
+   *
+   * Stores the product of the Tools::Prior::Jacobian() of all drawn
+   * parameters as `jacobian` in the data. Weighting by it yields uniform
+   * distributions in the scan parameters. Nothing is stored if all priors are
+   * flat.
+   *
+   * @param data the data of the current parameter point
+   */
+  void StoreJacobian(DataMap &data) const;
+
+  //! StoreJacobian() for a point whose parameters were drawn earlier, with
+  //! the product of the Jacobians obtained from Jacobian() after its draws
+  void StoreJacobian(DataMap &data, double jacobian) const;
+
+  //! product of the Tools::Prior::Jacobian() of the last draws of all
+  //! parameters
+  double Jacobian() const;
+
+  //! get the configured surrogate classifier for the Higgs constraint
+  Tools::Surrogate GetSurrogate() const;
+
+  //! parses the command line arguments and config file, throws RunExit after
+  //! printing the help or an error message for invalid arguments
   RunMode Parse();
 
   //! returns a ParameterReader for the specified input file
   Tools::ParameterReader GetInput(std::vector<std::string> names);
 };
 
+//! @cond
+namespace Detail {
+//! whether the constraint C has individually configurable stages
+template <class C, class = void> struct HasStages : std::false_type {};
+template <class C>
+struct HasStages<C, std::void_t<decltype(C::stageIds)>> : std::true_type {};
+
+//! the default severity of the constraint C, Severity::apply unless C
+//! declares a different `defaultSeverity`
+template <class C, class = void> struct DefaultSeverity {
+  static constexpr auto value = Constraints::Severity::apply;
+};
+template <class C>
+struct DefaultSeverity<C, std::void_t<decltype(C::defaultSeverity)>> {
+  static constexpr auto value = C::defaultSeverity;
+};
+} // namespace Detail
+//! @endcond
+
 /**
  * @brief ScannerS setup handler
  *
@@ -81,9 +154,10 @@ public:
   ScannerSSetup(int argc, char *argv[])
       : ScannerSCMD(Model::description, argc, argv) {}
 
-  //! Register the constraint classes in Cs
+  //! Register the constraint classes in Cs, including the severities of
+  //! their stages (if any)
   template <template <class> class... Cs> void AddConstraints() {
-    (ConstraintSeverity(Cs<Model>::constraintId), ...);
+    (AddConstraint<Cs<Model>>(), ...);
   }
 
   /**
@@ -95,8 +169,16 @@ public:
    */
   template <template <class> class C, typename... Params>
   C<Model> GetConstraint(Params &&... params) const {
-    return C<Model>{Severe(C<Model>::constraintId),
-                    std::forward<Params>(params)...};
+    if constexpr (Detail::HasStages<C<Model>>::value) {
+      auto stages = typename C<Model>::StageSeverities{};
+      for (std::size_t i = 0; i != stages.size(); ++i)
+        stages[i] = Severe(C<Model>::stageIds[i]);
+      return C<Model>{Severe(C<Model>::constraintId), stages,
+                      std::forward<Params>(params)...};
+    } else {
+      return C<Model>{Severe(C<Model>::constraintId),
+                      std::forward<Params>(params)...};
+    }
   }
 
   //! get a configured output object
@@ -106,6 +188,14 @@ public:
   void PrintConfig(RunMode mode) const {
     ScannerSCMD::PrintConfig(mode, Model::description);
   }
+
+private:
+  template <class C> void AddConstraint() {
+    ConstraintSeverity(C::constraintId, Detail::DefaultSeverity<C>::value);
+    if constexpr (Detail::HasStages<C>::value)
+      for (const auto &id : C::stageIds)
+        ConstraintSeverity(id);
+  }
 };
 
 } // namespace ScannerS
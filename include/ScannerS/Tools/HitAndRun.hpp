@@ -0,0 +1,195 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace ScannerS::Tools {
+
+/**
+ * @brief Uniform sampling inside a region using the hit-and-run algorithm.
+ *
+ * The region is given through a membership test and has to be contained in
+ * the box `[lower, upper]`. Each call draws a random direction through the
+ * current point, finds the end points of the chord within the region by
+ * bisection and moves to a uniformly chosen point on this chord. The
+ * resulting Markov chain converges to the uniform distribution on the region,
+ * subsequent points are however correlated. Dimensions with `lower == upper`
+ * are kept fixed.
+ *
+ * For convex regions the chord is a single interval. This is the case eg for
+ * the intersection of the BFB and tree-level unitarity conditions in the space
+ * of quartic couplings of the 2HDM. Non-convex regions have to be flagged on
+ * construction, the new point is then drawn from the whole chord within the
+ * bounding box and rejected if it is outside of the region.
+ *
+ * @tparam dim dimension of the space
+ */
+template <size_t dim> class HitAndRun {
+public:
+  //! a point in the sampled space
+  using Point = std::array<double, dim>;
+  //! membership test for the sampled region
+  using Region = std::function<bool(const Point &)>;
+
+  /**
+   * @brief Construct a new sampler
+   *
+   * @param inside returns whether a point is inside the region
+   * @param lower lower corner of the bounding box
+   * @param upper upper corner of the bounding box
+   * @param maxStartTries maximal number of uniform draws in the bounding box
+   * that are used to find a starting point inside the region
+   * @param relTolerance relative precision (in units of the box size) of the
+   * chord end points
+   * @param convex whether the region is convex
+   */
+  HitAndRun(Region inside, const Point &lower, const Point &upper,
+            size_t maxStartTries = 1000000, double relTolerance = 1e-6,
+            bool convex = true)
+      : inside_{std::move(inside)}, lower_{lower}, upper_{upper},
+        maxStartTries_{maxStartTries}, relTolerance_{relTolerance},
+        convex_{convex} {
+    for (size_t i = 0; i != dim; ++i) {
+      if (!(lower_[i] <= upper_[i]))
+        throw(std::runtime_error("Invalid bounding box [" +
+                                 std::to_string(lower_[i]) + ", " +
+                                 std::to_string(upper_[i]) +
+                                 "] for sampling dimension " +
+                                 std::to_string(i)));
+      if (lower_[i] < upper_[i])
+        ++nFree_;
+    }
+  }
+
+  /**
+   * @brief Draw the next point.
+   *
+   * The first call searches for a starting point by uniform sampling in the
+   * bounding box and throws a `std::runtime_error` if none is found.
+   *
+   * @param rGen a random number generator
+   * @return Point a point inside the region
+   */
+  template <class RNG> Point operator()(RNG &rGen) {
+    if (!started_)
+      FindStart(rGen);
+    if (nFree_ == 0)
+      return current_;
+
+    const auto direction = RandomDirection(rGen);
+    // parameter range of the chord within the bounding box
+    double tMin = -std::numeric_limits<double>::infinity();
+    double tMax = std::numeric_limits<double>::infinity();
+    for (size_t i = 0; i != dim; ++i) {
+      if (direction[i] == 0.)
+        continue;
+      const double t1 = (lower_[i] - current_[i]) / direction[i];
+      const double t2 = (upper_[i] - current_[i]) / direction[i];
+      tMin = std::max(tMin, std::min(t1, t2));
+      tMax = std::min(tMax, std::max(t1, t2));
+    }
+    if (convex_) {
+      tMin = ChordEnd(direction, tMin);
+      tMax = ChordEnd(direction, tMax);
+    }
+
+    auto t = std::uniform_real_distribution<double>{tMin, tMax};
+    const size_t maxTries = convex_ ? maxChordTries : maxGeneralChordTries;
+    for (size_t i = 0; i != maxTries; ++i) {
+      const auto candidate = Along(direction, t(rGen));
+      if (inside_(candidate)) {
+        current_ = candidate;
+        return current_;
+      }
+    }
+    // no point found on the chord, stay at the current point
+    return current_;
+  }
+
+  //! number of uniform draws needed to find the starting point
+  size_t StartTries() const { return startTries_; }
+
+private:
+  static constexpr size_t maxChordTries = 100;
+  static constexpr size_t maxGeneralChordTries = 10000;
+
+  Region inside_;
+  const Point lower_;
+  const Point upper_;
+  const size_t maxStartTries_;
+  const double relTolerance_;
+  const bool convex_;
+
+  size_t nFree_ = 0;
+  Point current_;
+  bool started_ = false;
+  size_t startTries_ = 0;
+
+  template <class RNG> void FindStart(RNG &rGen) {
+    for (startTries_ = 1; startTries_ <= maxStartTries_; ++startTries_) {
+      for (size_t i = 0; i != dim; ++i)
+        current_[i] =
+            std::uniform_real_distribution<double>{lower_[i], upper_[i]}(rGen);
+      if (inside_(current_)) {
+        started_ = true;
+        return;
+      }
+    }
+    throw(std::runtime_error(
+        "HitAndRun could not find a point inside the region after " +
+        std::to_string(maxStartTries_) + " tries."));
+  }
+
+  template <class RNG> Point RandomDirection(RNG &rGen) const {
+    auto normal = std::normal_distribution<double>{};
+    Point dir;
+    double norm = 0;
+    while (norm == 0.) {
+      norm = 0;
+      for (size_t i = 0; i != dim; ++i) {
+        dir[i] = lower_[i] < upper_[i] ? normal(rGen) : 0.;
+        norm += dir[i] * dir[i];
+      }
+    }
+    norm = std::sqrt(norm);
+    for (auto &d : dir)
+      d /= norm;
+    return dir;
+  }
+
+  Point Along(const Point &direction, double t) const {
+    Point res;
+    for (size_t i = 0; i != dim; ++i)
+      res[i] = current_[i] + t * direction[i];
+    return res;
+  }
+
+  // bisection between the current point (t=0, inside) and tBox
+  double ChordEnd(const Point &direction, double tBox) const {
+    if (inside_(Along(direction, tBox)))
+      return tBox;
+    double scale = 0;
+    for (size_t i = 0; i != dim; ++i)
+      scale = std::max(scale, upper_[i] - lower_[i]);
+    double tIn = 0;
+    double tOut = tBox;
+    while (std::abs(tOut - tIn) > relTolerance_ * scale) {
+      const double tMid = 0.5 * (tIn + tOut);
+      if (inside_(Along(direction, tMid)))
+        tIn = tMid;
+      else
+        tOut = tMid;
+    }
+    return tIn;
+  }
+};
+
+} // namespace ScannerS::Tools
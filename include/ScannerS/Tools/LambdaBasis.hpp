@@ -0,0 +1,201 @@
+#pragma once
+
+#include "ScannerS/Constants.hpp"
+#include "ScannerS/Models/C2HDM.hpp"
+#include "ScannerS/Models/R2HDM.hpp"
+#include "ScannerS/Tools/HitAndRun.hpp"
+#include <array>
+#include <cstddef>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+
+namespace ScannerS::Tools {
+
+/**
+ * @brief Parametrization of 2HDMs in terms of the quartic couplings.
+ *
+ * In the basis of the quartic couplings \f$\lambda_i\f$, the conditions for
+ * boundedness from below and tree-level perturbative unitarity define a
+ * bounded, convex region. Sampling uniformly inside this region (using
+ * AllowedRegionSampler()) and mapping the resulting points to the physical
+ * masses and mixing angles (using R2HDMInput() or C2HDMInput()) avoids
+ * generating parameter points that are rejected by Constraints::BFB or
+ * Constraints::Unitarity.
+ */
+namespace LambdaBasis {
+
+/**
+ * @brief Hit-and-run sampler for the region allowed by BFB and unitarity.
+ *
+ * @tparam Model a model class with `Model::BFB(L)->bool` and
+ * `Model::MaxUnitarityEV(L)->double` functions for quartic couplings `L`
+ * @param lower lower bounds on the quartic couplings
+ * @param upper upper bounds on the quartic couplings
+ * @param unitarityLimit upper limit on the largest eigenvalue, see
+ * Constraints::Unitarity
+ * @return HitAndRun<nL> the sampler
+ */
+template <class Model, size_t nL>
+HitAndRun<nL> AllowedRegionSampler(const std::array<double, nL> &lower,
+                                   const std::array<double, nL> &upper,
+                                   double unitarityLimit = 8 * Constants::pi) {
+  return HitAndRun<nL>{
+      [unitarityLimit](const std::array<double, nL> &L) {
+        return Model::BFB(L) && Model::MaxUnitarityEV(L) < unitarityLimit;
+      },
+      lower, upper};
+}
+
+/**
+ * @brief Obtain the R2HDM masses and mixing angle from the quartic couplings.
+ *
+ * Uses the relations from sec. 5 of
+ * [1106.0034](https://arxiv.org/abs/1106.0034).
+ *
+ * @param in the input in the lambda basis
+ * @return std::optional<Models::R2HDM::AngleInput> the corresponding input in
+ * the mass basis, empty if any of the scalar masses is tachyonic
+ */
+std::optional<Models::R2HDM::AngleInput>
+R2HDMInput(const Models::R2HDM::LambdaInput &in);
+
+/**
+ * @brief Obtain the C2HDM masses and mixing angles from the quartic couplings.
+ *
+ * Diagonalizes the neutral mass matrix in the basis \f$(\rho_1, \rho_2,
+ * \rho_3)\f$ of [1711.09419](http://arxiv.org/abs/arXiv:1711.09419). The
+ * resulting mixing matrix is brought into Utilities::MixMatNormalForm3d().
+ *
+ * @param in the input in the lambda basis
+ * @return std::optional<Models::C2HDM::AngleInput> the corresponding input in
+ * the mass basis, empty if any of the scalar masses is tachyonic
+ */
+std::optional<Models::C2HDM::AngleInput>
+C2HDMInput(const Models::C2HDM::LambdaInput &in);
+
+/**
+ * @brief Solve for \f$\lambda_1\f$ such that a CP-even scalar has mass mh.
+ *
+ * \f$\lambda_1\f$ only enters the \f$(\rho_1,\rho_1)\f$ entry of the mass
+ * matrix, such that \f$\det(M^2 - m_h^2) = 0\f$ has a unique solution.
+ *
+ * @param in the input in the lambda basis, `in.L[0]` is ignored
+ * @param mh the required mass in GeV
+ * @return std::optional<Models::R2HDM::LambdaInput> the input with the solved
+ * `L[0]`, empty if there is no solution or any of the scalar masses is
+ * tachyonic
+ */
+std::optional<Models::R2HDM::LambdaInput>
+SolveL1(Models::R2HDM::LambdaInput in, double mh);
+
+/**
+ * @brief Solve for \f$\lambda_1\f$ such that a neutral scalar has mass mh.
+ *
+ * @copydetails SolveL1(Models::R2HDM::LambdaInput, double)
+ */
+std::optional<Models::C2HDM::LambdaInput>
+SolveL1(Models::C2HDM::LambdaInput in, double mh);
+
+/**
+ * @brief Hit-and-run sampler with one neutral scalar at a fixed mass.
+ *
+ * Samples \f$\lambda_{2,\ldots}\f$, \f$\tan\beta\f$ and \f$m_{12}^2\f$
+ * uniformly inside their bounding box and uses SolveL1() for
+ * \f$\lambda_1\f$. A point is inside the sampled region if the solved
+ * \f$\lambda_1\f$ is within its bounds, none of the masses are tachyonic and
+ * the couplings pass BFB and unitarity. This region is not convex in general.
+ *
+ * The sampler only uses the bounds of the parameters and ignores their
+ * priors. The resulting density in the scan parameters is not known in closed
+ * form, so no ScannerSCMD::StoreJacobian() weights exist for its points.
+ *
+ * @tparam Model Models::R2HDM or Models::C2HDM
+ */
+template <class Model> class FixedMassSampler {
+public:
+  //! number of quartic couplings
+  static constexpr size_t nL =
+      std::tuple_size_v<decltype(Model::LambdaInput::L)>;
+  //! bounds on the quartic couplings
+  using Bounds = std::array<double, nL>;
+
+  /**
+   * @brief Construct a new sampler.
+   *
+   * @param lower lower bounds on the quartic couplings
+   * @param upper upper bounds on the quartic couplings
+   * @param tbeta range of \f$\tan\beta\f$
+   * @param m12sq range of the (real part of) \f$m_{12}^2\f$
+   * @param mh the fixed mass in GeV, by default the observed Higgs mass
+   * @param unitarityLimit upper limit on the largest eigenvalue, see
+   * Constraints::Unitarity
+   */
+  FixedMassSampler(const Bounds &lower, const Bounds &upper,
+                   const std::array<double, 2> &tbeta,
+                   const std::array<double, 2> &m12sq,
+                   double mh = 125.09,
+                   double unitarityLimit = 8 * Constants::pi)
+      : sampler_{Inside(lower[0], upper[0], mh, unitarityLimit),
+                 Corner(lower, tbeta[0], m12sq[0]),
+                 Corner(upper, tbeta[1], m12sq[1]),
+                 1000000,
+                 1e-6,
+                 false},
+        mh_{mh} {}
+
+  /**
+   * @brief Draw the next point.
+   *
+   * @param rGen a random number generator
+   * @param type the Yukawa type of the point
+   * @return Model::LambdaInput the input with `L[0]` solved
+   */
+  template <class RNG>
+  typename Model::LambdaInput operator()(RNG &rGen, typename Model::Yuk type) {
+    auto in = *SolveL1(Input(sampler_(rGen)), mh_);
+    in.type = type;
+    return in;
+  }
+
+private:
+  using Point = std::array<double, nL + 1>;
+
+  HitAndRun<nL + 1> sampler_;
+  double mh_;
+
+  // (L2, ..., tbeta, m12sq) with L1 = 0
+  static typename Model::LambdaInput Input(const Point &x) {
+    typename Model::LambdaInput in{};
+    for (size_t i = 1; i != nL; ++i)
+      in.L[i] = x[i - 1];
+    in.tbeta = x[nL - 1];
+    if constexpr (std::is_same_v<Model, Models::C2HDM>)
+      in.re_m12sq = x[nL];
+    else
+      in.m12sq = x[nL];
+    in.v = Constants::vEW;
+    return in;
+  }
+
+  static Point Corner(const Bounds &L, double tbeta, double m12sq) {
+    Point res;
+    for (size_t i = 1; i != nL; ++i)
+      res[i - 1] = L[i];
+    res[nL - 1] = tbeta;
+    res[nL] = m12sq;
+    return res;
+  }
+
+  static typename HitAndRun<nL + 1>::Region
+  Inside(double minL1, double maxL1, double mh, double unitarityLimit) {
+    return [=](const Point &x) {
+      const auto in = SolveL1(Input(x), mh);
+      return in && in->L[0] >= minL1 && in->L[0] <= maxL1 &&
+             Model::BFB(in->L) && Model::MaxUnitarityEV(in->L) < unitarityLimit;
+    };
+  }
+};
+
+} // namespace LambdaBasis
+} // namespace ScannerS::Tools
@@ -0,0 +1,191 @@
+#pragma once
+
+#include "ScannerS/Interfaces/Lilith.hpp"
+#include "ScannerS/Tools/UniformSpline.hpp"
+#include <array>
+#include <cstddef>
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace ScannerS::Tools {
+
+/**
+ * @brief Lilith signal strengths from reduced couplings.
+ *
+ * Computes the Interfaces::Lilith::SignalStrengths of Higgs states from their
+ * reduced couplings like the bundled Lilith at `BEST-QCD` precision
+ * (`lilith/internal/computereducedcouplings.py` and
+ * `computemufromreducedcouplings.py`) without calling into Python. The grids of
+ * the SM branching ratios and of the form factors of the loop-induced
+ * couplings (`lilith/internal/Grids`) are read once on construction and
+ * interpolated with not-a-knot splines (see Tools::UniformSpline), which
+ * reproduces the splines of Lilith. The only exception are the VBF cross
+ * section grids that Lilith smooths instead of interpolating them. The
+ * computed VBF couplings for \f$ c_W \neq c_Z \f$ therefore differ from Lilith
+ * at the \f$ 10^{-5} \f$ level.
+ *
+ * All member functions are const and can be called concurrently from any
+ * number of threads. Use SharedLilithCouplings() instead of constructing new
+ * objects.
+ */
+class LilithCouplings {
+public:
+  //! the reduced couplings, ordered like `enum lilith_coupling` of the C API
+  enum class Coupling : std::size_t {
+    tt,
+    bb,
+    cc,
+    tautau,
+    mumu,
+    WW,
+    ZZ,
+    gammagamma,
+    Zgamma,
+    ggDecay,
+    ggProdLHC8,
+    ggProdLHC13,
+    VBF,
+    VBF13,
+    WH,
+    qqZH,
+    tHq,
+    tHq13,
+    tHW,
+    tHW13,
+    ggZH,
+    ggZH13
+  };
+  static constexpr std::size_t nCouplings = 22; //!< number of couplings
+  //! the couplings up to Coupling::ZZ are required, the others are computed
+  static constexpr std::size_t nRequired = 7;
+
+  static constexpr double minMass = 123.; //!< lowest mass of the grids
+  static constexpr double maxMass = 128.; //!< highest mass of the grids
+
+  /**
+   * @brief Mass and reduced couplings of a Higgs state.
+   *
+   * Couplings that are NaN are computed like in Lilith: WH from WW, qqZH from
+   * ZZ, VBF is WW if WW and ZZ agree and everything else from the couplings to
+   * the fermions and vector bosons.
+   */
+  struct Higgs {
+    //! the reduced couplings indexed by Coupling
+    std::array<double, nCouplings> c;
+    double m = 125.09;        //!< mass
+    double brInvisible = 0.;  //!< branching ratio into invisible states
+    double brUndetected = 0.; //!< branching ratio into undetected states
+
+    //! all couplings unset
+    Higgs() noexcept { c.fill(std::numeric_limits<double>::quiet_NaN()); }
+
+    //! a state with SM couplings to all fermions and vector bosons
+    static Higgs SMLike(double m = 125.09) noexcept;
+
+    //! access a coupling
+    double &operator()(Coupling coupling) noexcept {
+      return c[static_cast<std::size_t>(coupling)];
+    }
+    //! access a coupling
+    double operator()(Coupling coupling) const noexcept {
+      return c[static_cast<std::size_t>(coupling)];
+    }
+  };
+
+  /**
+   * @brief Read the grids of a Lilith installation.
+   *
+   * Throws a `std::runtime_error` if the grids cannot be read.
+   *
+   * @param lilithDir the Lilith directory, the grids are read from
+   * `lilith/internal/Grids` within it
+   */
+  explicit LilithCouplings(
+      const std::string &lilithDir = Interfaces::Lilith::DefaultDir());
+
+  /**
+   * @brief Compute all unset couplings.
+   *
+   * Throws a `std::runtime_error` if one of the required couplings is unset or
+   * the mass is outside of [#minMass, #maxMass].
+   */
+  Higgs Complete(const Higgs &higgs) const;
+
+  /**
+   * @brief Signal strengths of many Higgs states.
+   *
+   * Equivalent to Lilith with one input per Higgs state, but every grid
+   * interval is located only once per state and only the form factors of
+   * unset couplings are evaluated. Throws like Complete().
+   *
+   * @param higgs pointer to n Higgs states
+   * @param result pointer to storage for n results
+   * @param n number of Higgs states
+   */
+  void Mu(const Higgs *higgs, Interfaces::Lilith::SignalStrengths *result,
+          std::size_t n) const;
+
+  //! Mu() for a fixed number of Higgs states, eg `Model::nHzero`
+  template <std::size_t n>
+  std::array<Interfaces::Lilith::SignalStrengths, n>
+  Mu(const std::array<Higgs, n> &higgs) const {
+    std::array<Interfaces::Lilith::SignalStrengths, n> result;
+    Mu(higgs.data(), result.data(), n);
+    return result;
+  }
+
+  //! Mu() for any number of Higgs states
+  std::vector<Interfaces::Lilith::SignalStrengths>
+  Mu(const std::vector<Higgs> &higgs) const;
+
+  /**
+   * @brief Signal strengths summed over many Higgs states.
+   *
+   * This is the input of the Lilith likelihood (eg the return value of
+   * `Model::LilithSignalStrengths` for Constraints::Lilith) for Higgs states
+   * that all contribute to the observed signal.
+   *
+   * @param higgs pointer to n Higgs states
+   * @param n number of Higgs states
+   */
+  Interfaces::Lilith::SignalStrengths TotalMu(const Higgs *higgs,
+                                              std::size_t n) const;
+
+  //! TotalMu() for a fixed number of Higgs states
+  template <std::size_t n>
+  Interfaces::Lilith::SignalStrengths
+  TotalMu(const std::array<Higgs, n> &higgs) const {
+    return TotalMu(higgs.data(), n);
+  }
+
+  //! TotalMu() for any number of Higgs states
+  Interfaces::Lilith::SignalStrengths
+  TotalMu(const std::vector<Higgs> &higgs) const;
+
+private:
+  // not-a-knot splines of all columns of a grid file
+  struct Table {
+    UniformGrid grid;
+    std::vector<UniformSpline> columns;
+  };
+  // SM branching ratios in the order of the visible Interfaces::Lilith::Decay
+  Table brSM_;
+  // form factors of the loop-induced couplings, see LilithCouplings.cpp
+  Table gammagamma_, Zgamma_, ggDecay_;
+  Table ggProdLHC8_, ggProdLHC13_, VBF_, VBF13_;
+
+  // Complete() with the mass already checked
+  void CompleteChecked(Higgs &h) const;
+};
+
+/**
+ * @brief The LilithCouplings instances shared by all models.
+ *
+ * The grids of every directory are only read once, on the first call with it.
+ * Safe to call from multiple threads.
+ */
+const LilithCouplings &SharedLilithCouplings(
+    const std::string &lilithDir = Interfaces::Lilith::DefaultDir());
+
+} // namespace ScannerS::Tools
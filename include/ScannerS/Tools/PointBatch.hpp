@@ -0,0 +1,109 @@
+#pragma once
+
+#include <cstddef>
+#include <numeric>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace ScannerS::Tools {
+
+/**
+ * @brief Structure-of-arrays storage for a batch of parameter points.
+ *
+ * The parameters of all points in the batch are calculated at once and stored
+ * column-wise in a `Model::BatchColumns` object, such that cheap constraints
+ * can be evaluated for many candidates in tight loops over contiguous arrays.
+ * Candidates are removed through Filter() and full `Model::ParameterPoint`s
+ * are only materialized for the surviving candidates.
+ *
+ * ```
+ * auto batch = Tools::PointBatch<Model>{inputs};
+ * batch.Filter([](const auto &cols, size_t i) {
+ *   return Model::BFB(cols.LAt(i));
+ * });
+ * for (auto i : batch.Survivors()) {
+ *   auto p = batch.Materialize(i);
+ *   ...
+ * }
+ * ```
+ *
+ * @tparam Model a model class with a `Model::BatchColumns` type and a
+ * `Model::FillBatch(std::vector<Model::AngleInput>, Model::BatchColumns&)`
+ * function. Other input types are supported if the model provides a
+ * corresponding `Model::ToAngleInput(input)` conversion.
+ */
+template <class Model> class PointBatch {
+public:
+  using AngleInput = typename Model::AngleInput;      //!< input type
+  using ColumnStorage = typename Model::BatchColumns; //!< the column type
+  using Point = typename Model::ParameterPoint;       //!< the point type
+
+  //! empty batch
+  PointBatch() = default;
+
+  //! construct from a block of inputs
+  template <class In> explicit PointBatch(const std::vector<In> &inputs) {
+    Assign(inputs);
+  }
+
+  /**
+   * @brief Replaces the content of the batch.
+   *
+   * The storage of the batch is reused, such that a batch that is refilled
+   * with blocks of the same size does not allocate.
+   *
+   * @param inputs block of `Model::AngleInput` or any other input type with a
+   * corresponding `Model::ToAngleInput`
+   */
+  template <class In> void Assign(const std::vector<In> &inputs) {
+    if constexpr (std::is_same_v<In, AngleInput>) {
+      inputs_ = inputs;
+    } else {
+      inputs_.clear();
+      for (const auto &in : inputs)
+        inputs_.push_back(Model::ToAngleInput(in));
+    }
+    Model::FillBatch(inputs_, columns_);
+    survivors_.resize(inputs_.size());
+    std::iota(survivors_.begin(), survivors_.end(), size_t{0});
+  }
+
+  //! number of points in the batch, including the removed ones
+  size_t size() const noexcept { return inputs_.size(); }
+
+  //! the parameter columns
+  const ColumnStorage &Columns() const noexcept { return columns_; }
+
+  //! indices of the points that passed all filters so far, in ascending order
+  const std::vector<size_t> &Survivors() const noexcept { return survivors_; }
+
+  /**
+   * @brief Removes all points that do not pass the predicate.
+   *
+   * @param pred a callable `bool pred(const ColumnStorage &cols, size_t i)`
+   * for the point at index `i`
+   * @return size_t the number of remaining points
+   */
+  template <class Pred> size_t Filter(Pred &&pred) {
+    size_t nKept = 0;
+    for (auto i : survivors_)
+      if (pred(static_cast<const ColumnStorage &>(columns_), i))
+        survivors_[nKept++] = i;
+    survivors_.resize(nKept);
+    return nKept;
+  }
+
+  //! construct the full parameter point at index i
+  Point Materialize(size_t i) const { return Point{inputs_.at(i)}; }
+
+  //! the input of the point at index i
+  const AngleInput &Input(size_t i) const { return inputs_.at(i); }
+
+private:
+  std::vector<AngleInput> inputs_;
+  ColumnStorage columns_;
+  std::vector<size_t> survivors_;
+};
+
+} // namespace ScannerS::Tools
@@ -0,0 +1,179 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace ScannerS::Tools {
+
+/**
+ * @brief Sampling distribution of a single scan parameter.
+ *
+ * A prior is specified by a list of tokens, eg the value of a parameter in the
+ * `[scan]` section of the config file, of the form
+ *
+ *     [diff <reference> | ratio <reference>] [uniform | log | normal | set] values...
+ *
+ * where the distribution is one of
+ * - `min max` or `uniform min max`: uniform in [min, max]
+ * - `log min max`: uniform in the logarithm, requires `0 < min <= max`
+ * - `normal mean sigma`: gaussian with the given mean and width
+ * - `normal mean sigma min max`: gaussian truncated to [min, max]
+ * - `set v1 v2 ...`: each of the listed values with equal probability
+ *
+ * A leading `diff <reference>` (`ratio <reference>`) draws the difference
+ * (ratio) of the parameter to the named reference parameter from the given
+ * distribution instead of the parameter itself. The reference has to be drawn
+ * before the derived parameter for each parameter point.
+ *
+ * For every draw the Jacobian \f$ d\theta/du \f$ of the map from a uniform
+ * variable \f$ u\in[0,1] \f$ to the parameter \f$\theta\f$, ie the inverse of
+ * the sampling density, is recorded. Weighting parameter points by the
+ * product of these Jacobians recovers uniform distributions in all
+ * parameters. Fixed parameters (`min == max`) have unit Jacobian.
+ */
+class Prior {
+public:
+  //! shape of the sampling distribution
+  enum class Shape { uniform, logUniform, normal, discrete };
+  //! relation to the reference parameter
+  enum class Relation { none, difference, ratio };
+
+  /**
+   * @brief Construct a prior from its specification.
+   *
+   * Throws a `std::runtime_error` for invalid specifications.
+   *
+   * @param name the name of the parameter (for error messages)
+   * @param spec the specification, see the class documentation
+   * @param integer if the parameter only takes integer values, only uniform
+   * and set priors with integer values are allowed in this case
+   */
+  Prior(std::string name, const std::vector<std::string> &spec,
+        bool integer = false);
+
+  /**
+   * @brief Draw a value.
+   *
+   * For derived parameters SetReference() has to be called beforehand.
+   *
+   * @param rGen a random number generator
+   * @return double the value of the parameter
+   */
+  template <class RNG> double operator()(RNG &rGen) {
+    if (relation_ == Relation::none) {
+      value_ = DrawBase(rGen);
+      jacobian_ = BaseJacobian(value_);
+    } else {
+      CheckReference();
+      const double x = DrawBase(rGen);
+      const double ref = reference_->value_;
+      if (relation_ == Relation::difference) {
+        value_ = ref + x;
+        jacobian_ = BaseJacobian(x);
+      } else {
+        value_ = ref * x;
+        jacobian_ = std::abs(ref) * BaseJacobian(x);
+      }
+    }
+    ++draws_;
+    return value_;
+  }
+
+  //! the name of the reference parameter, empty if this is not a derived
+  //! parameter
+  const std::string &ReferenceName() const { return referenceName_; }
+  //! set the reference parameter of a derived parameter
+  void SetReference(const Prior &reference);
+
+  //! whether the parameter only takes integer values
+  bool Integer() const { return integer_; }
+
+  //! the Jacobian of the last draw
+  double Jacobian() const { return jacobian_; }
+  //! number of draws so far
+  size_t Draws() const { return draws_; }
+  //! whether the Jacobian is the same for all draws
+  bool Flat() const;
+
+  //! lower end of the sampled range, throws if the range is not bounded
+  double Min() const;
+  //! upper end of the sampled range, throws if the range is not bounded
+  double Max() const;
+
+private:
+  std::string name_;
+  bool integer_;
+  Shape shape_ = Shape::uniform;
+  Relation relation_ = Relation::none;
+  std::string referenceName_;
+  const Prior *reference_ = nullptr;
+  std::vector<double> par_;
+  double normalization_ = 1.;
+
+  double value_ = 0.;
+  double jacobian_ = 1.;
+  size_t draws_ = 0;
+
+  template <class RNG> double DrawBase(RNG &rGen) const {
+    switch (shape_) {
+    case Shape::uniform:
+      if (integer_)
+        return std::uniform_int_distribution<int>(static_cast<int>(par_[0]),
+                                                  static_cast<int>(par_[1]))(
+            rGen);
+      return std::uniform_real_distribution<double>(par_[0], par_[1])(rGen);
+    case Shape::logUniform:
+      return std::exp(std::uniform_real_distribution<double>(
+          std::log(par_[0]), std::log(par_[1]))(rGen));
+    case Shape::normal: {
+      auto dist = std::normal_distribution<double>(par_[0], par_[1]);
+      if (par_.size() == 2)
+        return dist(rGen);
+      double x;
+      do {
+        x = dist(rGen);
+      } while (x < par_[2] || x > par_[3]);
+      return x;
+    }
+    case Shape::discrete:
+      return par_[std::uniform_int_distribution<size_t>(0, par_.size() - 1)(
+          rGen)];
+    }
+    return 0.;
+  }
+
+  double BaseJacobian(double x) const;
+  void CheckReference() const;
+};
+
+/**
+ * @brief Distribution of a scan parameter as returned by
+ * ScannerSCMD::GetDoubleParameter() and ScannerSCMD::GetIntParameter().
+ *
+ * A lightweight handle to a Prior owned by the ScannerSCMD.
+ *
+ * @tparam T the type of the parameter values
+ */
+template <class T> class ParameterDistribution {
+public:
+  //! construct a handle to the given prior
+  explicit ParameterDistribution(Prior &prior) : prior_{&prior} {}
+
+  //! draw a value
+  template <class RNG> T operator()(RNG &rGen) {
+    return static_cast<T>((*prior_)(rGen));
+  }
+
+  //! lower end of the sampled range
+  double a() const { return prior_->Min(); }
+  //! upper end of the sampled range
+  double b() const { return prior_->Max(); }
+
+private:
+  Prior *prior_;
+};
+
+} // namespace ScannerS::Tools
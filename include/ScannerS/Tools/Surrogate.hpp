@@ -0,0 +1,210 @@
+#pragma once
+
+#include "ScannerS/DataMap.hpp"
+#include <Eigen/Core>
+#include <array>
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <iosfwd>
+#include <random>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace ScannerS::Tools {
+
+/**
+ * @brief Online surrogate classifier for expensive constraints.
+ *
+ * A k-nearest-neighbour classifier that is trained during the scan on the
+ * outcome of an expensive constraint (eg Constraints::Higgs together with the
+ * preceding `Model::RunHdecay`) and predicts whether a new parameter point
+ * will fail it. The features are obtained from
+ * `Model::SurrogateFeatures(p, features)` at the time of the prediction,
+ * usually the model parameters and any data stored so far (eg the couplings)
+ * collected with AssignFeatures(). They are standardized by their running mean
+ * and variance.
+ *
+ * Once at least `minTraining` outcomes have been recorded, points where a
+ * fraction of at least `confidence` of the `k` nearest neighbours failed are
+ * skipped. A random fraction `auditFraction` of these points is evaluated
+ * anyway to estimate the rate of falsely rejected points. A disabled
+ * surrogate evaluates every point and does not use the random number
+ * generator.
+ *
+ * Usage in a scan loop:
+ * ```
+ * if (!surrogate.Evaluate<Model>(p, rGen))
+ *   continue;
+ * Model::RunHdecay(p);
+ * if (surrogate.Record(higgs, p)) ...
+ * ```
+ */
+class Surrogate {
+public:
+  //! settings of the surrogate
+  struct Settings {
+    bool enabled = false;      //!< whether points can be skipped at all
+    double confidence = 0.95;  //!< minimal fraction of failing neighbours
+    double auditFraction = 0.05; //!< fraction of skipped points to evaluate
+    size_t k = 15;             //!< number of neighbours
+    size_t minTraining = 500;  //!< minimal number of training points
+    size_t maxTraining = 5000; //!< maximal number of stored training points
+  };
+
+  //! counters of the surrogate decisions
+  struct Statistics {
+    size_t evaluated = 0;       //!< number of recorded outcomes
+    size_t passed = 0;          //!< number of recorded passing outcomes
+    size_t skipped = 0;         //!< number of skipped points
+    size_t audited = 0;         //!< number of evaluated predicted failures
+    size_t falseRejections = 0; //!< number of audited points that passed
+  };
+
+  //! constructor, throws a `std::runtime_error` for invalid settings
+  explicit Surrogate(Settings settings);
+
+  /**
+   * @brief Decide whether the point should be evaluated.
+   *
+   * Every call that returns true has to be followed by a call to Record()
+   * before the next call.
+   *
+   * @tparam Model the model class providing `Model::SurrogateFeatures`
+   * @param p the parameter point
+   * @param rGen random number generator used for the audit decision
+   * @return true if the expensive constraint should be evaluated
+   * @return false if the point is predicted to fail and should be skipped
+   */
+  template <class Model, class RNG>
+  bool Evaluate(const typename Model::ParameterPoint &p, RNG &rGen) {
+    if (!settings_.enabled)
+      return true;
+    Model::SurrogateFeatures(p, current_);
+    return Decide([&rGen]() {
+      return std::uniform_real_distribution<double>{0., 1.}(rGen);
+    });
+  }
+
+  /**
+   * @brief Record the outcome of the point passed to the last Evaluate().
+   *
+   * @param passed whether the point passed the expensive constraint
+   * @return bool passed
+   */
+  bool Record(bool passed);
+
+  /**
+   * @brief Apply the expensive constraint to the point passed to the last
+   * Evaluate() and record its outcome.
+   *
+   * The recorded outcome is the result of the constraint before its severity
+   * is taken into account, so that an ignored constraint (which always passes)
+   * still trains the surrogate on its real results.
+   *
+   * @param constraint the constraint, eg Constraints::Higgs
+   * @param p the parameter point
+   * @return bool the result of `constraint(p)`
+   */
+  template <class Constraint, class Point>
+  bool Record(Constraint &constraint, Point &p) {
+    const bool result = constraint(p);
+    Record(constraint.LastResult());
+    return result;
+  }
+
+  //! the statistics of this surrogate
+  const Statistics &Stats() const { return stats_; }
+  //! estimated fraction of skipped points that would have passed
+  double FalseRejectionRate() const;
+
+  //! print a summary of the statistics to out, if the surrogate is enabled
+  void PrintStatistics(std::ostream &out) const;
+
+private:
+  template <class Audit> bool Decide(Audit &&audit) {
+    auditing_ = false;
+    if (PredictFail()) {
+      if (audit() >= settings_.auditFraction) {
+        ++stats_.skipped;
+        return false;
+      }
+      auditing_ = true;
+    }
+    return true;
+  }
+
+  bool PredictFail();
+  void Train(bool passed);
+
+  Settings settings_;
+  Statistics stats_;
+
+  std::vector<double> current_;
+  bool auditing_ = false;
+
+  // training data in a ring buffer
+  std::vector<std::vector<double>> features_;
+  std::vector<bool> labels_;
+  size_t next_ = 0;
+  // running mean and squared deviations of the features
+  std::vector<double> mean_;
+  std::vector<double> m2_;
+  size_t nMoments_ = 0;
+
+  // buffers reused by every prediction
+  std::vector<double> invSigma_;
+  std::vector<std::pair<double, bool>> neighbours_;
+};
+
+//! @cond
+namespace SurrogateDetail {
+inline void Append(std::vector<double> &features, double x) {
+  features.push_back(std::isfinite(x) ? x : 0.);
+}
+template <class Enum, class = std::enable_if_t<std::is_enum_v<Enum>>>
+void Append(std::vector<double> &features, Enum x) {
+  features.push_back(static_cast<double>(x));
+}
+inline void Append(std::vector<double> &features, std::complex<double> x) {
+  Append(features, x.real());
+  Append(features, x.imag());
+}
+template <size_t n>
+void Append(std::vector<double> &features, const std::array<double, n> &x) {
+  for (double xi : x)
+    Append(features, xi);
+}
+template <class Derived>
+void Append(std::vector<double> &features,
+            const Eigen::MatrixBase<Derived> &x) {
+  for (Eigen::Index i = 0; i != x.rows(); ++i)
+    for (Eigen::Index j = 0; j != x.cols(); ++j)
+      Append(features, x(i, j));
+}
+inline void Append(std::vector<double> &features, const DataMap &data) {
+  for (const auto &entry : data)
+    Append(features, entry.second);
+}
+} // namespace SurrogateDetail
+//! @endcond
+
+/**
+ * @brief Replace the features by the given values.
+ *
+ * Helper for `Model::SurrogateFeatures` (see Surrogate). Accepts numbers,
+ * enums, complex numbers, arrays, Eigen matrices (row by row) and DataMap%s
+ * (all values in alphabetical order of the keys). Non-finite values are
+ * replaced by zero. The storage of the features is reused.
+ *
+ * @param features the features to replace
+ * @param values the values
+ */
+template <class... Values>
+void AssignFeatures(std::vector<double> &features, const Values &...values) {
+  features.clear();
+  (SurrogateDetail::Append(features, values), ...);
+}
+
+} // namespace ScannerS::Tools
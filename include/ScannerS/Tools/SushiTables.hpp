@@ -1,6 +1,7 @@
 #pragma once
 
-#include "ScannerS/Tools/Spline.hpp"
+#include "ScannerS/Tools/UniformSpline.hpp"
+#include <array>
 
 namespace ScannerS {
 namespace Tools {
@@ -9,33 +10,28 @@ namespace Tools {
  * @brief Class to get interpolated cross sections from Sushi.
  *
  * Check the Info.md file in the data directory for more information about the
- * data.
+ * data. The cross sections are interpolated with cubic splines on the
+ * piecewise uniform mass grid of the tables (see Tools::UniformSpline).
  */
 class SushiTables {
-  tk::spline bbh_bbe_pp7, bbh_bbe_pp8, bbh_bbe_pp13, bbh_bbe_pp14;
-  tk::spline bbh_bbe_ppbar2;
-  tk::spline bbh_bbo_pp7, bbh_bbo_pp8, bbh_bbo_pp13, bbh_bbo_pp14;
-  tk::spline bbh_bbo_ppbar2;
-  tk::spline ggh_bbe_pp7, ggh_bbe_pp8, ggh_bbe_pp13, ggh_bbe_pp14;
-  tk::spline ggh_bbe_ppbar2;
-  tk::spline ggh_bbo_pp7, ggh_bbo_pp8, ggh_bbo_pp13, ggh_bbo_pp14;
-  tk::spline ggh_bbo_ppbar2;
-  tk::spline ggh_tte_pp7, ggh_tte_pp8, ggh_tte_pp13, ggh_tte_pp14;
-  tk::spline ggh_tte_ppbar2;
-  tk::spline ggh_tto_pp7, ggh_tto_pp8, ggh_tto_pp13, ggh_tto_pp14;
-  tk::spline ggh_tto_ppbar2;
-  tk::spline ggh_tbe_pp7, ggh_tbe_pp8, ggh_tbe_pp13, ggh_tbe_pp14;
-  tk::spline ggh_tbe_ppbar2;
-  tk::spline ggh_tbo_pp7, ggh_tbo_pp8, ggh_tbo_pp13, ggh_tbo_pp14;
-  tk::spline ggh_tbo_ppbar2;
+  // the contributions for one collider, see data/info.md
+  struct Splines {
+    UniformSpline bbh_bbe, bbh_bbo;
+    UniformSpline ggh_bbe, ggh_bbo;
+    UniformSpline ggh_tte, ggh_tto;
+    UniformSpline ggh_tbe, ggh_tbo;
+  };
+  UniformGrid grid_;
+  std::array<Splines, 5> splines_; // indexed by Collider
 
 public:
   /**
    * @brief Construct a new Sushi Tables object
    *
-   * This reads data from the ggH_bbH.dat file on disk. Uses the path where the
-   * data file was located upon compilation. (Exported to ScannerS/config.h by
-   * cmake.)
+   * Uses the spline coefficients of the ggH_bbH.dat file that are embedded
+   * into the library at build time (see SushiTablesData), such that no data
+   * files are needed at runtime. Use SharedSushiTables() instead of
+   * constructing new objects.
    */
   SushiTables();
 
@@ -113,5 +109,9 @@ public:
    */
   double BBo(double m, double cb, Collider coll) const;
 };
+
+//! The SushiTables instance shared by all models.
+const SushiTables &SharedSushiTables();
+
 } // namespace Tools
 } // namespace ScannerS
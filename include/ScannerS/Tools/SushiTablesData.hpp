@@ -0,0 +1,17 @@
+#pragma once
+
+#include "ScannerS/Tools/UniformSpline.hpp"
+#include <cstddef>
+
+//! The SusHi cross section tables embedded at build time.
+//!
+//! The definitions are generated from `data/ggH_bbH.dat` by the
+//! `EmbedSushiTables` tool when building ScannerS.
+namespace ScannerS::Tools::SushiTablesData {
+extern const std::size_t nPoints;  //!< number of points of the mass grid
+extern const std::size_t nSplines; //!< number of tabulated contributions
+extern const double masses[];      //!< the mass grid
+//! the spline coefficients, `nPoints + 1` for each contribution in the order
+//! of the data file (see UniformSpline::AllCoefficients())
+extern const UniformSpline::Coefficients coefficients[];
+} // namespace ScannerS::Tools::SushiTablesData
@@ -0,0 +1,252 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+namespace ScannerS::Tools {
+
+/**
+ * @brief A sorted grid that consists of a few uniformly spaced blocks.
+ *
+ * Tabulated data is usually given on grids with a constant step size, or with
+ * a handful of regions of different constant step sizes (like the 2.5, 5 and
+ * 25 GeV steps of the SusHi tables). Locating the grid interval of a value
+ * then only requires a division within the matching block instead of a
+ * binary search.
+ */
+class UniformGrid {
+public:
+  /**
+   * @brief The position of a value on the grid.
+   *
+   * Index 0 refers to the region below the grid, index `i > 0` to the
+   * interval starting at the grid point `i - 1`. The last grid point is also
+   * used for all values beyond the grid.
+   */
+  struct Location {
+    std::size_t index; //!< index of the interval
+    double h;          //!< distance to the start of the interval
+  };
+
+  //! empty grid
+  UniformGrid() = default;
+
+  /**
+   * @brief Construct a grid from the given points.
+   *
+   * Throws a `std::runtime_error` if there are less than two points or if
+   * they are not strictly increasing.
+   *
+   * @param x the grid points
+   */
+  explicit UniformGrid(std::vector<double> x);
+
+  //! locate x on the grid
+  Location Locate(double x) const noexcept {
+    if (!(x >= x_.front()))
+      return {0, x - x_.front()};
+    for (const auto &b : blocks_) {
+      if (x < b.end) {
+        auto i = b.first + static_cast<std::size_t>((x - b.x0) * b.invStep);
+        i = i < b.last ? i : b.last;
+        return {i + 1, x - x_[i]};
+      }
+    }
+    return {x_.size(), x - x_.back()};
+  }
+
+  //! the grid points
+  const std::vector<double> &Points() const noexcept { return x_; }
+
+  //! the number of uniformly spaced blocks
+  std::size_t NBlocks() const noexcept { return blocks_.size(); }
+
+private:
+  struct Block {
+    double x0;         // first point of the block
+    double end;        // last point of the block
+    double invStep;    // inverse step size
+    std::size_t first; // index of the first point
+    std::size_t last;  // index of the last interval
+  };
+  std::vector<double> x_;
+  std::vector<Block> blocks_;
+};
+
+/**
+ * @brief Cubic spline on a UniformGrid.
+ *
+ * The spline coefficients of every interval are stored next to each other,
+ * such that an evaluation accesses a single cache line after the O(1) grid
+ * lookup. By default, the interpolation is a natural cubic spline identical to
+ * the default `tk::spline` (Tools/Spline.hpp), including the quadratic and
+ * linear extrapolation below and above the grid.
+ */
+class UniformSpline {
+public:
+  //! boundary conditions of the interpolation
+  enum class Boundary {
+    //! natural spline like the default `tk::spline`
+    natural,
+    /**
+     * not-a-knot conditions, the cubic polynomials of the first and last
+     * intervals are also used for the extrapolation. This is the interpolating
+     * spline of FITPACK (eg `scipy.interpolate.UnivariateSpline` with `k=3` and
+     * `s=0`) and requires at least four points.
+     */
+    notAKnot
+  };
+
+  /**
+   * @brief Coefficients of the spline in one interval.
+   *
+   * The spline is \f$ ((a h + b) h + c) h + y \f$ with the distance \f$ h \f$
+   * to the start of the interval.
+   */
+  struct Coefficients {
+    double y; //!< value at the start of the interval
+    double c; //!< linear coefficient
+    double b; //!< quadratic coefficient
+    double a; //!< cubic coefficient
+  };
+
+  //! empty spline
+  UniformSpline() = default;
+
+  /**
+   * @brief Interpolate the given points.
+   *
+   * @param grid the grid of x-values
+   * @param y the y-values at the grid points
+   * @param boundary the boundary conditions
+   */
+  UniformSpline(UniformGrid grid, const std::vector<double> &y,
+                Boundary boundary = Boundary::natural);
+
+  /**
+   * @brief Construct from precomputed coefficients.
+   *
+   * @param grid the grid of x-values
+   * @param coefficients the coefficients for all UniformGrid::Location
+   * indices, ie the coefficients for the extrapolation below the grid followed
+   * by the coefficients at every grid point
+   */
+  UniformSpline(UniformGrid grid, std::vector<Coefficients> coefficients);
+
+  //! evaluate the spline
+  double operator()(double x) const noexcept {
+    return (*this)(grid_.Locate(x));
+  }
+
+  //! evaluate the spline at an already located position
+  double operator()(const UniformGrid::Location &loc) const noexcept {
+    const auto &co = coefficients_[loc.index];
+    return ((co.a * loc.h + co.b) * loc.h + co.c) * loc.h + co.y;
+  }
+
+  /**
+   * @brief Evaluate the spline for many values at once.
+   *
+   * @param x pointer to n x-values
+   * @param result pointer to storage for n results
+   * @param n the number of values
+   */
+  void Evaluate(const double *x, double *result, std::size_t n) const noexcept;
+
+  //! Evaluate the spline for all values in x.
+  std::vector<double> Evaluate(const std::vector<double> &x) const;
+
+  //! the grid
+  const UniformGrid &Grid() const noexcept { return grid_; }
+
+  //! the coefficients for all UniformGrid::Location indices
+  const std::vector<Coefficients> &AllCoefficients() const noexcept {
+    return coefficients_;
+  }
+
+private:
+  UniformGrid grid_;
+  std::vector<Coefficients> coefficients_;
+};
+
+/**
+ * @brief Tensor product cubic spline on two UniformGrid%s.
+ *
+ * Interpolates values on a rectangular grid with a UniformSpline in each
+ * direction. With not-a-knot boundary conditions this is the interpolating
+ * spline of FITPACK (eg `scipy.interpolate.RectBivariateSpline` with the
+ * default `s=0`). Like in FITPACK, points outside of the grid are moved to the
+ * closest edge of the grid.
+ */
+class UniformSpline2D {
+public:
+  /**
+   * @brief Coefficients of the spline in one cell.
+   *
+   * The spline is \f$ \sum_{k,l=0}^3 c_{kl} h_x^k h_y^l \f$ with the distances
+   * \f$ h_x, h_y \f$ to the corner of the cell and \f$ c_{kl} \f$ stored at
+   * index `4 * k + l`.
+   */
+  using Coefficients = std::array<double, 16>;
+
+  //! empty spline
+  UniformSpline2D() = default;
+
+  /**
+   * @brief Interpolate the given values.
+   *
+   * Throws a `std::runtime_error` if the number of values does not match the
+   * grids.
+   *
+   * @param x the grid in the first variable
+   * @param y the grid in the second variable
+   * @param z the values at the grid points, with `z[i * ny + j]` the value at
+   * `(x[i], y[j])`
+   * @param boundary the boundary conditions in both directions
+   */
+  UniformSpline2D(UniformGrid x, UniformGrid y, const std::vector<double> &z,
+                  UniformSpline::Boundary boundary =
+                      UniformSpline::Boundary::natural);
+
+  /**
+   * @brief Construct from precomputed coefficients.
+   *
+   * Throws a `std::runtime_error` if the number of coefficients does not match
+   * the grids.
+   *
+   * @param x the grid in the first variable
+   * @param y the grid in the second variable
+   * @param coefficients the coefficients as returned by AllCoefficients()
+   */
+  UniformSpline2D(UniformGrid x, UniformGrid y,
+                  std::vector<Coefficients> coefficients);
+
+  //! evaluate the spline
+  double operator()(double x, double y) const noexcept;
+
+  /**
+   * @brief The coefficients of all cells.
+   *
+   * The coefficients of the UniformGrid::Location indices `ix` and `iy` are
+   * at `ix * (ny + 1) + iy`, where `ny` is the number of points of the second
+   * grid.
+   */
+  const std::vector<Coefficients> &AllCoefficients() const noexcept {
+    return coefficients_;
+  }
+
+  //! the grid in the first variable
+  const UniformGrid &GridX() const noexcept { return x_; }
+  //! the grid in the second variable
+  const UniformGrid &GridY() const noexcept { return y_; }
+
+private:
+  UniformGrid x_;
+  UniformGrid y_;
+  // the coefficients of every cell as [x location][y location], including
+  // the extrapolation entries of the UniformGrid::Location indices
+  std::vector<Coefficients> coefficients_;
+};
+
+} // namespace ScannerS::Tools
@@ -0,0 +1,101 @@
+#include "ScannerS/Campaign.hpp"
+
+#include <cctype>
+#include <cstddef>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <utility>
+
+namespace ScannerS {
+
+std::vector<std::string> SplitArguments(const std::string &line) {
+  std::vector<std::string> args;
+  std::string current;
+  bool inArg = false;
+  bool quoted = false;
+  for (char c : line) {
+    if (c == '"') {
+      quoted = !quoted;
+      inArg = true;
+    } else if (!quoted && (c == '#' || c == ';')) {
+      break;
+    } else if (!quoted && std::isspace(static_cast<unsigned char>(c))) {
+      if (inArg)
+        args.push_back(current);
+      current.clear();
+      inArg = false;
+    } else {
+      current += c;
+      inArg = true;
+    }
+  }
+  if (quoted)
+    throw std::runtime_error("Unterminated quote in campaign entry: " + line);
+  if (inArg)
+    args.push_back(current);
+  return args;
+}
+
+std::vector<std::vector<std::string>>
+ReadCampaign(const std::string &filename) {
+  std::ifstream file{filename};
+  if (!file.good())
+    throw std::runtime_error("Could not open campaign file " + filename);
+  std::vector<std::vector<std::string>> runs;
+  std::string line;
+  while (std::getline(file, line))
+    if (auto args = SplitArguments(line); !args.empty())
+      runs.emplace_back(std::move(args));
+  if (runs.empty())
+    throw std::runtime_error("The campaign file " + filename +
+                             " does not contain any runs");
+  return runs;
+}
+
+int RunCampaign(int argc, char *argv[], const RunFunction &run) {
+  if (argc < 2 || std::string{argv[1]} != "campaign") {
+    try {
+      return run(argc, argv);
+    } catch (const RunExit &e) {
+      return e.Code();
+    }
+  }
+  if (argc != 3) {
+    std::cerr << "Usage: " << argv[0] << " campaign campaignfile" << std::endl;
+    return 1;
+  }
+
+  const auto runs = ReadCampaign(argv[2]);
+  size_t nFailed = 0;
+  for (size_t i = 0; i != runs.size(); ++i) {
+    auto args = std::vector<std::string>{argv[0]};
+    args.insert(args.end(), runs[i].begin(), runs[i].end());
+    auto cargs = std::vector<char *>{};
+    for (auto &a : args)
+      cargs.push_back(a.data());
+    cargs.push_back(nullptr);
+
+    std::cout << "\nCampaign run " << i + 1 << "/" << runs.size() << ":";
+    for (size_t j = 1; j != args.size(); ++j)
+      std::cout << " " << args[j];
+    std::cout << std::endl;
+    try {
+      if (run(static_cast<int>(args.size()), cargs.data()) != 0)
+        ++nFailed;
+    } catch (const RunExit &e) {
+      if (e.Code() != 0)
+        ++nFailed;
+    } catch (const std::exception &e) {
+      std::cerr << "Campaign run " << i + 1 << " failed: " << e.what()
+                << std::endl;
+      ++nFailed;
+    }
+  }
+  std::cout << "\nFinished campaign with " << runs.size() - nFailed << "/"
+            << runs.size() << " successful runs." << std::endl;
+  return nFailed == 0 ? 0 : 1;
+}
+
+} // namespace ScannerS
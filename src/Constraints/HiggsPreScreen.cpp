@@ -0,0 +1,69 @@
+#include "ScannerS/Constraints/HiggsPreScreen.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+namespace ScannerS::Constraints::HiggsPreScreenDetail {
+
+namespace {
+using Coupling = Tools::LilithCouplings::Coupling;
+
+// ratios of the squared LO CP-odd and CP-even top loop form factors at 125 GeV
+constexpr double ggOdd = 2.25;
+constexpr double gamgamOdd = 0.16;
+// suppression of ttH production through a CP-odd top coupling
+constexpr double ttHOdd = 0.4;
+
+double Quadrature(double even, double odd, double oddFactor = 1.) {
+  return std::sqrt(even * even + oddFactor * odd * odd);
+}
+} // namespace
+
+CouplingKeys::CouplingKeys(const std::string &name)
+    : VV_{"c_" + name + "VV"}, uu_e_{"c_" + name + "uu_e"},
+      uu_o_{"c_" + name + "uu_o"}, dd_e_{"c_" + name + "dd_e"},
+      dd_o_{"c_" + name + "dd_o"}, ll_e_{"c_" + name + "ll_e"},
+      ll_o_{"c_" + name + "ll_o"} {}
+
+Kappas CouplingKeys::Read(const DataMap &data) const {
+  const auto optional = [&data](const DataMap::Key &key) {
+    return data.Contains(key) ? data[key] : 0.;
+  };
+  return {data[VV_],       data[uu_e_], optional(uu_o_), data[dd_e_],
+          optional(dd_o_), data[ll_e_], optional(ll_o_)};
+}
+
+Tools::LilithCouplings::Higgs Couplings(const Tools::LilithCouplings &lc,
+                                        const Kappas &k, double mh) {
+  using Tools::LilithCouplings;
+  auto h = LilithCouplings::Higgs{};
+  h(Coupling::tt) = k.u_e;
+  h(Coupling::cc) = k.u_e;
+  h(Coupling::bb) = k.d_e;
+  h(Coupling::tautau) = k.l_e;
+  h(Coupling::mumu) = k.l_e;
+  h(Coupling::WW) = k.V;
+  h(Coupling::ZZ) = k.V;
+  h.m = std::clamp(mh, LilithCouplings::minMass, LilithCouplings::maxMass);
+  h = lc.Complete(h);
+
+  h(Coupling::tt) = Quadrature(k.u_e, k.u_o, ttHOdd);
+  h(Coupling::cc) = Quadrature(k.u_e, k.u_o);
+  h(Coupling::bb) = Quadrature(k.d_e, k.d_o);
+  h(Coupling::tautau) = Quadrature(k.l_e, k.l_o);
+  h(Coupling::mumu) = Quadrature(k.l_e, k.l_o);
+  for (auto c :
+       {Coupling::ggDecay, Coupling::ggProdLHC8, Coupling::ggProdLHC13})
+    h(c) = Quadrature(h(c), k.u_o, ggOdd);
+  h(Coupling::gammagamma) =
+      Quadrature(h(Coupling::gammagamma), k.u_o, gamgamOdd);
+  return h;
+}
+
+Interfaces::Lilith::SignalStrengths Mu(const Tools::LilithCouplings &lc,
+                                       const Kappas &k, double mh) {
+  return lc.TotalMu(std::array{Couplings(lc, k, mh)});
+}
+
+} // namespace ScannerS::Constraints::HiggsPreScreenDetail
@@ -1,6 +1,7 @@
 #include "ScannerS/Constraints/STU.hpp"
 
 #include <Eigen/LU>
+#include <algorithm>
 #include <cmath>
 
 double ScannerS::Constraints::STUDetail::Chisq(double S, double T, double U) {
@@ -85,3 +86,187 @@ double ScannerS::Constraints::STUDetail::G2(double I, double Q) {
          (12 - 4 * I / Q + pow(I / Q, 2)) * FuncF(I, pow(I, 2) - 4. * I * Q) /
              Q;
 }
+
+namespace {
+// Cephes implementation of atan with the same range reduction and rational
+// approximation as std::atan, written such that Eigen can vectorize it
+template <class Array> Array AtanImpl(const Array &x) {
+  constexpr double T3P8 = 2.41421356237309504880; // tan(3 pi/8)
+  constexpr double PIO2 = 1.57079632679489661923;  // pi/2
+  constexpr double PIO4 = 7.85398163397448309616E-1; // pi/4
+  constexpr double MOREBITS = 6.123233995736765886130E-17;
+  constexpr double P[] = {-8.750608600031904122785E-1,
+                          -1.615753718733365076637E1,
+                          -7.500855792314704667340E1,
+                          -1.228866684490136173410E2,
+                          -6.485021904942025371773E1};
+  constexpr double Q[] = {2.485846490142306297962E1, 1.650270098316988542046E2,
+                          4.328810604912902668951E2, 4.853903996359136964868E2,
+                          1.945506571482613964425E2};
+
+  const Array ax = x.abs();
+  const auto large = ax > T3P8;
+  const auto medium = !large && ax > 0.66;
+  const Array y0 =
+      large.select(PIO2, medium.select(PIO4, Array::Zero(x.size())));
+  const Array z =
+      large.select(-1. / ax, medium.select((ax - 1.) / (ax + 1.), ax));
+  const Array z2 = z * z;
+  Array num = Array::Constant(x.size(), P[0]);
+  for (size_t i = 1; i != 5; ++i)
+    num = num * z2 + P[i];
+  Array den = z2 + Q[0];
+  for (size_t i = 1; i != 5; ++i)
+    den = den * z2 + Q[i];
+  const Array corr = large.select(
+      MOREBITS, medium.select(0.5 * MOREBITS,
+                              Array::Zero(x.size())));
+  const Array res = y0 + (z * z2 * num / den + z + corr);
+  return (x < 0).select(-res, res);
+}
+
+template <class Array> Array FImpl(const Array &I, const Array &J) {
+  const Array SumSq = I + J;
+  const Array delta = (I - J) / SumSq;
+  const Array d2 = delta.square();
+  return (delta.abs() < 1e-3)
+      .select(delta.abs() + SumSq * d2 * (1 + d2 / 5e0) / 3e0,
+              SumSq * (0.5 + 0.25 * (delta - 1) * (delta + 1) / delta *
+                                 ((1 + delta) / (1 - delta)).log()));
+}
+
+template <class Array> Array FuncFImpl(const Array &t, const Array &r) {
+  const Array sqr = r.abs().sqrt();
+  return (r.abs() < 1e-3)
+      .select(-2 * r / t,
+              (r > 0).select(sqr * ((t - sqr) / (t + sqr)).abs().log(),
+                             2 * sqr * AtanImpl<Array>(sqr / t)));
+}
+
+template <class Array> Array GImpl(const Array &I, const Array &J,
+                                          const Array &Q) {
+  const Array diff = I - J;
+  const Array Qsq = Q.square();
+  const Array logpart =
+      (diff.abs() < 1e-3)
+          .select(6. * J / Q + 3. * diff / Q,
+                  3. / Q *
+                      ((I.square() + J.square()) / diff -
+                       (I.square() - J.square()) / Q +
+                       diff.cube() / (3. * Qsq)) *
+                      (I / J).log());
+  const Array r = Qsq - 2 * Q * (I + J) + diff.square();
+  const Array t = I + J - Q;
+  return -16. / 3. + 5 * (I + J) / Q - 2 * diff.square() / Qsq + logpart +
+         r / Q.cube() * FuncFImpl<Array>(t, r);
+}
+
+template <class Array> Array G2Impl(const Array &I, const Array &Q) {
+  const Array x = I / Q;
+  const Array logpart =
+      ((I - Q).abs() < 1e-3)
+          .select(-18.0 + 3.0 * (I - Q) / Q,
+                  (-10.0 + 18.0 * x - 6 * x.square() + x.cube() -
+                   9 * (I + Q) / (I - Q)) *
+                      x.log());
+  return -79. / 3. + 9. * x - 2. * x.square() + logpart +
+         (12 - 4 * x + x.square()) *
+             FuncFImpl<Array>(I, I.square() - 4. * I * Q) / Q;
+}
+
+} // namespace
+
+namespace ScannerS::Constraints::STUDetail {
+Eigen::ArrayXd Atan(const Eigen::ArrayXd &x) { return AtanImpl(x); }
+ChunkArray Atan(const ChunkArray &x) { return AtanImpl(x); }
+
+Eigen::ArrayXd F(const Eigen::ArrayXd &I, const Eigen::ArrayXd &J) {
+  return FImpl(I, J);
+}
+ChunkArray F(const ChunkArray &I, const ChunkArray &J) { return FImpl(I, J); }
+
+Eigen::ArrayXd FuncF(const Eigen::ArrayXd &t, const Eigen::ArrayXd &r) {
+  return FuncFImpl(t, r);
+}
+ChunkArray FuncF(const ChunkArray &t, const ChunkArray &r) {
+  return FuncFImpl(t, r);
+}
+
+Eigen::ArrayXd G(const Eigen::ArrayXd &I, const Eigen::ArrayXd &J,
+                 const Eigen::ArrayXd &Q) {
+  return GImpl(I, J, Q);
+}
+ChunkArray G(const ChunkArray &I, const ChunkArray &J, const ChunkArray &Q) {
+  return GImpl(I, J, Q);
+}
+
+Eigen::ArrayXd G2(const Eigen::ArrayXd &I, const Eigen::ArrayXd &Q) {
+  return G2Impl(I, Q);
+}
+ChunkArray G2(const ChunkArray &I, const ChunkArray &Q) {
+  return G2Impl(I, Q);
+}
+} // namespace ScannerS::Constraints::STUDetail
+
+void ScannerS::Constraints::STUDetail::LoopTermBatch::Add(
+    LoopFunction fn, size_t point, double I, double J, double Q, double cS,
+    double cT, double cU) {
+  auto &terms = terms_[static_cast<size_t>(fn)];
+  terms.I.push_back(I);
+  terms.J.push_back(J);
+  terms.Q.push_back(Q);
+  terms.cS.push_back(cS);
+  terms.cT.push_back(cT);
+  terms.cU.push_back(cU);
+  terms.point.push_back(point);
+}
+
+void ScannerS::Constraints::STUDetail::LoopTermBatch::Evaluate(
+    size_t nPoints, std::vector<std::array<double, 3>> &sums) const {
+  using Column = Eigen::Map<const Eigen::ArrayXd>;
+  sums.assign(nPoints, {0., 0., 0.});
+  for (size_t fn = 0; fn != terms_.size(); ++fn) {
+    const auto &terms = terms_[fn];
+    for (size_t start = 0; start < terms.point.size(); start += chunkSize) {
+      const auto size = static_cast<Eigen::Index>(
+          std::min<size_t>(chunkSize, terms.point.size() - start));
+      const ChunkArray I = Column{terms.I.data() + start, size};
+      const ChunkArray J = Column{terms.J.data() + start, size};
+      const ChunkArray Q = Column{terms.Q.data() + start, size};
+      ChunkArray values;
+      switch (static_cast<LoopFunction>(fn)) {
+      case LoopFunction::F:
+        values = F(I, J);
+        break;
+      case LoopFunction::G:
+        values = G(I, J, Q);
+        break;
+      case LoopFunction::G2:
+        values = G2(I, Q);
+        break;
+      case LoopFunction::Log:
+        values = I.log();
+        break;
+      }
+      for (Eigen::Index k = 0; k != size; ++k) {
+        const auto term = start + static_cast<size_t>(k);
+        auto &sum = sums.at(terms.point[term]);
+        sum[0] += terms.cS[term] * values[k];
+        sum[1] += terms.cT[term] * values[k];
+        sum[2] += terms.cU[term] * values[k];
+      }
+    }
+  }
+}
+
+void ScannerS::Constraints::STUDetail::LoopTermBatch::Clear() {
+  for (auto &terms : terms_) {
+    terms.I.clear();
+    terms.J.clear();
+    terms.Q.clear();
+    terms.cS.clear();
+    terms.cT.clear();
+    terms.cU.clear();
+    terms.point.clear();
+  }
+}
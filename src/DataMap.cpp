@@ -1,35 +1,225 @@
 #include "ScannerS/DataMap.hpp"
 
+#include <algorithm>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <unordered_map>
 #include <utility>
 
 namespace ScannerS {
 
+namespace {
+//! process-wide registry of the keys that are stored in slots
+class Schema {
+public:
+  std::size_t Register(const std::string &name) {
+    std::unique_lock lock{mutex_};
+    if (auto existing = slots_.find(name); existing != slots_.end())
+      return existing->second;
+    const auto slot = names_.size();
+    names_.push_back(name);
+    slots_.emplace(name, slot);
+    // copy on write, iterators keep the order they were created with
+    auto sorted = std::make_shared<std::vector<std::size_t>>(*sorted_);
+    sorted->insert(std::upper_bound(sorted->begin(), sorted->end(), slot,
+                                    [this](std::size_t a, std::size_t b) {
+                                      return names_[a] < names_[b];
+                                    }),
+                   slot);
+    sorted_ = std::move(sorted);
+    return slot;
+  }
+
+  std::optional<std::size_t> Find(const std::string &name) const {
+    std::shared_lock lock{mutex_};
+    auto res = slots_.find(name);
+    if (res == slots_.end())
+      return std::nullopt;
+    return res->second;
+  }
+
+  // the references are stable since names_ only grows at the end
+  const std::string &Name(std::size_t slot) const {
+    std::shared_lock lock{mutex_};
+    return names_[slot];
+  }
+
+  std::size_t Size() const {
+    std::shared_lock lock{mutex_};
+    return names_.size();
+  }
+
+  std::shared_ptr<const std::vector<std::size_t>> Sorted() const {
+    std::shared_lock lock{mutex_};
+    return sorted_;
+  }
+
+private:
+  mutable std::shared_mutex mutex_;
+  std::unordered_map<std::string, std::size_t> slots_;
+  std::deque<std::string> names_; // stable references
+  // slots in alphabetical order
+  std::shared_ptr<const std::vector<std::size_t>> sorted_ =
+      std::make_shared<const std::vector<std::size_t>>();
+};
+
+Schema &GlobalSchema() {
+  static Schema schema{};
+  return schema;
+}
+
+//! maximal number of recycled slot buffers per thread
+constexpr std::size_t maxBuffers = 64;
+
+std::string DuplicateMessage(const std::string &key) {
+  return "Can't store, key " + key + " already exists.";
+}
+} // namespace
+
+DataMap::Key::Key(const key_type &name)
+    : slot_{GlobalSchema().Register(name)} {}
+
+const DataMap::key_type &DataMap::Key::Name() const {
+  return GlobalSchema().Name(slot_);
+}
+
 const DataMap::mapped_type &DataMap::operator[](const key_type &key) const {
-  auto res = data_.find(key);
-  if (res == data_.end())
+  if (auto slot = GlobalSchema().Find(key);
+      slot && *slot < slots_.size() && slots_[*slot].set)
+    return slots_[*slot].value;
+  auto res = extra_.find(key);
+  if (res == extra_.end())
     throw DataMapError("Unknown key " + key);
   return res->second;
 }
 
+bool DataMap::Contains(const key_type &key) const {
+  if (auto slot = GlobalSchema().Find(key);
+      slot && *slot < slots_.size() && slots_[*slot].set)
+    return true;
+  return extra_.find(key) != extra_.end();
+}
+
 void DataMap::Store(const key_type &key, double value) {
-  auto res = data_.try_emplace(key, value);
-  if (!res.second)
-    throw DataMapError("Can't store, key " + key + " already exists.");
+  if (auto slot = GlobalSchema().Find(key))
+    return StoreChecked(*slot, value);
+  StoreExtra(key_type{key}, value);
 }
 
 void DataMap::Store(key_type &&key, double value) {
-  auto res = data_.try_emplace(std::move(key), value);
-  if (!res.second)
-    throw DataMapError("Can't store, key " + key + " already exists.");
+  if (auto slot = GlobalSchema().Find(key))
+    return StoreChecked(*slot, value);
+  StoreExtra(std::move(key), value);
 }
 
 void DataMap::Merge(Map &&source) {
-  data_.merge(source);
-  for (auto [key, value] : source) {
-    throw DataMapError("Entry {" + key + ", " + std::to_string(value) +
-                       "} can't be merged. Exists with value " +
-                       std::to_string(data_.at(key)));
+  for (auto &[key, value] : source) {
+    if (Contains(key))
+      throw DataMapError("Entry {" + key + ", " + std::to_string(value) +
+                         "} can't be merged. Exists with value " +
+                         std::to_string((*this)[key]));
+  }
+  for (auto &[key, value] : source)
+    Store(key, value);
+}
+
+DataMap::~DataMap() {
+  if (slots_.capacity() == 0)
+    return;
+  if (auto buffers = Buffers(); buffers && buffers->size() < maxBuffers) {
+    slots_.clear();
+    buffers->push_back(std::move(slots_));
+  }
+}
+
+std::vector<std::vector<DataMap::Entry>> *DataMap::Buffers() {
+  // the flag is trivially destructible and thus still accessible when
+  // DataMaps with thread storage duration are destroyed after the pool
+  thread_local bool poolAlive = false;
+  thread_local struct Pool {
+    std::vector<std::vector<Entry>> buffers;
+    Pool() { poolAlive = true; }
+    ~Pool() { poolAlive = false; }
+  } pool;
+  return poolAlive ? &pool.buffers : nullptr;
+}
+
+void DataMap::Grow() {
+  if (slots_.capacity() == 0)
+    if (auto buffers = Buffers(); buffers && !buffers->empty()) {
+      slots_ = std::move(buffers->back());
+      buffers->pop_back();
+    }
+  slots_.resize(GlobalSchema().Size(), {0., false});
+}
+
+void DataMap::StoreChecked(std::size_t slot, mapped_type value) {
+  if (slot >= slots_.size())
+    Grow();
+  const auto &name = GlobalSchema().Name(slot);
+  if (slots_[slot].set ||
+      (slot >= extraSchemaSize_ && extra_.find(name) != extra_.end()))
+    throw DataMapError(DuplicateMessage(name));
+  slots_[slot] = {value, true};
+}
+
+void DataMap::StoreExtra(key_type &&key, mapped_type value) {
+  auto res = extra_.try_emplace(std::move(key), value);
+  if (!res.second)
+    throw DataMapError(DuplicateMessage(res.first->first));
+  extraSchemaSize_ = std::min(extraSchemaSize_, GlobalSchema().Size());
+}
+
+DataMap::const_iterator DataMap::begin() const {
+  return const_iterator{this, 0, extra_.begin()};
+}
+
+DataMap::const_iterator DataMap::end() const {
+  return const_iterator{this, const_iterator::endPos, extra_.end()};
+}
+
+DataMap::const_iterator::const_iterator(const DataMap *map, std::size_t pos,
+                                        Map::const_iterator extra)
+    : map_{map}, sorted_{GlobalSchema().Sorted()}, pos_{pos}, extra_{extra} {
+  SkipUnset();
+}
+
+void DataMap::const_iterator::SkipUnset() {
+  while (pos_ < sorted_->size() && ((*sorted_)[pos_] >= map_->slots_.size() ||
+                                    !map_->slots_[(*sorted_)[pos_]].set))
+    ++pos_;
+  if (pos_ >= sorted_->size())
+    pos_ = endPos;
+}
+
+bool DataMap::const_iterator::SlotFirst() const {
+  if (pos_ == endPos)
+    return false;
+  if (extra_ == map_->extra_.end())
+    return true;
+  return GlobalSchema().Name((*sorted_)[pos_]) < extra_->first;
+}
+
+DataMap::const_iterator::value_type
+DataMap::const_iterator::operator*() const {
+  if (SlotFirst()) {
+    const auto slot = (*sorted_)[pos_];
+    return {GlobalSchema().Name(slot), map_->slots_[slot].value};
+  }
+  return {extra_->first, extra_->second};
+}
+
+DataMap::const_iterator &DataMap::const_iterator::operator++() {
+  if (SlotFirst()) {
+    ++pos_;
+    SkipUnset();
+  } else {
+    ++extra_;
   }
+  return *this;
 }
 
 } // namespace ScannerS
@@ -0,0 +1,276 @@
+/**
+ * @file HBHSStub.cpp
+ * @brief Offline stand-in for HiggsBounds and HiggsSignals.
+ *
+ * Implements the C interface declared in HiggsBounds.h and HiggsSignals.h
+ * with cheap, deterministic and smooth synthetic results. This allows to
+ * build, test and profile the complete scan pipeline without network access
+ * and without the cost of the real codes. The results have **no physical
+ * meaning** beyond qualitatively mimicking the real codes:
+ *
+ *  - Neutral scalars are excluded by a LEP-like search below about 70 GeV
+ *    and by a hadron-collider-like search if their gluon fusion rate is large
+ *    compared to their mass. Charged scalars are excluded by a LEP-like
+ *    search below about 80 GeV. Which of these are active follows the
+ *    `whichexpt` argument of initialize_HiggsBounds().
+ *  - The HiggsSignals rate \f$\chi^2\f$ is the SM reference value plus the
+ *    deviation of the combined gluon fusion rate of all scalars close to
+ *    125.09 GeV from one, the mass \f$\chi^2\f$ measures the distance of
+ *    these scalars from 125.09 GeV. All signal rates equal the gluon fusion
+ *    rate.
+ *  - The SM-like branching ratios are constant, the widths and cross sections
+ *    simple power laws in the mass. The effective coupling cross sections are
+ *    quadratic forms in the couplings like the real ones.
+ *
+ * Each run_HiggsBounds_full() and run_HiggsSignals_full() call busy-waits for
+ * a configurable latency in microseconds to emulate the cost of the real
+ * codes. It defaults to `SCANNERS_HBHS_STUB_LATENCY` set at configure time
+ * and can be overridden at runtime through the environment variable of the
+ * same name, which is read in initialize_HiggsBounds().
+ *
+ * Like the real codes, the stand-in keeps global state and is not thread
+ * safe.
+ */
+#include "HiggsBounds.h"
+#include "HiggsSignals.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+#ifndef SCANNERS_HBHS_STUB_LATENCY
+#define SCANNERS_HBHS_STUB_LATENCY 0
+#endif
+
+namespace {
+constexpr double mhref = 125.09;
+//! HiggsSignals \f$\chi^2\f$ of the SM, matches Constraints::Higgs
+constexpr double chisqMuSM = 84.4372199363;
+//! half width of the mass window of the HiggsSignals observables
+constexpr double hsWindow = 5.;
+//! mass resolution of the HiggsSignals observables
+constexpr double hsMassUnc = 0.24;
+//! rate uncertainty of the HiggsSignals observables
+constexpr double hsRateUnc = 0.1;
+constexpr int hsNObs = 107;
+
+//! the channel ids reported by run_HiggsBounds_full
+enum Channel : int { none = 0, lep = 1, hadr = 2 };
+
+struct State {
+  int nHzero = 0;
+  int nHplus = 0;
+  bool lep = true;
+  bool hadr = true;
+  std::chrono::microseconds latency{SCANNERS_HBHS_STUB_LATENCY};
+  std::vector<double> mh;
+  std::vector<double> muGG; //!< gluon fusion rate normalized to the SM
+  std::vector<double> mHp;
+} state;
+
+void Wait() {
+  if (state.latency.count() <= 0)
+    return;
+  const auto end = std::chrono::steady_clock::now() + state.latency;
+  while (std::chrono::steady_clock::now() < end) {
+  }
+}
+
+struct Exclusion {
+  double obsratio = 0.;
+  int chan = none;
+
+  void Add(double ratio, Channel channel) {
+    if (ratio > obsratio) {
+      obsratio = ratio;
+      chan = channel;
+    }
+  }
+};
+
+//! gluon fusion rates of all neutral scalars in the HiggsSignals window
+double MuGGInWindow() {
+  double mu = 0.;
+  for (int j = 0; j != state.nHzero; ++j)
+    if (std::abs(state.mh[j] - mhref) < hsWindow)
+      mu += state.muGG[j];
+  return mu;
+}
+
+//! SM-like cross sections scale as a power of the mass
+double Scaled(double value125, double mh, double power) {
+  return value125 * std::pow(mh / mhref, power);
+}
+} // namespace
+
+extern "C" {
+
+void initialize_HiggsBounds(int nHiggsneut, int nHiggsplus, int whichexpt) {
+  state.nHzero = nHiggsneut;
+  state.nHplus = nHiggsplus;
+  state.lep = whichexpt != 2;  // onlyH
+  state.hadr = whichexpt != 1; // onlyL
+  state.mh.assign(nHiggsneut, 0.);
+  state.muGG.assign(nHiggsneut, 0.);
+  state.mHp.assign(nHiggsplus, 0.);
+  if (const char *latency = std::getenv("SCANNERS_HBHS_STUB_LATENCY"))
+    state.latency = std::chrono::microseconds{std::atol(latency)};
+}
+
+void finish_HiggsBounds() {}
+
+void HiggsBounds_neutral_input_properties(const double *Mh, const double *,
+                                          const int *) {
+  std::copy(Mh, Mh + state.nHzero, state.mh.begin());
+}
+
+void HiggsBounds_neutral_input_SMBR(const double *, const double *,
+                                    const double *, const double *,
+                                    const double *, const double *,
+                                    const double *, const double *,
+                                    const double *, const double *,
+                                    const double *) {}
+
+void HiggsBounds_neutral_input_nonSMBR(const double *, const double *,
+                                       const double *, const double *,
+                                       const double *, const double *,
+                                       const double *) {}
+
+void HiggsBounds_neutral_input_LEP(const double *, const double *,
+                                   const double *, const double *) {}
+
+void HiggsBounds_neutral_input_hadr(
+    int collider, const double *, const double *CS_gg_hj_ratio, const double *,
+    const double *, const double *, const double *, const double *,
+    const double *, const double *, const double *, const double *,
+    const double *, const double *) {
+  if (collider == 13)
+    std::copy(CS_gg_hj_ratio, CS_gg_hj_ratio + state.nHzero,
+              state.muGG.begin());
+}
+
+void HiggsBounds_neutral_input_effC(
+    const double *, const double *, const double *, const double *,
+    const double *, const double *, const double *, const double *,
+    const double *, const double *, const double *, const double *,
+    const double *, const double *, const double *, const double *,
+    const double *ghjgg, const double *) {
+  for (int j = 0; j != state.nHzero; ++j)
+    state.muGG[j] = ghjgg[j] * ghjgg[j];
+}
+
+void HiggsBounds_charged_input(const double *Mhplus, const double *,
+                               const double *, double, const double *,
+                               const double *, const double *, const double *,
+                               const double *, const double *,
+                               const double *) {
+  std::copy(Mhplus, Mhplus + state.nHplus, state.mHp.begin());
+}
+
+void HiggsBounds_charged_input_hadr(int, const double *, const double *,
+                                    const double *, const double *,
+                                    const double *, const double *,
+                                    const double *, const double *,
+                                    const double *, const double *) {}
+
+void run_HiggsBounds_full(int *HBresult, int *chan, double *obsratio,
+                          int *ncombined) {
+  Wait();
+  auto combined = Exclusion{};
+  for (int i = 1; i <= state.nHzero + state.nHplus; ++i) {
+    auto excl = Exclusion{};
+    if (i <= state.nHzero) {
+      const double m = state.mh[i - 1];
+      if (state.lep)
+        excl.Add(2. * std::exp(-m / 100.), lep);
+      if (state.hadr)
+        excl.Add(0.5 * state.muGG[i - 1] * mhref / m, hadr);
+    } else if (state.lep) {
+      excl.Add(1.5 * std::exp(-state.mHp[i - state.nHzero - 1] / 200.), lep);
+    }
+    HBresult[i] = excl.obsratio < 1. ? 1 : 0;
+    chan[i] = excl.chan;
+    obsratio[i] = excl.obsratio;
+    ncombined[i] = 1;
+    combined.Add(excl.obsratio, static_cast<Channel>(excl.chan));
+  }
+  HBresult[0] = combined.obsratio < 1. ? 1 : 0;
+  chan[0] = combined.chan;
+  obsratio[0] = combined.obsratio;
+  ncombined[0] = 1;
+}
+
+double SMBR_HWW(double) { return 0.2089; }
+double SMBR_HZZ(double) { return 0.02613; }
+double SMBR_Hbb(double) { return 0.5901; }
+double SMBR_Htautau(double) { return 0.06346; }
+double SMBR_Hgamgam(double) { return 0.002319; }
+double SMBR_Hgg(double) { return 0.07818; }
+double SMBR_Htoptop(double) { return 0.; }
+double SMBR_Hcc(double) { return 0.02889; }
+double SMBR_Hss(double) { return 0.0002229; }
+double SMBR_Hmumu(double) { return 0.0002247; }
+double SMBR_HZgam(double) { return 0.001548; }
+double SMGamma_H(double mh) { return Scaled(4.079e-3, mh, 3.); }
+
+double SMCS_lhc13_HW(double mh) { return Scaled(1.475, mh, -3.); }
+double SMCS_lhc13_HZ(double mh) { return Scaled(0.9123, mh, -3.); }
+double SMCS_lhc13_gg_H(double mh) { return Scaled(41.98, mh, -2.); }
+double SMCS_lhc13_bb_H(double mh) { return Scaled(0.4879, mh, -2.5); }
+double SMCS_lhc13_vbf_H(double mh) { return Scaled(3.925, mh, -1.5); }
+double SMCS_lhc13_ttH(double mh) { return Scaled(0.4757, mh, -2.); }
+
+double SMCS_effC_qq_HZ(double mh, int, double ghZZ, double, double, double,
+                       double) {
+  return Scaled(0.7735, mh, -3.) * ghZZ * ghZZ;
+}
+
+double SMCS_effC_gg_HZ(double mh, int, double ghZZ, double ghtt_s,
+                       double ghbb_s, double ghtt_p, double ghbb_p) {
+  return Scaled(0.1388, mh, -2.) *
+         (2.46 * ghZZ * ghZZ + 0.46 * ghtt_s * ghtt_s - 1.92 * ghZZ * ghtt_s +
+          0.6 * ghtt_p * ghtt_p + 0.01 * ghbb_s * ghbb_s -
+          0.01 * ghZZ * ghbb_s + 0.01 * ghbb_p * ghbb_p);
+}
+
+double SMCS_effC_HZ(double mh, int collider, double ghZZ, double ghtt_s,
+                    double ghbb_s, double ghtt_p, double ghbb_p) {
+  return SMCS_effC_qq_HZ(mh, collider, ghZZ, ghtt_s, ghbb_s, ghtt_p, ghbb_p) +
+         SMCS_effC_gg_HZ(mh, collider, ghZZ, ghtt_s, ghbb_s, ghtt_p, ghbb_p);
+}
+
+double SMCS_effC_HW(double mh, int, double ghWW, double, double) {
+  return Scaled(1.475, mh, -3.) * ghWW * ghWW;
+}
+
+double HCCS_tHc(double mHp, double ghptb_R, double ghptb_L, double) {
+  return 0.6 * std::pow(200. / mHp, 3) *
+         (ghptb_R * ghptb_R + 0.02 * ghptb_L * ghptb_L);
+}
+
+void initialize_HiggsSignals_latestresults(int, int) {}
+
+void finish_HiggsSignals() {}
+
+void run_HiggsSignals_full(double *Chisq_mu, double *Chisq_mh, double *Chisq,
+                           int *nobs, double *Pvalue) {
+  Wait();
+  *Chisq_mh = 0.;
+  for (int j = 0; j != state.nHzero; ++j)
+    if (std::abs(state.mh[j] - mhref) < hsWindow)
+      *Chisq_mh += std::pow((state.mh[j] - mhref) / hsMassUnc, 2);
+  *Chisq_mu = chisqMuSM + std::pow((MuGGInWindow() - 1.) / hsRateUnc, 2);
+  *Chisq = *Chisq_mu + *Chisq_mh;
+  *nobs = hsNObs;
+  *Pvalue = std::exp(-0.5 * (*Chisq - chisqMuSM));
+}
+
+void get_HiggsSignals_Rvalues(int i, int, double *R_H_WW, double *R_H_ZZ,
+                              double *R_H_gaga, double *R_H_tautau,
+                              double *R_H_bb, double *R_VH_bb) {
+  const double mu = i >= 1 && i <= state.nHzero ? state.muGG[i - 1] : 0.;
+  *R_H_WW = *R_H_ZZ = *R_H_gaga = *R_H_tautau = *R_H_bb = *R_VH_bb = mu;
+}
+}
@@ -0,0 +1,96 @@
+/**
+ * @file HiggsBounds.h
+ * @brief C interface of the offline HiggsBounds stand-in.
+ *
+ * Declares the subset of the HiggsBounds C interface used by ScannerS, see
+ * HBHSStub.cpp for the synthetic implementation.
+ */
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void initialize_HiggsBounds(int nHiggsneut, int nHiggsplus, int whichexpt);
+void finish_HiggsBounds();
+
+void HiggsBounds_neutral_input_properties(const double *Mh,
+                                          const double *GammaTotal_hj,
+                                          const int *CP_value);
+void HiggsBounds_neutral_input_SMBR(
+    const double *BR_hjss, const double *BR_hjcc, const double *BR_hjbb,
+    const double *BR_hjtt, const double *BR_hjmumu, const double *BR_hjtautau,
+    const double *BR_hjWW, const double *BR_hjZZ, const double *BR_hjZga,
+    const double *BR_hjgaga, const double *BR_hjgg);
+void HiggsBounds_neutral_input_nonSMBR(
+    const double *BR_hjinvisible, const double *BR_hkhjhi,
+    const double *BR_hjhiZ, const double *BR_hjemu, const double *BR_hjetau,
+    const double *BR_hjmutau, const double *BR_hjHpiW);
+void HiggsBounds_neutral_input_LEP(const double *XS_ee_hjZ_ratio,
+                                   const double *XS_ee_bbhj_ratio,
+                                   const double *XS_ee_tautauhj_ratio,
+                                   const double *XS_ee_hjhi_ratio);
+void HiggsBounds_neutral_input_hadr(
+    int collider, const double *CS_hj_ratio, const double *CS_gg_hj_ratio,
+    const double *CS_bb_hj_ratio, const double *CS_hjW_ratio,
+    const double *CS_hjZ_ratio, const double *CS_vbf_ratio,
+    const double *CS_tthj_ratio, const double *CS_thj_tchan_ratio,
+    const double *CS_thj_schan_ratio, const double *CS_qq_hjZ_ratio,
+    const double *CS_gg_hjZ_ratio, const double *CS_tWhj_ratio,
+    const double *CS_hjhi);
+void HiggsBounds_neutral_input_effC(
+    const double *ghjss_s, const double *ghjss_p, const double *ghjcc_s,
+    const double *ghjcc_p, const double *ghjbb_s, const double *ghjbb_p,
+    const double *ghjtt_s, const double *ghjtt_p, const double *ghjmumu_s,
+    const double *ghjmumu_p, const double *ghjtautau_s,
+    const double *ghjtautau_p, const double *ghjWW, const double *ghjZZ,
+    const double *ghjZga, const double *ghjgaga, const double *ghjgg,
+    const double *ghjhiZ);
+void HiggsBounds_charged_input(
+    const double *Mhplus, const double *GammaTotal_Hpj,
+    const double *CS_ee_HpjHmj_ratio, double BR_tWpb, const double *BR_tHpjb,
+    const double *BR_Hpjcs, const double *BR_Hpjcb, const double *BR_Hpjtaunu,
+    const double *BR_Hpjtb, const double *BR_HpjWZ, const double *BR_HpjhiW);
+void HiggsBounds_charged_input_hadr(
+    int collider, const double *CS_Hpjtb, const double *CS_Hpjcb,
+    const double *CS_Hpjbjet, const double *CS_Hpjcjet,
+    const double *CS_Hpjjetjet, const double *CS_HpjW, const double *CS_HpjZ,
+    const double *CS_vbf_Hpj, const double *CS_HpjHmj, const double *CS_Hpjhi);
+
+void run_HiggsBounds_full(int *HBresult, int *chan, double *obsratio,
+                          int *ncombined);
+
+double SMBR_HWW(double mh);
+double SMBR_HZZ(double mh);
+double SMBR_Hbb(double mh);
+double SMBR_Htautau(double mh);
+double SMBR_Hgamgam(double mh);
+double SMBR_Hgg(double mh);
+double SMBR_Htoptop(double mh);
+double SMBR_Hcc(double mh);
+double SMBR_Hss(double mh);
+double SMBR_Hmumu(double mh);
+double SMBR_HZgam(double mh);
+double SMGamma_H(double mh);
+
+double SMCS_lhc13_HW(double mh);
+double SMCS_lhc13_HZ(double mh);
+double SMCS_lhc13_gg_H(double mh);
+double SMCS_lhc13_bb_H(double mh);
+double SMCS_lhc13_vbf_H(double mh);
+double SMCS_lhc13_ttH(double mh);
+
+double SMCS_effC_HZ(double mh, int collider, double ghZZ, double ghtt_s,
+                    double ghbb_s, double ghtt_p, double ghbb_p);
+double SMCS_effC_gg_HZ(double mh, int collider, double ghZZ, double ghtt_s,
+                       double ghbb_s, double ghtt_p, double ghbb_p);
+double SMCS_effC_qq_HZ(double mh, int collider, double ghZZ, double ghtt_s,
+                       double ghbb_s, double ghtt_p, double ghbb_p);
+double SMCS_effC_HW(double mh, int collider, double ghWW, double ghtt_s,
+                    double ghbb_s);
+
+double HCCS_tHc(double mHp, double ghptb_R, double ghptb_L, double BR_tHpb);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,26 @@
+/**
+ * @file HiggsSignals.h
+ * @brief C interface of the offline HiggsSignals stand-in.
+ *
+ * Declares the subset of the HiggsSignals C interface used by ScannerS, see
+ * HBHSStub.cpp for the synthetic implementation.
+ */
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void initialize_HiggsSignals_latestresults(int nHiggsneut, int nHiggsplus);
+void finish_HiggsSignals();
+
+void run_HiggsSignals_full(double *Chisq_mu, double *Chisq_mh, double *Chisq,
+                           int *nobs, double *Pvalue);
+void get_HiggsSignals_Rvalues(int i, int collider, double *R_H_WW,
+                              double *R_H_ZZ, double *R_H_gaga,
+                              double *R_H_tautau, double *R_H_bb,
+                              double *R_VH_bb);
+
+#ifdef __cplusplus
+}
+#endif
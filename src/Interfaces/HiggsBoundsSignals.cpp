@@ -1,6 +1,16 @@
 #include "ScannerS/Interfaces/HiggsBoundsSignals.hpp"
 
 namespace ScannerS::Interfaces::HiggsBoundsSignals {
+HBExperiments HBExperimentsFromString(const std::string &name) {
+  if (name == "LandH")
+    return HBExperiments::LandH;
+  if (name == "onlyL")
+    return HBExperiments::onlyL;
+  if (name == "onlyH")
+    return HBExperiments::onlyH;
+  throw(std::runtime_error("Unknown set of HiggsBounds analyses " + name));
+}
+
 double tWHratio(double c_HWW, std::complex<double> c_Htt) {
   return (-62. * c_HWW * c_Htt.real() + 45. * pow(c_Htt.real(), 2) +
           34. * pow(c_Htt.imag(), 2) + 33. * pow(c_HWW, 2)) /
@@ -0,0 +1,952 @@
+#include "ScannerS/Interfaces/Lilith.hpp"
+
+#include "ScannerS/config.h"
+#include <Eigen/LU>
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+
+namespace ScannerS::Interfaces::Lilith {
+
+namespace {
+// ---------------------------------- XML ----------------------------------
+
+//! an XML element, the text of all text nodes is concatenated
+struct Element {
+  std::string tag;
+  std::map<std::string, std::string> attributes;
+  std::string text;
+  std::vector<Element> children;
+
+  const std::string *Attribute(const std::string &name) const {
+    const auto it = attributes.find(name);
+    return it == attributes.end() ? nullptr : &it->second;
+  }
+};
+
+/**
+ * Minimal XML parser for the Lilith input files. Supports elements,
+ * attributes, comments, CDATA, processing instructions and the predefined
+ * entities, but no DTDs or namespaces.
+ */
+class XMLParser {
+public:
+  XMLParser(const std::string &content, const std::string &file)
+      : s_{content}, file_{file} {}
+
+  Element Parse() {
+    SkipMisc();
+    auto root = ParseElement();
+    SkipMisc();
+    if (pos_ != s_.size())
+      Error("unexpected content after the root element");
+    return root;
+  }
+
+private:
+  const std::string &s_;
+  const std::string &file_;
+  std::size_t pos_ = 0;
+
+  [[noreturn]] void Error(const std::string &message) const {
+    throw(std::runtime_error("Invalid XML in " + file_ + " at position " +
+                             std::to_string(pos_) + ": " + message));
+  }
+
+  bool StartsWith(const char *prefix) const {
+    return s_.compare(pos_, std::char_traits<char>::length(prefix), prefix) ==
+           0;
+  }
+
+  void SkipPast(const char *end) {
+    const auto found = s_.find(end, pos_);
+    if (found == std::string::npos)
+      Error(std::string{"missing "} + end);
+    pos_ = found + std::char_traits<char>::length(end);
+  }
+
+  void SkipWhitespace() {
+    while (pos_ < s_.size() &&
+           std::isspace(static_cast<unsigned char>(s_[pos_])))
+      ++pos_;
+  }
+
+  void Expect(char c) {
+    if (pos_ >= s_.size() || s_[pos_] != c)
+      Error(std::string{"expected '"} + c + "'");
+    ++pos_;
+  }
+
+  //! skip whitespace, comments, processing instructions and doctypes
+  void SkipMisc() {
+    while (true) {
+      SkipWhitespace();
+      if (StartsWith("<?"))
+        SkipPast("?>");
+      else if (StartsWith("<!--"))
+        SkipPast("-->");
+      else if (StartsWith("<!"))
+        SkipPast(">");
+      else
+        return;
+    }
+  }
+
+  std::string ParseName() {
+    const auto start = pos_;
+    while (pos_ < s_.size() &&
+           (std::isalnum(static_cast<unsigned char>(s_[pos_])) ||
+            s_[pos_] == '_' || s_[pos_] == '-' || s_[pos_] == '.' ||
+            s_[pos_] == ':'))
+      ++pos_;
+    if (pos_ == start)
+      Error("expected a name");
+    return s_.substr(start, pos_ - start);
+  }
+
+  std::string Decode(std::size_t start, std::size_t end) const {
+    static const std::array<std::pair<const char *, char>, 5> entities{
+        {{"&lt;", '<'},
+         {"&gt;", '>'},
+         {"&amp;", '&'},
+         {"&quot;", '"'},
+         {"&apos;", '\''}}};
+    std::string result;
+    result.reserve(end - start);
+    for (auto i = start; i < end; ++i) {
+      if (s_[i] != '&') {
+        result += s_[i];
+        continue;
+      }
+      const auto match = std::find_if(
+          entities.begin(), entities.end(), [this, i](const auto &e) {
+            return s_.compare(i, std::char_traits<char>::length(e.first),
+                              e.first) == 0;
+          });
+      if (match == entities.end())
+        Error("unsupported entity");
+      result += match->second;
+      i += std::char_traits<char>::length(match->first) - 1;
+    }
+    return result;
+  }
+
+  Element ParseElement() {
+    Element el;
+    Expect('<');
+    el.tag = ParseName();
+    while (true) {
+      SkipWhitespace();
+      if (StartsWith("/>")) {
+        pos_ += 2;
+        return el;
+      }
+      if (StartsWith(">")) {
+        ++pos_;
+        break;
+      }
+      auto name = ParseName();
+      SkipWhitespace();
+      Expect('=');
+      SkipWhitespace();
+      if (pos_ >= s_.size() || (s_[pos_] != '"' && s_[pos_] != '\''))
+        Error("expected a quoted attribute value");
+      const char quote = s_[pos_++];
+      const auto end = s_.find(quote, pos_);
+      if (end == std::string::npos)
+        Error("unterminated attribute value");
+      el.attributes[std::move(name)] = Decode(pos_, end);
+      pos_ = end + 1;
+    }
+
+    while (true) {
+      if (pos_ >= s_.size())
+        Error("unterminated element <" + el.tag + ">");
+      if (StartsWith("</")) {
+        pos_ += 2;
+        if (ParseName() != el.tag)
+          Error("mismatched closing tag for <" + el.tag + ">");
+        SkipWhitespace();
+        Expect('>');
+        return el;
+      }
+      if (StartsWith("<!--")) {
+        SkipPast("-->");
+      } else if (StartsWith("<![CDATA[")) {
+        pos_ += 9;
+        const auto end = s_.find("]]>", pos_);
+        if (end == std::string::npos)
+          Error("unterminated CDATA section");
+        el.text.append(s_, pos_, end - pos_);
+        pos_ = end + 3;
+      } else if (StartsWith("<?")) {
+        SkipPast("?>");
+      } else if (StartsWith("<")) {
+        el.children.push_back(ParseElement());
+      } else {
+        const auto end = std::min(s_.find('<', pos_), s_.size());
+        el.text += Decode(pos_, end);
+        pos_ = end;
+      }
+    }
+  }
+};
+
+std::string ReadFile(const std::string &path) {
+  std::ifstream in{path};
+  if (!in)
+    throw(std::runtime_error("Cannot open the Lilith input file " + path));
+  std::ostringstream content;
+  content << in.rdbuf();
+  return content.str();
+}
+
+std::string Trim(const std::string &s) {
+  const auto first = s.find_first_not_of(" \t\r\n");
+  if (first == std::string::npos)
+    return "";
+  return s.substr(first, s.find_last_not_of(" \t\r\n") - first + 1);
+}
+
+// ------------------------- production cross sections -----------------------
+
+/**
+ * SM cross section ratios used to split the multi-particle production labels.
+ * Interpolates the ratios tabulated in the Lilith Grids with not-a-knot
+ * splines, like `brsm.py`.
+ */
+class CxnRatios {
+public:
+  enum Ratio : std::size_t {
+    WH_VH,
+    qqZH_ZH,
+    ggZH_ZH,
+    ZH_VH,
+    VH_VVH,
+    VBF_VVH,
+    tHq_tH,
+    tHW_tH,
+    tH_top,
+    ttH_top,
+    nRatios
+  };
+
+  CxnRatios(const std::string &sqrts, const std::string &lilithDir) {
+    const std::string dir = lilithDir + "/lilith/internal/Grids/";
+    const auto vvh = ReadColumns(dir + "WH_qqZH_ggZH_VBF_xsec" + sqrts + ".dat",
+                                 5);
+    const auto top = ReadColumns(dir + "tHq_tHW_ttH_xsec" + sqrts + ".dat", 4);
+    auto ratios = std::array<std::vector<double>, nRatios>{};
+    for (const auto &l : vvh) {
+      const double zh = l[2] + l[3];
+      const double vh = l[1] + zh;
+      ratios[WH_VH].push_back(l[1] / vh);
+      ratios[qqZH_ZH].push_back(l[2] / zh);
+      ratios[ggZH_ZH].push_back(l[3] / zh);
+      ratios[ZH_VH].push_back(zh / vh);
+      ratios[VH_VVH].push_back(vh / (vh + l[4]));
+      ratios[VBF_VVH].push_back(l[4] / (vh + l[4]));
+    }
+    for (const auto &l : top) {
+      const double th = l[1] + l[2];
+      ratios[tHq_tH].push_back(l[1] / th);
+      ratios[tHW_tH].push_back(l[2] / th);
+      ratios[tH_top].push_back(th / (th + l[3]));
+      ratios[ttH_top].push_back(l[3] / (th + l[3]));
+    }
+    const auto vvhGrid = Tools::UniformGrid{Column(vvh, 0)};
+    const auto topGrid = Tools::UniformGrid{Column(top, 0)};
+    for (std::size_t r = 0; r != nRatios; ++r)
+      splines_[r] =
+          Tools::UniformSpline{r < tHq_tH ? vvhGrid : topGrid, ratios[r],
+                               Tools::UniformSpline::Boundary::notAKnot};
+  }
+
+  double operator()(Ratio r, double mass) const { return splines_[r](mass); }
+
+private:
+  std::array<Tools::UniformSpline, nRatios> splines_;
+
+  static std::vector<std::vector<double>>
+  ReadColumns(const std::string &path, std::size_t nColumns) {
+    std::istringstream in{ReadFile(path)};
+    auto result = std::vector<std::vector<double>>{};
+    std::string line;
+    while (std::getline(in, line)) {
+      std::istringstream ls{line};
+      auto values = std::vector<double>{};
+      double v;
+      while (ls >> v)
+        values.push_back(v);
+      if (values.empty())
+        continue;
+      if (values.size() != nColumns)
+        throw(std::runtime_error("Invalid line in " + path + ": " + line));
+      result.push_back(std::move(values));
+    }
+    return result;
+  }
+
+  static std::vector<double>
+  Column(const std::vector<std::vector<double>> &lines, std::size_t i) {
+    auto result = std::vector<double>{};
+    for (const auto &l : lines)
+      result.push_back(l[i]);
+    return result;
+  }
+};
+
+const CxnRatios &SharedCxnRatios(Energy energy,
+                                 const std::string &lilithDir) {
+  static std::mutex mutex;
+  static std::map<std::pair<std::string, Energy>,
+                  std::unique_ptr<const CxnRatios>>
+      instances;
+  const auto lock = std::lock_guard{mutex};
+  auto &instance = instances[{lilithDir, energy}];
+  if (!instance)
+    instance = std::make_unique<const CxnRatios>(
+        energy == Energy::run1 ? "8" : "13", lilithDir);
+  return *instance;
+}
+
+// ------------------------------ measurements ------------------------------
+
+const std::map<std::string, Production> productions{
+    {"ggH", Production::ggH},   {"VBF", Production::VBF},
+    {"WH", Production::WH},     {"qqZH", Production::qqZH},
+    {"ggZH", Production::ggZH}, {"ttH", Production::ttH},
+    {"tHq", Production::tHq},   {"tHW", Production::tHW},
+    {"bbH", Production::bbH}};
+
+const std::map<std::string, Decay> decays{
+    {"gammagamma", Decay::gammagamma},
+    {"ZZ", Decay::ZZ},
+    {"WW", Decay::WW},
+    {"bb", Decay::bb},
+    {"tautau", Decay::tautau},
+    {"gg", Decay::gg},
+    {"cc", Decay::cc},
+    {"mumu", Decay::mumu},
+    {"Zgamma", Decay::Zgamma},
+    {"invisible", Decay::invisible}};
+
+//! the multi-particle production labels and their overlapping labels
+const std::map<std::string, std::vector<std::string>> multiOverlaps{
+    {"ZH", {"VH", "VVH"}},
+    {"VH", {"VVH"}},
+    {"VVH", {}},
+    {"tH", {"top"}},
+    {"top", {}}};
+
+//! the fractions of the individual production modes in a multi-particle label
+std::vector<std::pair<Production, double>>
+MultiProd(const std::string &label, const CxnRatios &r, double mass) {
+  const double zh_vh = r(CxnRatios::ZH_VH, mass);
+  const double vh_vvh = r(CxnRatios::VH_VVH, mass);
+  const double qqZH_ZH = r(CxnRatios::qqZH_ZH, mass);
+  const double ggZH_ZH = r(CxnRatios::ggZH_ZH, mass);
+  const double wh_vh = r(CxnRatios::WH_VH, mass);
+  const double tHq_tH = r(CxnRatios::tHq_tH, mass);
+  const double tHW_tH = r(CxnRatios::tHW_tH, mass);
+  const double th_top = r(CxnRatios::tH_top, mass);
+  if (label == "ZH")
+    return {{Production::qqZH, qqZH_ZH}, {Production::ggZH, ggZH_ZH}};
+  if (label == "VH")
+    return {{Production::WH, wh_vh},
+            {Production::qqZH, zh_vh * qqZH_ZH},
+            {Production::ggZH, zh_vh * ggZH_ZH}};
+  if (label == "VVH")
+    return {{Production::VBF, r(CxnRatios::VBF_VVH, mass)},
+            {Production::WH, vh_vvh * wh_vh},
+            {Production::qqZH, vh_vvh * zh_vh * qqZH_ZH},
+            {Production::ggZH, vh_vvh * zh_vh * ggZH_ZH}};
+  if (label == "tH")
+    return {{Production::tHq, tHq_tH}, {Production::tHW, tHW_tH}};
+  return {{Production::ttH, r(CxnRatios::ttH_top, mass)},
+          {Production::tHq, th_top * tHq_tH},
+          {Production::tHW, th_top * tHW_tH}};
+}
+
+//! reads Lilith experimental input files
+class MeasurementReader {
+public:
+  MeasurementReader(const std::string &file, const std::string &lilithDir)
+      : file_{file}, lilithDir_{lilithDir},
+        root_{XMLParser{ReadFile(file), file}.Parse()} {}
+
+  Measurement Read() {
+    if (root_.tag != "expmu")
+      Error("root tag is not <expmu>");
+    const auto *type = root_.Attribute("type");
+    if (!type)
+      Error("mandatory attribute \"type\" of <expmu> is not present");
+    const auto *dimAttr = root_.Attribute("dim");
+    if (!dimAttr)
+      Error("mandatory attribute \"dim\" of <expmu> is not present");
+    const auto dim = static_cast<int>(Number(*dimAttr, "dim"));
+    if (dim <= 0)
+      Error("attribute dim is non-positive");
+    dim_ = static_cast<std::size_t>(dim);
+    if (const auto *decay = root_.Attribute("decay"))
+      decay_ = ToDecay(*decay);
+
+    Measurement m{file_, {}, {}, 125., Energy::lhc13};
+    std::string sqrts;
+    for (const auto &child : root_.children) {
+      if (child.tag == "mass" && !Trim(child.text).empty())
+        m.mass = Number(child.text, "<mass>");
+      else if (child.tag == "sqrts")
+        sqrts = Trim(child.text);
+    }
+    static const std::array<const char *, 8> run1{
+        "1.96", "7", "8", "7.", "8.", "7.0", "8.0", "7+8"};
+    if (std::find(run1.begin(), run1.end(), sqrts) != run1.end())
+      m.energy = Energy::run1;
+
+    m.axes = ReadEfficiencies(m.energy, m.mass);
+    if (*type == "f") {
+      m.type = ReadGrid();
+    } else {
+      ReadBestfit(m.axes);
+      if (*type == "n")
+        m.type = ReadNormal();
+      else if (*type == "vn")
+        m.type = ReadVarNormal();
+      else if (*type == "p")
+        m.type = ReadPoisson();
+      else
+        Error("unknown type \"" + *type + "\"");
+    }
+    return m;
+  }
+
+private:
+  const std::string &file_;
+  const std::string &lilithDir_;
+  Element root_;
+  std::size_t dim_ = 0;
+  std::optional<Decay> decay_;
+
+  [[noreturn]] void Error(const std::string &message) const {
+    throw(std::runtime_error("Invalid Lilith input " + file_ + ": " +
+                             message));
+  }
+
+  double Number(const std::string &text, const std::string &what) const {
+    const auto trimmed = Trim(text);
+    if (trimmed.empty())
+      return 0.;
+    char *end;
+    const double result = std::strtod(trimmed.c_str(), &end);
+    if (end != trimmed.c_str() + trimmed.size())
+      Error("value of " + what + " is not a number");
+    return result;
+  }
+
+  const std::string &RequireAttribute(const Element &el,
+                                      const std::string &name) const {
+    if (const auto *value = el.Attribute(name))
+      return *value;
+    Error("mandatory attribute \"" + name + "\" of <" + el.tag +
+          "> is not present");
+  }
+
+  Decay ToDecay(const std::string &name) const {
+    const auto it = decays.find(name);
+    if (it == decays.end())
+      Error("unknown decay \"" + name + "\"");
+    return it->second;
+  }
+
+  //! the axis labels x, y for up to two dimensions and d1, d2... otherwise
+  std::vector<std::string> AxisLabels() const {
+    if (dim_ == 1)
+      return {"x"};
+    if (dim_ == 2)
+      return {"x", "y"};
+    auto labels = std::vector<std::string>{};
+    for (std::size_t i = 1; i <= dim_; ++i)
+      labels.push_back("d" + std::to_string(i));
+    return labels;
+  }
+
+  std::size_t AxisIndex(const std::string &label) const {
+    const auto labels = AxisLabels();
+    const auto it = std::find(labels.begin(), labels.end(), label);
+    if (it == labels.end())
+      Error("unknown axis \"" + label + "\"");
+    return static_cast<std::size_t>(it - labels.begin());
+  }
+
+  std::vector<Axis> ReadEfficiencies(Energy energy, double mass) const {
+    using Label = std::pair<std::string, Decay>;
+    auto effs = std::vector<std::map<Label, double>>(dim_);
+    for (const auto &child : root_.children) {
+      if (child.tag != "eff")
+        continue;
+      const auto axis =
+          dim_ == 1 ? 0 : AxisIndex(RequireAttribute(child, "axis"));
+      const auto &prod = RequireAttribute(child, "prod");
+      if (!productions.count(prod) && !multiOverlaps.count(prod))
+        Error("unknown production \"" + prod + "\"");
+      const auto decay =
+          decay_ ? *decay_ : ToDecay(RequireAttribute(child, "decay"));
+      effs[axis][{prod, decay}] = Number(child.text, "<eff>");
+    }
+
+    const auto &ratios = SharedCxnRatios(energy, lilithDir_);
+    auto axes = std::vector<Axis>(dim_);
+    for (std::size_t i = 0; i != dim_; ++i) {
+      auto resolved = std::map<std::pair<Production, Decay>, double>{};
+      for (const auto &[label, eff] : effs[i]) {
+        const auto &[prod, decay] = label;
+        const auto overlaps = multiOverlaps.find(prod);
+        if (overlaps == multiOverlaps.end()) {
+          resolved[{productions.at(prod), decay}] = eff;
+          continue;
+        }
+        for (const auto &other : overlaps->second)
+          if (effs[i].count({other, decay}))
+            Error("<eff> tags for \"" + other + "\" and \"" + prod +
+                  "\" cannot both be defined");
+        for (const auto &[single, fraction] : MultiProd(prod, ratios, mass)) {
+          for (const auto &[name, p] : productions)
+            if (p == single && effs[i].count({name, decay}))
+              Error("<eff> tags for \"" + name + "\" and \"" + prod +
+                    "\" cannot both be defined");
+          resolved[{single, decay}] = eff * fraction;
+        }
+      }
+
+      double sum = 0.;
+      for (const auto &[label, eff] : resolved) {
+        axes[i].efficiencies.emplace_back(
+            SignalStrengths::Index(label.first, label.second, energy), eff);
+        sum += eff;
+      }
+      if (sum == 0.)
+        Error("no <eff> tag found for axis " + AxisLabels()[i]);
+      if (sum > 1.01)
+        Error("the sum of efficiencies for axis " + AxisLabels()[i] +
+              " is greater than 1");
+    }
+    return axes;
+  }
+
+  const Element &Child(const std::string &tag) const {
+    for (const auto &child : root_.children)
+      if (child.tag == tag)
+        return child;
+    Error("no <" + tag + "> block");
+  }
+
+  void ReadBestfit(std::vector<Axis> &axes) const {
+    const auto &bestfit = Child("bestfit");
+    if (dim_ == 1) {
+      axes[0].bestfit = Number(bestfit.text, "<bestfit>");
+      return;
+    }
+    auto found = std::vector<bool>(dim_, false);
+    for (const auto &child : bestfit.children) {
+      const auto i = AxisIndex(child.tag);
+      axes[i].bestfit = Number(child.text, "<bestfit>");
+      found[i] = true;
+    }
+    if (std::find(found.begin(), found.end(), false) != found.end())
+      Error("best fit point should be specified for all axes");
+  }
+
+  //! the uncertainties as [axis][left, right] and correlations
+  struct Uncertainties {
+    std::vector<std::array<double, 2>> unc;
+    Eigen::MatrixXd corr;
+  };
+
+  Uncertainties ReadUncertainties() const {
+    const auto &param = Child("param");
+    const auto nan = std::numeric_limits<double>::quiet_NaN();
+    auto result = Uncertainties{std::vector<std::array<double, 2>>(
+                                    dim_, std::array{nan, nan}),
+                                Eigen::MatrixXd::Identity(dim_, dim_)};
+    auto corrFound = Eigen::MatrixXi::Identity(dim_, dim_).eval();
+    for (const auto &child : param.children) {
+      if (child.tag == "uncertainty") {
+        const double value = Number(child.text, "<uncertainty>");
+        const auto axis =
+            dim_ == 1 ? 0 : AxisIndex(RequireAttribute(child, "axis"));
+        const auto *side = child.Attribute("side");
+        if (!side && dim_ == 1)
+          result.unc[axis] = {value, value};
+        else if (side && *side == "left")
+          result.unc[axis][0] = value;
+        else if (side && *side == "right")
+          result.unc[axis][1] = value;
+        else
+          Error("side attribute of <uncertainty> is not left nor right");
+      } else if (child.tag == "correlation" && dim_ == 2) {
+        result.corr(0, 1) = result.corr(1, 0) =
+            Number(child.text, "<correlation>");
+        corrFound(0, 1) = corrFound(1, 0) = 1;
+      } else if (child.tag == "correlation" && dim_ > 2) {
+        const auto &entry = RequireAttribute(child, "entry");
+        const auto second = entry.find('d', 1);
+        if (entry.empty() || entry[0] != 'd' || second == std::string::npos)
+          Error("entry attribute of <correlation> is not correct");
+        const auto i = AxisIndex(entry.substr(0, second));
+        const auto j = AxisIndex(entry.substr(second));
+        if (i >= j)
+          Error("entry attribute of <correlation> is not correct");
+        result.corr(i, j) = result.corr(j, i) =
+            Number(child.text, "<correlation>");
+        corrFound(i, j) = corrFound(j, i) = 1;
+      } else {
+        Error("unexpected tag <" + child.tag + "> in block <param>");
+      }
+    }
+    for (std::size_t i = 0; i != dim_; ++i) {
+      if (std::isnan(result.unc[i][0]) || std::isnan(result.unc[i][1]))
+        Error("uncertainties are not given consistently in block <param>");
+      if (result.unc[i][0] == 0 && result.unc[i][1] == 0)
+        Error("uncertainties are all zero");
+    }
+    if (dim_ > 1 && corrFound.minCoeff() == 0)
+      Error("correlations are not given in block <param>");
+    return result;
+  }
+
+  LikelihoodType ReadNormal() const {
+    if (dim_ == 1) {
+      const auto u = ReadUncertainties();
+      return Normal1D{std::abs(u.unc[0][0]), u.unc[0][1]};
+    }
+    if (dim_ == 2) {
+      const auto &param = Child("param");
+      auto abc = std::map<std::string, double>{};
+      for (const auto &child : param.children) {
+        if (child.tag != "a" && child.tag != "b" && child.tag != "c")
+          Error("only <a>, <b> and <c> are allowed in block <param> in 2D "
+                "normal mode");
+        abc[child.tag] = Number(child.text, "<" + child.tag + ">");
+      }
+      if (abc.size() != 3)
+        Error("a, b, c tags are not given in block <param>");
+      return Normal2D{abc["a"], abc["b"], abc["c"]};
+    }
+    const auto u = ReadUncertainties();
+    auto sym = Eigen::VectorXd(dim_);
+    for (std::size_t i = 0; i != dim_; ++i)
+      sym(i) = (u.unc[i][1] + std::abs(u.unc[i][0])) / 2;
+    const Eigen::MatrixXd cov = sym.asDiagonal() * u.corr * sym.asDiagonal();
+    return NormalND{cov.inverse()};
+  }
+
+  LikelihoodType ReadVarNormal() const {
+    const auto u = ReadUncertainties();
+    if (dim_ == 1)
+      return VarNormal1D{std::abs(u.unc[0][0]), u.unc[0][1]};
+    if (dim_ == 2) {
+      CheckCorrelation(u.corr(0, 1));
+      return VarNormal2D{{std::abs(u.unc[0][0]), std::abs(u.unc[1][0])},
+                         {u.unc[0][1], u.unc[1][1]},
+                         u.corr(0, 1)};
+    }
+    auto result = VarNormalND{Eigen::VectorXd(dim_), Eigen::VectorXd(dim_),
+                              u.corr.inverse()};
+    for (std::size_t i = 0; i != dim_; ++i) {
+      result.v(i) = u.unc[i][1] * std::abs(u.unc[i][0]);
+      result.vPrime(i) = u.unc[i][1] - std::abs(u.unc[i][0]);
+    }
+    return result;
+  }
+
+  LikelihoodType ReadPoisson() const {
+    if (dim_ > 2)
+      Error("type p is only supported in one and two dimensions");
+    const auto u = ReadUncertainties();
+    auto gamma = std::array<double, 2>{};
+    auto nu = std::array<double, 2>{};
+    for (std::size_t i = 0; i != dim_; ++i) {
+      const double sigm = std::abs(u.unc[i][0]);
+      const double sigp = u.unc[i][1];
+      gamma[i] = BifurcationGamma(sigm, sigp);
+      nu[i] = 0.5 / (gamma[i] * sigp - std::log(1 + gamma[i] * sigp));
+    }
+    if (dim_ == 1)
+      return Poisson1D{gamma[0], nu[0]};
+    CheckCorrelation(u.corr(0, 1));
+    return Poisson2D{gamma, nu, PoissonCorrelation(u.corr(0, 1), nu[0], nu[1])};
+  }
+
+  void CheckCorrelation(double corr) const {
+    if (std::abs(corr) == 1)
+      Error("correlation is (minus) unity, cannot handle this case");
+  }
+
+  //! solves the bifurcation equation for \f$ \gamma \f$ like Lilith
+  static double BifurcationGamma(double m, double p) {
+    double a = 0.;
+    double b = 1. / m;
+    for (int i = 0; i != 1000; ++i) {
+      const double x = (a + b) / 2;
+      if (std::exp(-x * (m + p)) <= (1 - m * x) / (1 + p * x))
+        a = x;
+      else
+        b = x;
+    }
+    return a;
+  }
+
+  //! solves the equation for the correlation parameter \f$ A \f$ of the 2D
+  //! Poisson likelihood with Newton's method starting from zero
+  double PoissonCorrelation(double corr, double nu1, double nu2) const {
+    double y = 0.;
+    for (int i = 0; i != 100; ++i) {
+      const double e = std::exp(nu1 * y * y);
+      const double root = std::sqrt(nu1 * nu2 * (1 + nu2 * (e - 1)));
+      const double f = nu1 * nu2 * y - corr * root;
+      const double df =
+          nu1 * nu2 - corr * nu1 * nu1 * nu2 * nu2 * y * e / root;
+      const double step = f / df;
+      y -= step;
+      if (!std::isfinite(y))
+        break;
+      if (std::abs(step) <= 1e-15 * std::max(1., std::abs(y)))
+        return y;
+    }
+    Error("could not solve for the correlation of the Poisson likelihood");
+  }
+
+  LikelihoodType ReadGrid() const {
+    if (dim_ > 2)
+      Error("type f is only supported in one and two dimensions");
+    std::istringstream in{Child("grid").text};
+    std::string line;
+    auto x = std::vector<double>{};
+    auto y = std::vector<double>{};
+    auto values = std::vector<std::vector<double>>{};
+    while (std::getline(in, line)) {
+      if (Trim(line).empty())
+        continue;
+      std::istringstream ls{line};
+      auto entries = std::vector<double>{};
+      std::string entry;
+      while (ls >> entry)
+        entries.push_back(Number(entry, "<grid>"));
+      if (entries.size() != dim_ + 1)
+        Error("incorrect <grid> entry on line \"" + line + "\"");
+      // like Lilith, keep the first value for repeated points in 1D
+      const auto ix = std::find(x.begin(), x.end(), entries[0]) - x.begin();
+      if (static_cast<std::size_t>(ix) == x.size()) {
+        x.push_back(entries[0]);
+        values.emplace_back();
+      } else if (dim_ == 1) {
+        continue;
+      }
+      if (dim_ == 2 && std::find(y.begin(), y.end(), entries[1]) == y.end())
+        y.push_back(entries[1]);
+      values[ix].push_back(entries[dim_]);
+    }
+
+    if (dim_ == 1) {
+      auto l = std::vector<double>{};
+      for (const auto &v : values)
+        l.push_back(v[0]);
+      return Full1D{{Tools::UniformGrid{x}, l,
+                     Tools::UniformSpline::Boundary::notAKnot}};
+    }
+    auto l = std::vector<double>{};
+    for (const auto &v : values) {
+      if (v.size() != y.size())
+        Error("the <grid> is not rectangular");
+      l.insert(l.end(), v.begin(), v.end());
+    }
+    return Full2D{{Tools::UniformGrid{x}, Tools::UniformGrid{y}, l,
+                   Tools::UniformSpline::Boundary::notAKnot}};
+  }
+};
+
+// ------------------------------- likelihoods -------------------------------
+
+//! \f$ -2\log L \f$ for the deviations d from the best fit
+struct Evaluate {
+  const Eigen::VectorXd &d;
+
+  double operator()(const Normal1D &l) const {
+    const double unc = d(0) < 0 ? l.left : l.right;
+    return d(0) * d(0) / (unc * unc);
+  }
+
+  double operator()(const Normal2D &l) const {
+    return l.a * d(0) * d(0) + l.c * d(1) * d(1) + 2 * l.b * d(0) * d(1);
+  }
+
+  double operator()(const NormalND &l) const { return d.dot(l.invCov * d); }
+
+  double operator()(const VarNormal1D &l) const {
+    if (l.left == 0)
+      return d(0) / l.right;
+    if (l.right == 0)
+      return -d(0) / l.left;
+    return d(0) * d(0) / (l.left * l.right + (l.right - l.left) * d(0));
+  }
+
+  double operator()(const VarNormal2D &l) const {
+    const double v1 = l.right[0] * l.left[0] + (l.right[0] - l.left[0]) * d(0);
+    const double v2 = l.right[1] * l.left[1] + (l.right[1] - l.left[1]) * d(1);
+    return 1. / (1 - l.corr * l.corr) *
+           (d(0) * d(0) / v1 - 2 * l.corr * d(0) * d(1) / std::sqrt(v1 * v2) +
+            d(1) * d(1) / v2);
+  }
+
+  double operator()(const VarNormalND &l) const {
+    const Eigen::VectorXd u =
+        d.array() / (l.v.array() + l.vPrime.array() * d.array()).sqrt();
+    return u.dot(l.invCorr * u);
+  }
+
+  double operator()(const Poisson1D &l) const {
+    const double alpha = l.nu * l.gamma;
+    return -2. * (-alpha * d(0) + l.nu * std::log(1 + alpha * d(0) / l.nu));
+  }
+
+  double operator()(const Poisson2D &l) const {
+    const double alpha1 = l.nu[0] * l.gamma[0];
+    const double alpha2 = l.nu[1] * l.gamma[1];
+    const double alphaCorr = std::log(1 + l.aCorr);
+    const double t1 =
+        -alpha1 * d(0) + l.nu[0] * std::log(1 + alpha1 * d(0) / l.nu[0]);
+    const double t2a = -alpha2 * (d(1) + 1 / l.gamma[1]) *
+                       std::exp(alphaCorr * l.nu[0] -
+                                l.aCorr * alpha1 * (d(0) + 1 / l.gamma[0]));
+    const double t2b =
+        -alpha2 / l.gamma[1] *
+        std::exp(alphaCorr * l.nu[0] - l.aCorr * alpha1 / l.gamma[0]);
+    const double t2c = l.nu[1] * std::log(t2a / t2b);
+    return -2. * (t1 + t2a - t2b + t2c);
+  }
+
+  double operator()(const Full1D &l) const {
+    const double result = l.spline(d(0));
+    return result < 0 ? 0. : result;
+  }
+
+  double operator()(const Full2D &l) const {
+    const double result = l.spline(d(0), d(1));
+    return result < 0 ? 0. : result;
+  }
+};
+} // namespace
+
+void SignalStrengths::Set(Production prod, Decay decay, double value) noexcept {
+  (*this)(prod, decay, Energy::run1) = value;
+  (*this)(prod, decay, Energy::lhc13) = value;
+}
+
+SignalStrengths SignalStrengths::SMLike() noexcept {
+  auto result = SignalStrengths{};
+  result.mu.fill(1.);
+  for (std::size_t e = 0; e != nEnergies; ++e)
+    for (std::size_t p = 0; p != nProductions; ++p)
+      result(static_cast<Production>(p), Decay::invisible,
+             static_cast<Energy>(e)) = 0.;
+  return result;
+}
+
+SignalStrengths &
+SignalStrengths::operator+=(const SignalStrengths &other) noexcept {
+  for (std::size_t i = 0; i != mu.size(); ++i)
+    mu[i] += other.mu[i];
+  return *this;
+}
+
+double Measurement::operator()(const SignalStrengths &mu) const {
+  auto d = Eigen::VectorXd(axes.size());
+  for (std::size_t i = 0; i != axes.size(); ++i)
+    d(i) = axes[i].Mu(mu) - axes[i].bestfit;
+  return std::visit(Evaluate{d}, type);
+}
+
+Measurement ReadMeasurement(const std::string &file,
+                            const std::string &lilithDir) {
+  return MeasurementReader{file, lilithDir}.Read();
+}
+
+Likelihood::Likelihood(std::vector<Measurement> measurements)
+    : measurements_{std::move(measurements)} {}
+
+Likelihood Likelihood::FromList(const std::string &listFile,
+                                const std::string &lilithDir) {
+  std::istringstream in{ReadFile(listFile)};
+  const auto dir = std::filesystem::path{listFile}.parent_path();
+  auto measurements = std::vector<Measurement>{};
+  std::string line;
+  while (std::getline(in, line)) {
+    line = Trim(line.substr(0, line.find('#')));
+    if (line.empty())
+      continue;
+    const auto path = std::filesystem::path{line};
+    measurements.push_back(
+        ReadMeasurement(path.is_absolute() ? line : (dir / path).string(),
+                        lilithDir));
+  }
+  return Likelihood{std::move(measurements)};
+}
+
+double Likelihood::operator()(const SignalStrengths &mu) const {
+  double result = 0.;
+  for (const auto &m : measurements_)
+    result += m(mu);
+  return result;
+}
+
+std::vector<double>
+Likelihood::Contributions(const SignalStrengths &mu) const {
+  auto result = std::vector<double>{};
+  result.reserve(measurements_.size());
+  for (const auto &m : measurements_)
+    result.push_back(m(mu));
+  return result;
+}
+
+std::size_t Likelihood::NObservables() const noexcept {
+  std::size_t result = 0;
+  for (const auto &m : measurements_)
+    result += m.axes.size();
+  return result;
+}
+
+std::string DefaultDir() { return SCANNERS_LILITH_DIR; }
+
+std::string DefaultList(const std::string &lilithDir) {
+  return lilithDir + "/data/latest.list";
+}
+
+const Likelihood &SharedLikelihood(const std::string &input,
+                                   const std::string &lilithDir) {
+  static std::mutex mutex;
+  static std::map<std::pair<std::string, std::string>,
+                  std::unique_ptr<const Likelihood>>
+      instances;
+  const auto lock = std::lock_guard{mutex};
+  // databases do not depend on the grids
+  const bool database = IsDatabase(input);
+  auto &instance = instances[{input, database ? "" : lilithDir}];
+  if (!instance)
+    instance = std::make_unique<const Likelihood>(
+        database ? Likelihood::FromDatabase(input)
+                 : Likelihood::FromList(input, lilithDir));
+  return *instance;
+}
+
+} // namespace ScannerS::Interfaces::Lilith
@@ -0,0 +1,418 @@
+#include "ScannerS/Interfaces/Lilith.hpp"
+
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <ios>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <type_traits>
+#include <unistd.h>
+
+namespace ScannerS::Interfaces::Lilith {
+
+namespace {
+constexpr char magic[] = "LILITHDB";
+constexpr std::uint64_t byteOrderMark = 0x0102030405060708;
+constexpr std::size_t headerSize = 4; // words before the record offsets
+
+//! the type code of a LikelihoodType alternative
+template <class T, std::size_t i = 0> constexpr std::uint64_t TypeCode() {
+  if constexpr (std::is_same_v<std::variant_alternative_t<i, LikelihoodType>,
+                               T>)
+    return i;
+  else
+    return TypeCode<T, i + 1>();
+}
+
+std::uint64_t MagicWord() {
+  std::uint64_t result;
+  std::memcpy(&result, magic, sizeof(result));
+  return result;
+}
+
+//! appends values to a sequence of words
+class Writer {
+public:
+  std::vector<std::uint64_t> words;
+
+  void Word(std::uint64_t value) { words.push_back(value); }
+
+  void Value(double value) {
+    std::uint64_t word;
+    std::memcpy(&word, &value, sizeof(word));
+    words.push_back(word);
+  }
+
+  void Values(const double *values, std::size_t n) {
+    for (std::size_t i = 0; i != n; ++i)
+      Value(values[i]);
+  }
+
+  void String(const std::string &s) {
+    Word(s.size());
+    const std::size_t begin = words.size();
+    words.resize(begin + (s.size() + 7) / 8, 0);
+    std::memcpy(words.data() + begin, s.data(), s.size());
+  }
+
+  void Grid(const Tools::UniformGrid &grid) {
+    Values(grid.Points().data(), grid.Points().size());
+  }
+
+  // the likelihood parameters
+  void operator()(const Normal1D &l) {
+    Value(l.left);
+    Value(l.right);
+  }
+  void operator()(const Normal2D &l) {
+    Value(l.a);
+    Value(l.b);
+    Value(l.c);
+  }
+  void operator()(const NormalND &l) { Matrix(l.invCov); }
+  void operator()(const VarNormal1D &l) {
+    Value(l.left);
+    Value(l.right);
+  }
+  void operator()(const VarNormal2D &l) {
+    Values(l.left.data(), 2);
+    Values(l.right.data(), 2);
+    Value(l.corr);
+  }
+  void operator()(const VarNormalND &l) {
+    Values(l.v.data(), l.v.size());
+    Values(l.vPrime.data(), l.vPrime.size());
+    Matrix(l.invCorr);
+  }
+  void operator()(const Poisson1D &l) {
+    Value(l.gamma);
+    Value(l.nu);
+  }
+  void operator()(const Poisson2D &l) {
+    Values(l.gamma.data(), 2);
+    Values(l.nu.data(), 2);
+    Value(l.aCorr);
+  }
+  void operator()(const Full1D &l) {
+    Word(l.spline.Grid().Points().size());
+    Grid(l.spline.Grid());
+    for (const auto &co : l.spline.AllCoefficients()) {
+      Value(co.y);
+      Value(co.c);
+      Value(co.b);
+      Value(co.a);
+    }
+  }
+  void operator()(const Full2D &l) {
+    Word(l.spline.GridX().Points().size());
+    Word(l.spline.GridY().Points().size());
+    Grid(l.spline.GridX());
+    Grid(l.spline.GridY());
+    for (const auto &co : l.spline.AllCoefficients())
+      Values(co.data(), co.size());
+  }
+
+private:
+  void Matrix(const Eigen::MatrixXd &m) {
+    for (Eigen::Index i = 0; i != m.rows(); ++i)
+      for (Eigen::Index j = 0; j != m.cols(); ++j)
+        Value(m(i, j));
+  }
+};
+
+//! a database file memory mapped as a read-only sequence of words
+class MappedWords {
+public:
+  explicit MappedWords(const std::string &file) {
+    const int fd = open(file.c_str(), O_RDONLY);
+    if (fd < 0)
+      throw(std::runtime_error("Could not open Lilith database " + file));
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+      close(fd);
+      throw(std::runtime_error("Could not open Lilith database " + file));
+    }
+    const auto bytes = static_cast<std::size_t>(info.st_size);
+    if (bytes % sizeof(std::uint64_t) != 0) {
+      close(fd);
+      throw(std::runtime_error("Invalid Lilith database " + file +
+                               ": size is not a multiple of 8 bytes"));
+    }
+    // an empty file cannot be mapped and fails as a truncated database
+    void *map = nullptr;
+    if (bytes != 0)
+      map = mmap(nullptr, bytes, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED)
+      throw(std::runtime_error("Could not map Lilith database " + file));
+    words_ = static_cast<const std::uint64_t *>(map);
+    size_ = bytes / sizeof(std::uint64_t);
+  }
+
+  ~MappedWords() {
+    if (words_)
+      munmap(const_cast<std::uint64_t *>(words_),
+             size_ * sizeof(std::uint64_t));
+  }
+
+  MappedWords(const MappedWords &) = delete;
+  MappedWords &operator=(const MappedWords &) = delete;
+
+  const std::uint64_t *data() const noexcept { return words_; }
+  std::size_t size() const noexcept { return size_; }
+  std::uint64_t operator[](std::size_t i) const { return words_[i]; }
+
+private:
+  const std::uint64_t *words_ = nullptr;
+  std::size_t size_ = 0;
+};
+
+//! reads values from a sequence of words
+class Reader {
+public:
+  Reader(const MappedWords &words, const std::string &file, std::size_t pos,
+         std::size_t end)
+      : words_{words}, file_{file}, pos_{pos}, end_{end} {}
+
+  std::uint64_t Word() {
+    Require(1);
+    return words_[pos_++];
+  }
+
+  std::size_t Size() {
+    const auto result = Word();
+    Require(result);
+    return result;
+  }
+
+  double Value() {
+    double result;
+    const auto word = Word();
+    std::memcpy(&result, &word, sizeof(result));
+    return result;
+  }
+
+  std::vector<double> Values(std::size_t n) {
+    Require(n);
+    auto result = std::vector<double>(n);
+    std::memcpy(result.data(), words_.data() + pos_, n * sizeof(double));
+    pos_ += n;
+    return result;
+  }
+
+  template <std::size_t n> std::array<double, n> Array() {
+    auto result = std::array<double, n>{};
+    for (auto &x : result)
+      x = Value();
+    return result;
+  }
+
+  Eigen::VectorXd Vector(std::size_t n) {
+    auto result = Eigen::VectorXd(n);
+    for (std::size_t i = 0; i != n; ++i)
+      result(i) = Value();
+    return result;
+  }
+
+  Eigen::MatrixXd Matrix(std::size_t n) {
+    auto result = Eigen::MatrixXd(n, n);
+    for (std::size_t i = 0; i != n; ++i)
+      for (std::size_t j = 0; j != n; ++j)
+        result(i, j) = Value();
+    return result;
+  }
+
+  std::string String() {
+    const auto size = Word();
+    Require((size + 7) / 8);
+    auto result = std::string(size, '\0');
+    std::memcpy(result.data(), words_.data() + pos_, size);
+    pos_ += (size + 7) / 8;
+    return result;
+  }
+
+  Tools::UniformGrid Grid(std::size_t n) {
+    try {
+      return Tools::UniformGrid{Values(n)};
+    } catch (const std::runtime_error &e) {
+      Fail(e.what());
+    }
+  }
+
+  LikelihoodType Parameters(std::uint64_t type, std::size_t dim) {
+    switch (type) {
+    case TypeCode<Normal1D>():
+      Dimension(dim, 1);
+      return Normal1D{Value(), Value()};
+    case TypeCode<Normal2D>():
+      Dimension(dim, 2);
+      return Normal2D{Value(), Value(), Value()};
+    case TypeCode<NormalND>():
+      Dimension(dim, 3, true);
+      return NormalND{Matrix(dim)};
+    case TypeCode<VarNormal1D>():
+      Dimension(dim, 1);
+      return VarNormal1D{Value(), Value()};
+    case TypeCode<VarNormal2D>():
+      Dimension(dim, 2);
+      return VarNormal2D{Array<2>(), Array<2>(), Value()};
+    case TypeCode<VarNormalND>():
+      Dimension(dim, 3, true);
+      return VarNormalND{Vector(dim), Vector(dim), Matrix(dim)};
+    case TypeCode<Poisson1D>():
+      Dimension(dim, 1);
+      return Poisson1D{Value(), Value()};
+    case TypeCode<Poisson2D>():
+      Dimension(dim, 2);
+      return Poisson2D{Array<2>(), Array<2>(), Value()};
+    case TypeCode<Full1D>(): {
+      Dimension(dim, 1);
+      auto grid = Grid(Size());
+      const auto values = Values(4 * (grid.Points().size() + 1));
+      auto co = std::vector<Tools::UniformSpline::Coefficients>{};
+      for (std::size_t i = 0; i != values.size(); i += 4)
+        co.push_back({values[i], values[i + 1], values[i + 2], values[i + 3]});
+      return Full1D{Tools::UniformSpline{std::move(grid), std::move(co)}};
+    }
+    case TypeCode<Full2D>(): {
+      Dimension(dim, 2);
+      const std::size_t nx = Size();
+      const std::size_t ny = Size();
+      auto x = Grid(nx);
+      auto y = Grid(ny);
+      auto co = std::vector<Tools::UniformSpline2D::Coefficients>(
+          (nx + 1) * (ny + 1));
+      for (auto &cell : co)
+        cell = Array<16>();
+      return Full2D{
+          Tools::UniformSpline2D{std::move(x), std::move(y), std::move(co)}};
+    }
+    default:
+      Fail("unknown likelihood type " + std::to_string(type));
+    }
+  }
+
+  [[noreturn]] void Fail(const std::string &message) const {
+    throw(std::runtime_error("Invalid Lilith database " + file_ + ": " +
+                             message));
+  }
+
+  bool AtEnd() const noexcept { return pos_ == end_; }
+
+private:
+  void Require(std::size_t n) const {
+    if (n > end_ - pos_)
+      Fail("truncated record");
+  }
+
+  // the multi-dimensional types are only used for three or more axes
+  void Dimension(std::size_t dim, std::size_t expected,
+                 bool orMore = false) const {
+    if (dim != expected && !(orMore && dim > expected))
+      Fail("likelihood type of dimension " + std::to_string(expected) +
+           (orMore ? " or more" : "") + " for " + std::to_string(dim) +
+           " axes");
+  }
+
+  const MappedWords &words_;
+  const std::string &file_;
+  std::size_t pos_;
+  std::size_t end_;
+};
+
+} // namespace
+
+void WriteDatabase(const Likelihood &likelihood, const std::string &file) {
+  const auto &measurements = likelihood.Measurements();
+  auto out = Writer{};
+  out.Word(MagicWord());
+  out.Word(databaseVersion);
+  out.Word(byteOrderMark);
+  out.Word(measurements.size());
+  out.words.resize(headerSize + measurements.size() + 1);
+  for (std::size_t i = 0; i != measurements.size(); ++i) {
+    const auto &m = measurements[i];
+    out.words[headerSize + i] = out.words.size();
+    out.Word(m.type.index());
+    out.Word(static_cast<std::uint64_t>(m.energy));
+    out.Value(m.mass);
+    out.Word(m.axes.size());
+    out.String(m.source);
+    for (const auto &axis : m.axes) {
+      out.Value(axis.bestfit);
+      out.Word(axis.efficiencies.size());
+      for (const auto &[index, eff] : axis.efficiencies) {
+        out.Word(index);
+        out.Value(eff);
+      }
+    }
+    std::visit(out, m.type);
+  }
+  out.words[headerSize + measurements.size()] = out.words.size();
+
+  std::ofstream os{file, std::ios::binary};
+  os.write(reinterpret_cast<const char *>(out.words.data()),
+           static_cast<std::streamsize>(out.words.size() *
+                                        sizeof(std::uint64_t)));
+  if (!os)
+    throw(std::runtime_error("Could not write Lilith database " + file));
+}
+
+bool IsDatabase(const std::string &file) {
+  std::ifstream in{file, std::ios::binary};
+  char start[sizeof(magic) - 1];
+  return in.read(start, sizeof(start)) &&
+         std::memcmp(start, magic, sizeof(start)) == 0;
+}
+
+Likelihood Likelihood::FromDatabase(const std::string &file) {
+  const auto words = MappedWords{file};
+  auto header = Reader{words, file, 0, words.size()};
+  if (header.Word() != MagicWord())
+    header.Fail("not a database");
+  if (const auto version = header.Word(); version != databaseVersion)
+    header.Fail("version " + std::to_string(version) + " instead of " +
+                std::to_string(databaseVersion));
+  if (header.Word() != byteOrderMark)
+    header.Fail("wrong byte order");
+  const std::size_t n = header.Size();
+  auto offsets = std::vector<std::size_t>(n + 1);
+  for (auto &offset : offsets)
+    offset = header.Word();
+  if (offsets.back() != words.size())
+    header.Fail("wrong file size");
+
+  auto measurements = std::vector<Measurement>(n);
+  for (std::size_t i = 0; i != n; ++i) {
+    if (offsets[i] < headerSize + n + 1 || offsets[i] > offsets[i + 1])
+      header.Fail("invalid record offsets");
+    auto in = Reader{words, file, offsets[i], offsets[i + 1]};
+    auto &m = measurements[i];
+    const auto type = in.Word();
+    const auto energy = in.Word();
+    if (energy >= nEnergies)
+      in.Fail("unknown energy " + std::to_string(energy));
+    m.energy = static_cast<Energy>(energy);
+    m.mass = in.Value();
+    m.axes.resize(in.Size());
+    m.source = in.String();
+    for (auto &axis : m.axes) {
+      axis.bestfit = in.Value();
+      axis.efficiencies.resize(in.Size());
+      for (auto &[index, eff] : axis.efficiencies) {
+        index = in.Word();
+        if (index >= std::tuple_size_v<decltype(SignalStrengths::mu)>)
+          in.Fail("invalid signal strength index in " + m.source);
+        eff = in.Value();
+      }
+    }
+    m.type = in.Parameters(type, m.axes.size());
+    if (!in.AtEnd())
+      in.Fail("unexpected data after " + m.source);
+  }
+  return Likelihood{std::move(measurements)};
+}
+
+} // namespace ScannerS::Interfaces::Lilith
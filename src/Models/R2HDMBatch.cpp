@@ -0,0 +1,107 @@
+#include "ScannerS/Constants.hpp"
+#include "ScannerS/Constraints/STU.hpp"
+#include "ScannerS/Models/R2HDM.hpp"
+#include <cmath>
+#include <complex>
+#include <cstddef>
+
+namespace ScannerS::Models {
+
+R2HDM::AngleInput R2HDM::ToAngleInput(const PhysicalInput &in) {
+  return {in.mHa,
+          in.mHb,
+          in.mA,
+          in.mHp,
+          std::atan(in.tbeta) - std::asin(in.c_HbVV),
+          in.tbeta,
+          in.m12sq,
+          in.type,
+          in.v};
+}
+
+R2HDM::Potential R2HDM::PotentialParameters(double mHl, double mHh,
+                                             double mA, double mHp,
+                                             double alpha, double tbeta,
+                                             double m12sq, double v) {
+  const double cb = 1. / std::sqrt(1. + tbeta * tbeta);
+  const double sb = tbeta * cb;
+  const double ca = std::cos(alpha);
+  const double sa = std::sin(alpha);
+  const double vsq = v * v;
+  const double mhsq = mHl * mHl;
+  const double mHsq = mHh * mHh;
+  const double mAsq = mA * mA;
+  const double mHpsq = mHp * mHp;
+  const double Msq = m12sq / sb / cb;
+
+  Potential res;
+  res.L[0] =
+      (mHsq * ca * ca + mhsq * sa * sa - Msq * sb * sb) / (vsq * cb * cb);
+  res.L[1] =
+      (mHsq * sa * sa + mhsq * ca * ca - Msq * cb * cb) / (vsq * sb * sb);
+  res.L[2] = ((mHsq - mhsq) * sa * ca / (sb * cb) + 2 * mHpsq - Msq) / vsq;
+  res.L[3] = (Msq + mAsq - 2 * mHpsq) / vsq;
+  res.L[4] = (Msq - mAsq) / vsq;
+
+  const double L345 = res.L[2] + res.L[3] + res.L[4];
+  res.m11sq = m12sq * tbeta - vsq / 2. * (res.L[0] * cb * cb + L345 * sb * sb);
+  res.m22sq = m12sq / tbeta - vsq / 2. * (res.L[1] * sb * sb + L345 * cb * cb);
+  return res;
+}
+
+void R2HDM::FillBatch(const std::vector<AngleInput> &in, BatchColumns &cols) {
+  const size_t n = in.size();
+  for (auto *col : {&cols.mHl, &cols.mHh, &cols.mA, &cols.mHp, &cols.tbeta,
+                    &cols.m12sq, &cols.alpha, &cols.L[0], &cols.L[1],
+                    &cols.L[2], &cols.L[3], &cols.L[4], &cols.m11sq,
+                    &cols.m22sq, &cols.v})
+    col->resize(n);
+  cols.type.resize(n);
+
+  // gather and order the CP-even states, H_a is always the heavy state for
+  // the input angle
+  for (size_t i = 0; i != n; ++i) {
+    const bool inverted = in[i].mHa < in[i].mHb;
+    cols.mHl[i] = inverted ? in[i].mHa : in[i].mHb;
+    cols.mHh[i] = inverted ? in[i].mHb : in[i].mHa;
+    double alpha = inverted ? in[i].alpha + Constants::pi / 2. : in[i].alpha;
+    if (alpha >= Constants::pi / 2.)
+      alpha -= Constants::pi;
+    cols.alpha[i] = alpha;
+    cols.mA[i] = in[i].mA;
+    cols.mHp[i] = in[i].mHp;
+    cols.tbeta[i] = in[i].tbeta;
+    cols.m12sq[i] = in[i].m12sq;
+    cols.type[i] = in[i].type;
+    cols.v[i] = in[i].v;
+  }
+
+  for (size_t i = 0; i != n; ++i) {
+    const auto pot = PotentialParameters(
+        cols.mHl[i], cols.mHh[i], cols.mA[i], cols.mHp[i], cols.alpha[i],
+        cols.tbeta[i], cols.m12sq[i], cols.v[i]);
+    for (size_t j = 0; j != pot.L.size(); ++j)
+      cols.L[j][i] = pot.L[j];
+    cols.m11sq[i] = pot.m11sq;
+    cols.m22sq[i] = pot.m22sq;
+  }
+}
+
+Constraints::STUDetail::FixedSTUParameters<2, 4, 2>
+R2HDM::STUInput(const BatchColumns &cols, size_t i) {
+  const double ca = std::cos(cols.alpha[i]);
+  const double sa = std::sin(cols.alpha[i]);
+  const double cb = 1. / std::sqrt(1. + cols.tbeta[i] * cols.tbeta[i]);
+  const double sb = cols.tbeta[i] * cb;
+  constexpr auto I = std::complex<double>{0., 1.};
+
+  Constraints::STUDetail::FixedSTUParameters<2, 4, 2> in;
+  // neutral states (G0, Hl, Hh, A) and charged states (G+, H+)
+  in.mV << I * cb, -sa, ca, -I * sb, I * sb, ca, sa, I * cb;
+  in.mU << cb, -sb, sb, cb;
+  in.mHzero = {cols.mHl[i], cols.mHh[i], cols.mA[i]};
+  in.mHcharged = {cols.mHp[i]};
+  return in;
+}
+
+} // namespace ScannerS::Models
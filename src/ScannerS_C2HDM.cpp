@@ -4,17 +4,21 @@
 #include "ScannerS/Constraints/Constraint.hpp"
 #include "ScannerS/Constraints/ElectronEDM.hpp"
 #include "ScannerS/Constraints/Higgs.hpp"
+#include "ScannerS/Constraints/HiggsPreScreen.hpp"
+#include "ScannerS/Constraints/Lilith.hpp"
 #include "ScannerS/Constraints/STU.hpp"
 #include "ScannerS/Constraints/Unitarity.hpp"
 #include "ScannerS/Core.hpp"
+#include "ScannerS/Interfaces/Lilith.hpp"
 #include "ScannerS/Models/C2HDM.hpp"
+#include <iostream>
 #ifdef BSMPT_FOUND
 #include "ScannerS/Constraints/EWPT.hpp"
 #endif
 
 using namespace ScannerS;
 
-int main(int argc, char *argv[]) {
+int Run(int argc, char *argv[]) {
   using Model = Models::C2HDM;
   ScannerSSetup<Model> scanners(argc, argv);
   scanners.AddParameters({"mHa", "mHb", "mHp", "tbeta", "c_HaVV_sq",
@@ -22,7 +26,8 @@ int main(int argc, char *argv[]) {
   scanners.AddConstraints<Constraints::BFB, Constraints::Unitarity,
                           Constraints::AbsoluteStability, Constraints::BPhysics,
                           Constraints::STU, Constraints::ElectronEDM,
-                          Constraints::Higgs>();
+                          Constraints::Higgs, Constraints::HiggsPreScreen,
+                          Constraints::Lilith>();
 #ifdef BSMPT_FOUND
   scanners.AddConstraints<Constraints::EWPT>();
 #endif
@@ -36,7 +41,16 @@ int main(int argc, char *argv[]) {
   auto stu = scanners.GetConstraint<Constraints::STU>();
   auto edm = scanners.GetConstraint<Constraints::ElectronEDM>();
   // the argument sets the chisq cut value
-  auto higgs = scanners.GetConstraint<Constraints::Higgs>(Constants::chisq2Sigma2d);
+  auto higgs = scanners.GetConstraint<Constraints::Higgs>(
+      Constants::chisq2Sigma2d, scanners.higgsCacheSize,
+      scanners.higgsCacheQuantization, scanners.hbExperiments);
+  // the pre-screen uses the same chisq cut plus a configurable margin
+  auto prescreen = scanners.GetConstraint<Constraints::HiggsPreScreen>(
+      Constants::chisq2Sigma2d, scanners.preScreenMargin, scanners.lilithDir);
+  // the native Lilith likelihood as an alternative rate constraint
+  auto lilith = scanners.GetConstraint<Constraints::Lilith>(
+      Constants::chisq2Sigma2d,
+      Interfaces::Lilith::DefaultList(scanners.lilithDir), scanners.lilithDir);
 #ifdef BSMPT_FOUND
   auto ewpt = scanners.GetConstraint<Constraints::EWPT>();
 #endif
@@ -61,6 +75,7 @@ int main(int argc, char *argv[]) {
       return -1;
     };
 
+    auto surrogate = scanners.GetSurrogate();
     size_t n = 0;
     while (n < scanners.npoints) {
       Model::PhysicalInput in{mHa(scanners.rGen),
@@ -79,18 +94,23 @@ int main(int argc, char *argv[]) {
           stu(p)) {
         Model::CalcCouplings(p); // now we need the couplings
         if (edm(p)) {
+          if (!prescreen(p) || !surrogate.Evaluate<Model>(p, scanners.rGen))
+            continue; // predicted to fail the Higgs constraint
           Model::RunHdecay(p); // for higgs we need the BR
-          if (higgs(p)
+          if (surrogate.Record(higgs, p) && lilith(p)
 #ifdef BSMPT_FOUND
               && ewpt(p)
 #endif
           ) {
             Model::CalcCXNs(p); // we want the 13TeV cxns in the output
+            scanners.StoreJacobian(p.data);
             out(p, n++);
           }
         }
       }
     }
+    surrogate.PrintStatistics(std::cout);
+    higgs.PrintStatistics(std::cout);
     return 0;
   }
   case RunMode::check: {
@@ -110,7 +130,7 @@ int main(int argc, char *argv[]) {
         Model::CalcCouplings(p); // now we need the couplings
         if (edm(p)) {
           Model::RunHdecay(p); // for higgs we need the BR
-          if (higgs(p)
+          if (higgs(p) && lilith(p)
 #ifdef BSMPT_FOUND
               && ewpt(p)
 #endif
@@ -125,3 +145,5 @@ int main(int argc, char *argv[]) {
   }
   }
 }
+
+int main(int argc, char *argv[]) { return RunCampaign(argc, argv, Run); }
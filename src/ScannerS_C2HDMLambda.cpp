@@ -0,0 +1,143 @@
+#include "ScannerS/Constraints/AbsoluteStability.hpp"
+#include "ScannerS/Constraints/BFB.hpp"
+#include "ScannerS/Constraints/BPhysics.hpp"
+#include "ScannerS/Constraints/Constraint.hpp"
+#include "ScannerS/Constraints/ElectronEDM.hpp"
+#include "ScannerS/Constraints/Higgs.hpp"
+#include "ScannerS/Constraints/HiggsPreScreen.hpp"
+#include "ScannerS/Constraints/Lilith.hpp"
+#include "ScannerS/Constraints/STU.hpp"
+#include "ScannerS/Constraints/Unitarity.hpp"
+#include "ScannerS/Core.hpp"
+#include "ScannerS/Interfaces/Lilith.hpp"
+#include "ScannerS/Models/C2HDM.hpp"
+#include "ScannerS/Tools/LambdaBasis.hpp"
+#include <iostream>
+#ifdef BSMPT_FOUND
+#include "ScannerS/Constraints/EWPT.hpp"
+#endif
+
+using namespace ScannerS;
+
+int Run(int argc, char *argv[]) {
+  using Model = Models::C2HDM;
+  ScannerSSetup<Model> scanners(argc, argv);
+  scanners.AddParameters({"L1", "L2", "L3", "L4", "L5r", "L5i", "tbeta",
+                          "re_m12sq", "type"});
+  scanners.AddConstraints<Constraints::BFB, Constraints::Unitarity,
+                          Constraints::AbsoluteStability, Constraints::BPhysics,
+                          Constraints::STU, Constraints::ElectronEDM,
+                          Constraints::Higgs, Constraints::HiggsPreScreen,
+                          Constraints::Lilith>();
+#ifdef BSMPT_FOUND
+  scanners.AddConstraints<Constraints::EWPT>();
+#endif
+  auto mode = scanners.Parse();
+  auto out = scanners.GetOutput();
+
+  auto bfb = scanners.GetConstraint<Constraints::BFB>();
+  auto uni = scanners.GetConstraint<Constraints::Unitarity>();
+  auto stab = scanners.GetConstraint<Constraints::AbsoluteStability>();
+  auto bphys = scanners.GetConstraint<Constraints::BPhysics>();
+  auto stu = scanners.GetConstraint<Constraints::STU>();
+  auto edm = scanners.GetConstraint<Constraints::ElectronEDM>();
+  // the argument sets the chisq cut value
+  auto higgs = scanners.GetConstraint<Constraints::Higgs>(
+      Constants::chisq2Sigma2d, scanners.higgsCacheSize,
+      scanners.higgsCacheQuantization, scanners.hbExperiments);
+  // the pre-screen uses the same chisq cut plus a configurable margin
+  auto prescreen = scanners.GetConstraint<Constraints::HiggsPreScreen>(
+      Constants::chisq2Sigma2d, scanners.preScreenMargin, scanners.lilithDir);
+  // the native Lilith likelihood as an alternative rate constraint
+  auto lilith = scanners.GetConstraint<Constraints::Lilith>(
+      Constants::chisq2Sigma2d,
+      Interfaces::Lilith::DefaultList(scanners.lilithDir), scanners.lilithDir);
+#ifdef BSMPT_FOUND
+  auto ewpt = scanners.GetConstraint<Constraints::EWPT>();
+#endif
+
+  scanners.PrintConfig(mode);
+  switch (mode) {
+  case RunMode::scan: {
+    auto L1 = scanners.GetDoubleParameter("L1");
+    auto L2 = scanners.GetDoubleParameter("L2");
+    auto L3 = scanners.GetDoubleParameter("L3");
+    auto L4 = scanners.GetDoubleParameter("L4");
+    auto L5r = scanners.GetDoubleParameter("L5r");
+    auto L5i = scanners.GetDoubleParameter("L5i");
+    auto tbeta = scanners.GetDoubleParameter("tbeta");
+    auto re_m12sq = scanners.GetDoubleParameter("re_m12sq");
+    auto type = scanners.GetIntParameter("type");
+
+    // samples L2, ..., L5i, tbeta and re_m12sq uniformly and solves for L1
+    // such that one neutral scalar has the observed Higgs mass, keeping only
+    // points allowed by BFB and unitarity. Its density is not known, so unlike
+    // the other scans no jacobian is stored.
+    auto sampler = Tools::LambdaBasis::FixedMassSampler<Model>(
+        {L1.a(), L2.a(), L3.a(), L4.a(), L5r.a(), L5i.a()},
+        {L1.b(), L2.b(), L3.b(), L4.b(), L5r.b(), L5i.b()},
+        {tbeta.a(), tbeta.b()}, {re_m12sq.a(), re_m12sq.b()},
+        Constraints::Higgs<Model>::mhref);
+
+    auto surrogate = scanners.GetSurrogate();
+    size_t n = 0;
+    while (n < scanners.npoints) {
+      auto in = Tools::LambdaBasis::C2HDMInput(sampler(
+          scanners.rGen, static_cast<Model::Yuk>(type(scanners.rGen))));
+      Model::ParameterPoint p{*in};
+      if (Model::Valid(p) && uni(p) && bfb(p) && stab(p) && bphys(p) &&
+          stu(p)) {
+        Model::CalcCouplings(p); // now we need the couplings
+        if (edm(p)) {
+          if (!prescreen(p) || !surrogate.Evaluate<Model>(p, scanners.rGen))
+            continue; // predicted to fail the Higgs constraint
+          Model::RunHdecay(p); // for higgs we need the BR
+          if (surrogate.Record(higgs, p) && lilith(p)
+#ifdef BSMPT_FOUND
+              && ewpt(p)
+#endif
+          ) {
+            Model::CalcCXNs(p); // we want the 13TeV cxns in the output
+            out(p, n++);
+          }
+        }
+      }
+    }
+    surrogate.PrintStatistics(std::cout);
+    higgs.PrintStatistics(std::cout);
+    return 0;
+  }
+  case RunMode::check: {
+    auto points = scanners.GetInput(
+        {"mH1", "mH2", "mHp", "a1", "a2", "a3", "tbeta", "m12sqr", "yuktype"});
+    std::vector<double> param;
+    std::string pId;
+    while (points.GetPoint(pId, param)) {
+      Model::AngleInput in{
+          param[0],      param[1], param[2],
+          param[3],      param[4], param[5],
+          param[6],      param[7], static_cast<Model::Yuk>(param[8]),
+          Constants::vEW};
+      Model::ParameterPoint p{in};
+      if (Model::Valid(p) && uni(p) && bfb(p) && stab(p) && bphys(p) &&
+          stu(p)) {
+        Model::CalcCouplings(p); // now we need the couplings
+        if (edm(p)) {
+          Model::RunHdecay(p); // for higgs we need the BR
+          if (higgs(p) && lilith(p)
+#ifdef BSMPT_FOUND
+              && ewpt(p)
+#endif
+          ) {
+            Model::CalcCXNs(p); // we want the 13TeV cxns in the output
+            out(p, pId);
+          }
+        }
+      }
+    }
+    return 0;
+  }
+  }
+}
+
+int main(int argc, char *argv[]) { return RunCampaign(argc, argv, Run); }
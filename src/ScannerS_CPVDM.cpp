@@ -6,6 +6,7 @@
 #include "ScannerS/Constraints/Unitarity.hpp"
 #include "ScannerS/Core.hpp"
 #include "ScannerS/Models/CPVDM.hpp"
+#include <iostream>
 #ifdef EVADE_FOUND
 #include "EVADE/Models/CDN2HDM.hpp" // IWYU pragma: keep
 #include "ScannerS/Constraints/VacStab.hpp"
@@ -13,7 +14,7 @@
 
 using namespace ScannerS;
 
-int main(int argc, char *argv[]) {
+int Run(int argc, char *argv[]) {
   using Model = Models::CPVDM;
   ScannerSSetup<Model> scanners(argc, argv);
   scanners.AddParameters({"mHsm", "mHa", "mHb", "mHp", "a1", "a2", "a3", "L2",
@@ -33,8 +34,11 @@ int main(int argc, char *argv[]) {
   auto bfb = scanners.GetConstraint<Constraints::BFB>();
   auto uni = scanners.GetConstraint<Constraints::Unitarity>();
   auto stu = scanners.GetConstraint<Constraints::STU>();
-  // the argument sets the chisq cut value for HiggsSignals
-  auto higgs = scanners.GetConstraint<Constraints::Higgs>(Constants::chisq2Sigma2d);
+  // the arguments set the chisq cut value for HiggsSignals and the result
+  // cache
+  auto higgs = scanners.GetConstraint<Constraints::Higgs>(
+      Constants::chisq2Sigma2d, scanners.higgsCacheSize,
+      scanners.higgsCacheQuantization, scanners.hbExperiments);
   #ifdef MicrOMEGAs_FOUND
   auto dm = scanners.GetConstraint<Constraints::DarkMatter>();
 #endif
@@ -64,6 +68,7 @@ int main(int argc, char *argv[]) {
     auto m22sq = scanners.GetDoubleParameter("m22sq");
     auto mssq = scanners.GetDoubleParameter("mssq");
 
+    auto surrogate = scanners.GetSurrogate();
     size_t n = 0;
     while (n < scanners.npoints) {
       Model::AngleInput in{
@@ -75,7 +80,9 @@ int main(int argc, char *argv[]) {
       Model::ParameterPoint p(in);
       if (Model::Valid(p) && noChargedDM(p) && bfb(p) && uni(p) && stu(p)) {
         Model::CalcCouplings(p);
-        if (higgs(p)
+        if (!surrogate.Evaluate<Model>(p, scanners.rGen))
+          continue; // predicted to fail the Higgs constraint
+        if (surrogate.Record(higgs, p)
 #ifdef MicrOMEGAs_FOUND
             && dm(p)
 #endif
@@ -83,10 +90,13 @@ int main(int argc, char *argv[]) {
             && vacstab(p)
 #endif
         ) {
+          scanners.StoreJacobian(p.data);
           out(p, n++);
         }
       }
     }
+    surrogate.PrintStatistics(std::cout);
+    higgs.PrintStatistics(std::cout);
     return 0;
   }
   case RunMode::check: {
@@ -118,3 +128,5 @@ int main(int argc, char *argv[]) {
   }
   }
 }
+
+int main(int argc, char *argv[]) { return RunCampaign(argc, argv, Run); }
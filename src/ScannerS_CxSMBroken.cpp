@@ -5,13 +5,14 @@
 #include "ScannerS/Constraints/Unitarity.hpp"
 #include "ScannerS/Core.hpp"
 #include "ScannerS/Models/CxSMBroken.hpp"
+#include <iostream>
 #ifdef BSMPT_FOUND
 #include "ScannerS/Constraints/EWPT.hpp"
 #endif
 
 using namespace ScannerS;
 
-int main(int argc, char *argv[]) {
+int Run(int argc, char *argv[]) {
   using Model = Models::CxSMBroken;
   ScannerSSetup<Model> scanners(argc, argv);
   scanners.AddParameters({"mHa", "mHb", "a1", "a2", "a3", "vs"});
@@ -27,8 +28,11 @@ int main(int argc, char *argv[]) {
   auto bfb = scanners.GetConstraint<Constraints::BFB>();
   auto uni = scanners.GetConstraint<Constraints::Unitarity>();
   auto stu = scanners.GetConstraint<Constraints::STU>();
-  // the argument sets the chisq cut value for HiggsSignals
-  auto higgs = scanners.GetConstraint<Constraints::Higgs>(Constants::chisq2Sigma2d);
+  // the arguments set the chisq cut value for HiggsSignals and the result
+  // cache
+  auto higgs = scanners.GetConstraint<Constraints::Higgs>(
+      Constants::chisq2Sigma2d, scanners.higgsCacheSize,
+      scanners.higgsCacheQuantization, scanners.hbExperiments);
 #ifdef BSMPT_FOUND
   auto ewpt = scanners.GetConstraint<Constraints::EWPT>();
 #endif
@@ -43,6 +47,7 @@ int main(int argc, char *argv[]) {
     auto a3 = scanners.GetDoubleParameter("a3");
     auto vs = scanners.GetDoubleParameter("vs");
 
+    auto surrogate = scanners.GetSurrogate();
     size_t n = 0;
     while (n < scanners.npoints) {
       Model::AngleInput in{mHa(scanners.rGen), mHb(scanners.rGen),
@@ -51,17 +56,22 @@ int main(int argc, char *argv[]) {
                            vs(scanners.rGen)};
       Model::ParameterPoint p(in);
       if (Model::Valid(p) && uni(p) && bfb(p) && stu(p)) {
+        if (!surrogate.Evaluate<Model>(p, scanners.rGen))
+          continue; // predicted to fail the Higgs constraint
         Model::RunHdecay(p); // for higgs we need the BR
-        if (higgs(p)
+        if (surrogate.Record(higgs, p)
 #ifdef BSMPT_FOUND
             && ewpt(p)
 #endif
         ) {
           Model::CalcCXNs(p); // we want the 13TeV cxns in the output
+          scanners.StoreJacobian(p.data);
           out(p, n++);
         }
       }
     }
+    surrogate.PrintStatistics(std::cout);
+    higgs.PrintStatistics(std::cout);
     return 0;
   }
   case RunMode::check: {
@@ -89,3 +99,5 @@ int main(int argc, char *argv[]) {
   }
   }
 }
+
+int main(int argc, char *argv[]) { return RunCampaign(argc, argv, Run); }
@@ -6,13 +6,14 @@
 #include "ScannerS/Constraints/Unitarity.hpp"
 #include "ScannerS/Core.hpp"
 #include "ScannerS/Models/CxSMDark.hpp"
+#include <iostream>
 #ifdef BSMPT_FOUND
 #include "ScannerS/Constraints/EWPT.hpp"
 #endif
 
 using namespace ScannerS;
 
-int main(int argc, char *argv[]) {
+int Run(int argc, char *argv[]) {
   using Model = Models::CxSMDark;
   ScannerSSetup<Model> scanners(argc, argv);
   scanners.AddParameters({"mHa", "mHb", "mHX", "alpha", "vs"});
@@ -29,8 +30,11 @@ int main(int argc, char *argv[]) {
   auto bfb = scanners.GetConstraint<Constraints::BFB>();
   auto uni = scanners.GetConstraint<Constraints::Unitarity>();
   auto stu = scanners.GetConstraint<Constraints::STU>();
-  // the argument sets the chisq cut value for HiggsSignals
-  auto higgs = scanners.GetConstraint<Constraints::Higgs>(Constants::chisq2Sigma2d);
+  // the arguments set the chisq cut value for HiggsSignals and the result
+  // cache
+  auto higgs = scanners.GetConstraint<Constraints::Higgs>(
+      Constants::chisq2Sigma2d, scanners.higgsCacheSize,
+      scanners.higgsCacheQuantization, scanners.hbExperiments);
 #ifdef MicrOMEGAs_FOUND
   auto dm = scanners.GetConstraint<Constraints::DarkMatter>();
 #endif
@@ -47,6 +51,7 @@ int main(int argc, char *argv[]) {
     auto alpha = scanners.GetDoubleParameter("alpha");
     auto vs = scanners.GetDoubleParameter("vs");
 
+    auto surrogate = scanners.GetSurrogate();
     size_t n = 0;
     while (n < scanners.npoints) {
       Model::AngleInput in{mHa(scanners.rGen), mHb(scanners.rGen),
@@ -55,8 +60,10 @@ int main(int argc, char *argv[]) {
       Model::ParameterPoint p(in);
       if (uni(p) && bfb(p) && stu(p)) {
         Model::CalcCouplings(p); // now we need the couplings
-        Model::RunHdecay(p);     // for hbhs we need the BR
-        if (higgs(p)
+        if (!surrogate.Evaluate<Model>(p, scanners.rGen))
+          continue; // predicted to fail the Higgs constraint
+        Model::RunHdecay(p); // for hbhs we need the BR
+        if (surrogate.Record(higgs, p)
 #ifdef MicrOMEGAs_FOUND
             && dm(p)
 #endif
@@ -65,10 +72,13 @@ int main(int argc, char *argv[]) {
 #endif
         ) {
           Model::CalcCXNs(p); // we want the 13TeV cxns in the output
+          scanners.StoreJacobian(p.data);
           out(p, n++);
         }
       }
     }
+    surrogate.PrintStatistics(std::cout);
+    higgs.PrintStatistics(std::cout);
     return 0;
   }
   case RunMode::check: {
@@ -99,3 +109,5 @@ int main(int argc, char *argv[]) {
   }
   }
 }
+
+int main(int argc, char *argv[]) { return RunCampaign(argc, argv, Run); }
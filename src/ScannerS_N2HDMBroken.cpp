@@ -2,10 +2,14 @@
 #include "ScannerS/Constraints/BPhysics.hpp"
 #include "ScannerS/Constraints/Constraint.hpp"
 #include "ScannerS/Constraints/Higgs.hpp"
+#include "ScannerS/Constraints/HiggsPreScreen.hpp"
+#include "ScannerS/Constraints/Lilith.hpp"
 #include "ScannerS/Constraints/STU.hpp"
 #include "ScannerS/Constraints/Unitarity.hpp"
 #include "ScannerS/Core.hpp"
+#include "ScannerS/Interfaces/Lilith.hpp"
 #include "ScannerS/Models/N2HDMBroken.hpp"
+#include <iostream>
 #ifdef EVADE_FOUND
 #include "EVADE/Models/N2HDM.hpp" // IWYU pragma: keep
 #include "ScannerS/Constraints/VacStab.hpp"
@@ -16,7 +20,7 @@
 
 using namespace ScannerS;
 
-int main(int argc, char *argv[]) {
+int Run(int argc, char *argv[]) {
   using Model = Models::N2HDMBroken;
   ScannerSSetup<Model> scanners(argc, argv);
   scanners.AddParameters({"mHa", "mHb", "mHc", "mA", "mHp", "tbeta",
@@ -24,7 +28,8 @@ int main(int argc, char *argv[]) {
                           "vs", "type"});
   scanners.AddConstraints<Constraints::BFB, Constraints::Unitarity,
                           Constraints::BPhysics, Constraints::STU,
-                          Constraints::Higgs>();
+                          Constraints::Higgs, Constraints::HiggsPreScreen,
+                          Constraints::Lilith>();
 #ifdef EVADE_FOUND
   scanners.AddConstraints<Constraints::VacStab>();
 #endif
@@ -38,8 +43,18 @@ int main(int argc, char *argv[]) {
   auto uni = scanners.GetConstraint<Constraints::Unitarity>();
   auto bphys = scanners.GetConstraint<Constraints::BPhysics>();
   auto stu = scanners.GetConstraint<Constraints::STU>();
-  // the argument sets the chisq cut value for HiggsSignals
-  auto higgs = scanners.GetConstraint<Constraints::Higgs>(Constants::chisq2Sigma2d);
+  // the arguments set the chisq cut value for HiggsSignals and the result
+  // cache
+  auto higgs = scanners.GetConstraint<Constraints::Higgs>(
+      Constants::chisq2Sigma2d, scanners.higgsCacheSize,
+      scanners.higgsCacheQuantization, scanners.hbExperiments);
+  // the pre-screen uses the same chisq cut plus a configurable margin
+  auto prescreen = scanners.GetConstraint<Constraints::HiggsPreScreen>(
+      Constants::chisq2Sigma2d, scanners.preScreenMargin, scanners.lilithDir);
+  // the native Lilith likelihood as an alternative rate constraint
+  auto lilith = scanners.GetConstraint<Constraints::Lilith>(
+      Constants::chisq2Sigma2d,
+      Interfaces::Lilith::DefaultList(scanners.lilithDir), scanners.lilithDir);
 #ifdef EVADE_FOUND
   const std::vector<std::vector<std::string>> fieldsets{
       {"vh1r0", "vh2r0", "vh2i0", "vh2rp", "vhsr0"}};
@@ -72,6 +87,7 @@ int main(int argc, char *argv[]) {
       return -1;
     };
 
+    auto surrogate = scanners.GetSurrogate();
     size_t n = 0;
     while (n < scanners.npoints) {
       Model::PhysicalInput in{mHa(scanners.rGen),
@@ -91,8 +107,10 @@ int main(int argc, char *argv[]) {
       Model::ParameterPoint p{in};
       if (Model::Valid(p) && uni(p) && bfb(p) && bphys(p) && stu(p)) {
         Model::CalcCouplings(p); // now we need the couplings
-        Model::RunHdecay(p);     // for higgs we need the BR
-        if (higgs(p)
+        if (!prescreen(p) || !surrogate.Evaluate<Model>(p, scanners.rGen))
+          continue; // predicted to fail the Higgs constraint
+        Model::RunHdecay(p); // for higgs we need the BR
+        if (surrogate.Record(higgs, p) && lilith(p)
 #ifdef EVADE_FOUND
             && vac(p)
 #endif
@@ -101,10 +119,13 @@ int main(int argc, char *argv[]) {
 #endif
         ) {
           Model::CalcCXNs(p); // we want the 13TeV cxns in the output
+          scanners.StoreJacobian(p.data);
           out(p, n++);
         }
       }
     }
+    surrogate.PrintStatistics(std::cout);
+    higgs.PrintStatistics(std::cout);
     return 0;
   }
   case RunMode::check: {
@@ -131,7 +152,7 @@ int main(int argc, char *argv[]) {
       if (Model::Valid(p) && uni(p) && bfb(p) && bphys(p) && stu(p)) {
         Model::CalcCouplings(p); // now we need the couplings
         Model::RunHdecay(p);     // for higgs we need the BR
-        if (higgs(p)
+        if (higgs(p) && lilith(p)
 #ifdef EVADE_FOUND
             && vac(p)
 #endif
@@ -148,3 +169,5 @@ int main(int argc, char *argv[]) {
   }
   }
 }
+
+int main(int argc, char *argv[]) { return RunCampaign(argc, argv, Run); }
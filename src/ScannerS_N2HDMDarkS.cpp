@@ -7,6 +7,7 @@
 #include "ScannerS/Constraints/Unitarity.hpp"
 #include "ScannerS/Core.hpp"
 #include "ScannerS/Models/N2HDMDarkS.hpp"
+#include <iostream>
 #ifdef EVADE_FOUND
 #include "EVADE/Models/N2HDM.hpp" // IWYU pragma: keep
 #include "ScannerS/Constraints/VacStab.hpp"
@@ -14,7 +15,7 @@
 
 using namespace ScannerS;
 
-int main(int argc, char *argv[]) {
+int Run(int argc, char *argv[]) {
   using Model = Models::N2HDMDarkS;
   ScannerSSetup<Model> scanners(argc, argv);
   scanners.AddParameters({"mHa", "mHb", "mA", "mHp", "mHD", "tbeta", "alpha",
@@ -35,8 +36,11 @@ int main(int argc, char *argv[]) {
   auto uni = scanners.GetConstraint<Constraints::Unitarity>();
   auto bphys = scanners.GetConstraint<Constraints::BPhysics>();
   auto stu = scanners.GetConstraint<Constraints::STU>();
-  // the argument sets the chisq cut value for HiggsSignals
-  auto higgs = scanners.GetConstraint<Constraints::Higgs>(Constants::chisq2Sigma2d);
+  // the arguments set the chisq cut value for HiggsSignals and the result
+  // cache
+  auto higgs = scanners.GetConstraint<Constraints::Higgs>(
+      Constants::chisq2Sigma2d, scanners.higgsCacheSize,
+      scanners.higgsCacheQuantization, scanners.hbExperiments);
 #ifdef EVADE_FOUND
   const std::vector<std::vector<std::string>> fieldsets{
       {"vh1r0", "vh2r0", "vh2i0", "vh2rp", "vhsr0"}};
@@ -62,6 +66,7 @@ int main(int argc, char *argv[]) {
     auto L8 = scanners.GetDoubleParameter("L8");
     auto type = scanners.GetIntParameter("type");
 
+    auto surrogate = scanners.GetSurrogate();
     size_t n = 0;
     while (n < scanners.npoints) {
       Model::AngleInput in{
@@ -75,8 +80,10 @@ int main(int argc, char *argv[]) {
       Model::ParameterPoint p{in};
       if (uni(p) && bfb(p) && bphys(p) && stu(p)) {
         Model::CalcCouplings(p); // now we need the couplings
-        Model::RunHdecay(p);     // for higgs we need the BR
-        if (higgs(p)
+        if (!surrogate.Evaluate<Model>(p, scanners.rGen))
+          continue; // predicted to fail the Higgs constraint
+        Model::RunHdecay(p); // for higgs we need the BR
+        if (surrogate.Record(higgs, p)
 #ifdef MicrOMEGAs_FOUND
             && dm(p)
 #endif
@@ -85,10 +92,13 @@ int main(int argc, char *argv[]) {
 #endif
         ) {
           Model::CalcCXNs(p); // we want the 13TeV cxns in the output
+          scanners.StoreJacobian(p.data);
           out(p, n++);
         }
       }
     }
+    surrogate.PrintStatistics(std::cout);
+    higgs.PrintStatistics(std::cout);
     return 0;
   }
   case RunMode::check: {
@@ -125,3 +135,5 @@ int main(int argc, char *argv[]) {
   }
   }
 }
+
+int main(int argc, char *argv[]) { return RunCampaign(argc, argv, Run); }
@@ -6,6 +6,7 @@
 #include "ScannerS/Constraints/Unitarity.hpp"
 #include "ScannerS/Core.hpp"
 #include "ScannerS/Models/N2HDMDarkSD.hpp"
+#include <iostream>
 #ifdef EVADE_FOUND
 #include "EVADE/Models/N2HDM.hpp" // IWYU pragma: keep
 #include "ScannerS/Constraints/VacStab.hpp"
@@ -13,7 +14,7 @@
 
 using namespace ScannerS;
 
-int main(int argc, char *argv[]) {
+int Run(int argc, char *argv[]) {
   using Model = Models::N2HDMDarkSD;
   ScannerSSetup<Model> scanners(argc, argv);
   scanners.AddParameters({"mHsm", "mHDD", "mAD", "mHDp", "mHDS", "m22sq",
@@ -32,8 +33,11 @@ int main(int argc, char *argv[]) {
   auto bfb = scanners.GetConstraint<Constraints::BFB>();
   auto uni = scanners.GetConstraint<Constraints::Unitarity>();
   auto stu = scanners.GetConstraint<Constraints::STU>();
-  // the argument sets the chisq cut value for HiggsSignals
-  auto higgs = scanners.GetConstraint<Constraints::Higgs>(Constants::chisq2Sigma2d);
+  // the arguments set the chisq cut value for HiggsSignals and the result
+  // cache
+  auto higgs = scanners.GetConstraint<Constraints::Higgs>(
+      Constants::chisq2Sigma2d, scanners.higgsCacheSize,
+      scanners.higgsCacheQuantization, scanners.hbExperiments);
 #ifdef EVADE_FOUND
   const std::vector<std::vector<std::string>> fieldsets{
       {"vh1r0", "vh2r0", "vh2i0", "vh2rp", "vhsr0"}};
@@ -60,6 +64,7 @@ int main(int argc, char *argv[]) {
     auto L6 = scanners.GetDoubleParameter("L6");
     auto L8 = scanners.GetDoubleParameter("L8");
 
+    auto surrogate = scanners.GetSurrogate();
     size_t n = 0;
     while (n < scanners.npoints) {
       Model::Input in{
@@ -69,8 +74,10 @@ int main(int argc, char *argv[]) {
           L8(scanners.rGen),   Constants::vEW};
       Model::ParameterPoint p{in};
       if (noChargedDM(p) && uni(p) && bfb(p) && stu(p)) {
+        if (!surrogate.Evaluate<Model>(p, scanners.rGen))
+          continue; // predicted to fail the Higgs constraint
         Model::RunHdecay(p); // for higgs we need the BR
-        if (higgs(p)
+        if (surrogate.Record(higgs, p)
 #ifdef MicrOMEGAs_FOUND
             && dm(p)
 #endif
@@ -78,10 +85,13 @@ int main(int argc, char *argv[]) {
             && vac(p)
 #endif
         ) {
+          scanners.StoreJacobian(p.data);
           out(p, n++);
         }
       }
     }
+    surrogate.PrintStatistics(std::cout);
+    higgs.PrintStatistics(std::cout);
     return 0;
   }
   case RunMode::check: {
@@ -112,3 +122,5 @@ int main(int argc, char *argv[]) {
   }
   }
 }
+
+int main(int argc, char *argv[]) { return RunCampaign(argc, argv, Run); }
@@ -3,24 +3,32 @@
 #include "ScannerS/Constraints/BPhysics.hpp"
 #include "ScannerS/Constraints/Constraint.hpp"
 #include "ScannerS/Constraints/Higgs.hpp"
+#include "ScannerS/Constraints/HiggsPreScreen.hpp"
+#include "ScannerS/Constraints/Lilith.hpp"
 #include "ScannerS/Constraints/STU.hpp"
 #include "ScannerS/Constraints/Unitarity.hpp"
 #include "ScannerS/Core.hpp"
+#include "ScannerS/Interfaces/Lilith.hpp"
 #include "ScannerS/Models/R2HDM.hpp"
+#include "ScannerS/Tools/PointBatch.hpp"
+#include <cstddef>
+#include <iostream>
+#include <vector>
 #ifdef BSMPT_FOUND
 #include "ScannerS/Constraints/EWPT.hpp"
 #endif
 
 using namespace ScannerS;
 
-int main(int argc, char *argv[]) {
+int Run(int argc, char *argv[]) {
   using Model = Models::R2HDM;
   ScannerSSetup<Model> scanners(argc, argv);
   scanners.AddParameters(
       {"mHa", "mHb", "mA", "mHp", "c_HbVV", "tbeta", "m12sq", "type"});
   scanners.AddConstraints<Constraints::BFB, Constraints::Unitarity,
                           Constraints::AbsoluteStability, Constraints::BPhysics,
-                          Constraints::STU, Constraints::Higgs>();
+                          Constraints::STU, Constraints::Higgs,
+                          Constraints::HiggsPreScreen, Constraints::Lilith>();
 #ifdef BSMPT_FOUND
   scanners.AddConstraints<Constraints::EWPT>();
 #endif
@@ -33,8 +41,18 @@ int main(int argc, char *argv[]) {
   auto stab = scanners.GetConstraint<Constraints::AbsoluteStability>();
   auto bphys = scanners.GetConstraint<Constraints::BPhysics>();
   auto stu = scanners.GetConstraint<Constraints::STU>();
-  // the argument sets the chisq cut value for HiggsSignals
-  auto higgs = scanners.GetConstraint<Constraints::Higgs>(Constants::chisq2Sigma2d);
+  // the arguments set the chisq cut value for HiggsSignals and the result
+  // cache
+  auto higgs = scanners.GetConstraint<Constraints::Higgs>(
+      Constants::chisq2Sigma2d, scanners.higgsCacheSize,
+      scanners.higgsCacheQuantization, scanners.hbExperiments);
+  // the pre-screen uses the same chisq cut plus a configurable margin
+  auto prescreen = scanners.GetConstraint<Constraints::HiggsPreScreen>(
+      Constants::chisq2Sigma2d, scanners.preScreenMargin, scanners.lilithDir);
+  // the native Lilith likelihood as an alternative rate constraint
+  auto lilith = scanners.GetConstraint<Constraints::Lilith>(
+      Constants::chisq2Sigma2d,
+      Interfaces::Lilith::DefaultList(scanners.lilithDir), scanners.lilithDir);
 #ifdef BSMPT_FOUND
   auto ewpt = scanners.GetConstraint<Constraints::EWPT>();
 #endif
@@ -50,28 +68,62 @@ int main(int argc, char *argv[]) {
     auto m12sq = scanners.GetDoubleParameter("m12sq");
     auto type = scanners.GetIntParameter("type");
 
+    // candidates are generated in blocks and those violating BFB, unitarity
+    // or STU are removed on the parameter columns, full parameter points are
+    // only constructed for the remaining candidates
+    constexpr size_t blockSize = 256;
+    const bool filterBFB = bfb.GetSeverity() == Constraints::Severity::apply;
+    const bool filterUni = uni.GetSeverity() == Constraints::Severity::apply;
+    auto inputs = std::vector<Model::PhysicalInput>{};
+    auto jacobians = std::vector<double>{};
+    auto batch = Tools::PointBatch<Model>{};
+
+    auto surrogate = scanners.GetSurrogate();
     size_t n = 0;
     while (n < scanners.npoints) {
-      Model::PhysicalInput in{
-          mHa(scanners.rGen),    mHb(scanners.rGen),
-          mA(scanners.rGen),     mHp(scanners.rGen),
-          c_HbVV(scanners.rGen), tbeta(scanners.rGen),
-          m12sq(scanners.rGen),  static_cast<Model::Yuk>(type(scanners.rGen)),
-          Constants::vEW};
-      Model::ParameterPoint p{in};
-      if (uni(p) && bfb(p) && stab(p) && bphys(p) && stu(p)) {
-        Model::CalcCouplings(p); // now we need the couplings
-        Model::RunHdecay(p);     // for higgs we need the BR
-        if (higgs(p)
+      inputs.clear();
+      jacobians.clear();
+      for (size_t i = 0; i != blockSize; ++i) {
+        inputs.push_back({mHa(scanners.rGen), mHb(scanners.rGen),
+                          mA(scanners.rGen), mHp(scanners.rGen),
+                          c_HbVV(scanners.rGen), tbeta(scanners.rGen),
+                          m12sq(scanners.rGen),
+                          static_cast<Model::Yuk>(type(scanners.rGen)),
+                          Constants::vEW});
+        jacobians.push_back(scanners.Jacobian());
+      }
+      batch.Assign(inputs);
+      batch.Filter([&](const Model::BatchColumns &cols, size_t i) {
+        const auto L = cols.LAt(i);
+        return (!filterBFB || Model::BFB(L)) &&
+               (!filterUni || Model::MaxUnitarityEV(L) < uni.Limit());
+      });
+      stu.ApplyBatch(batch);
+
+      for (auto i : batch.Survivors()) {
+        if (n == scanners.npoints)
+          break;
+        auto p = batch.Materialize(i);
+        if (uni(p) && bfb(p) && stab(p) && bphys(p) &&
+            stu.BatchResult(p, i)) {
+          Model::CalcCouplings(p); // now we need the couplings
+          if (!prescreen(p) || !surrogate.Evaluate<Model>(p, scanners.rGen))
+            continue; // predicted to fail the Higgs constraint
+          Model::RunHdecay(p); // for higgs we need the BR
+          if (surrogate.Record(higgs, p) && lilith(p)
 #ifdef BSMPT_FOUND
-            && ewpt(p)
+              && ewpt(p)
 #endif
-        ) {
-          Model::CalcCXNs(p); // we want the 13TeV cxns in the output
-          out(p, n++);
+          ) {
+            Model::CalcCXNs(p); // we want the 13TeV cxns in the output
+            scanners.StoreJacobian(p.data, jacobians[i]);
+            out(p, n++);
+          }
         }
       }
     }
+    surrogate.PrintStatistics(std::cout);
+    higgs.PrintStatistics(std::cout);
     return 0;
   }
   case RunMode::check: {
@@ -88,7 +140,7 @@ int main(int argc, char *argv[]) {
       if (uni(p) && bfb(p) && stab(p) && bphys(p) && stu(p)) {
         Model::CalcCouplings(p); // now we need the couplings
         Model::RunHdecay(p);     // for higgs we need the BR
-        if (higgs(p)
+        if (higgs(p) && lilith(p)
 #ifdef BSMPT_FOUND
             && ewpt(p)
 #endif
@@ -102,3 +154,5 @@ int main(int argc, char *argv[]) {
   }
   }
 }
+
+int main(int argc, char *argv[]) { return RunCampaign(argc, argv, Run); }
@@ -5,10 +5,11 @@
 #include "ScannerS/Constraints/Unitarity.hpp"
 #include "ScannerS/Core.hpp"
 #include "ScannerS/Models/TRSMBroken.hpp"
+#include <iostream>
 
 using namespace ScannerS;
 
-int main(int argc, char *argv[]) {
+int Run(int argc, char *argv[]) {
   using Model = Models::TRSMBroken;
   ScannerSSetup<Model> scanners(argc, argv);
   scanners.AddParameters({"mHa", "mHb", "mHc", "t1", "t2", "t3", "vs", "vx"});
@@ -21,8 +22,11 @@ int main(int argc, char *argv[]) {
   auto bfb = scanners.GetConstraint<Constraints::BFB>();
   auto uni = scanners.GetConstraint<Constraints::Unitarity>();
   auto stu = scanners.GetConstraint<Constraints::STU>();
-  // the argument sets the chisq cut value for HiggsSignals
-  auto higgs = scanners.GetConstraint<Constraints::Higgs>(Constants::chisq2Sigma2d);
+  // the arguments set the chisq cut value for HiggsSignals and the result
+  // cache
+  auto higgs = scanners.GetConstraint<Constraints::Higgs>(
+      Constants::chisq2Sigma2d, scanners.higgsCacheSize,
+      scanners.higgsCacheQuantization, scanners.hbExperiments);
 
   scanners.PrintConfig(mode);
   switch (mode) {
@@ -36,6 +40,7 @@ int main(int argc, char *argv[]) {
     auto vs = scanners.GetDoubleParameter("vs");
     auto vx = scanners.GetDoubleParameter("vx");
 
+    auto surrogate = scanners.GetSurrogate();
     size_t n = 0;
     while (n < scanners.npoints) {
       Model::AngleInput in{
@@ -43,10 +48,15 @@ int main(int argc, char *argv[]) {
           t1(scanners.rGen), t2(scanners.rGen), t3(scanners.rGen),
           Constants::vEW,    vs(scanners.rGen), vx(scanners.rGen)};
       Model::ParameterPoint p(in);
-      if (uni(p) && bfb(p) && stu(p) && higgs(p)) {
+      if (uni(p) && bfb(p) && stu(p) &&
+          surrogate.Evaluate<Model>(p, scanners.rGen) &&
+          surrogate.Record(higgs, p)) {
+        scanners.StoreJacobian(p.data);
         out(p, n++);
       }
     }
+    surrogate.PrintStatistics(std::cout);
+    higgs.PrintStatistics(std::cout);
     return 0;
   }
   case RunMode::check: {
@@ -67,3 +77,5 @@ int main(int argc, char *argv[]) {
   }
   }
 }
+
+int main(int argc, char *argv[]) { return RunCampaign(argc, argv, Run); }
@@ -1,4 +1,7 @@
 #include "ScannerS/Setup.hpp"
+
+#include "ScannerS/Campaign.hpp"
+#include "ScannerS/Interfaces/Lilith.hpp"
 #include <algorithm>
 #include <chrono>
 #include <cstddef>
@@ -6,7 +9,6 @@
 #include <iterator>
 #include <sstream>
 #include <stdexcept>
-#include <stdlib.h>
 #include <unistd.h>
 #include <vector>
 
@@ -20,10 +22,15 @@ ScannerSCMD::ScannerSCMD(const std::string &name, int argc, char *argv[])
       seed_{static_cast<int>(
                 std::chrono::system_clock::now().time_since_epoch().count()) *
             getpid()},
-      argc_{argc}, argv_{argv}, outfile{argv_[0]} {
+      argc_{argc}, argv_{argv}, outfile{argv_[0]},
+      lilithDir{Interfaces::Lilith::DefaultDir()} {
   outfile = outfile.substr(outfile.rfind('/') + 1) + ".tsv";
   app_.require_subcommand(1);
   app_.set_config("--config");
+  app_.footer("Several runs can be performed in a single process using\n  " +
+              std::string{argv_[0]} + " campaign campaignfile\n"
+              "where each line of the campaign file contains the arguments "
+              "of one run.");
   app_.add_option("outfile", outfile, "output file (tsv format)")
       ->capture_default_str();
   scan_
@@ -34,6 +41,60 @@ ScannerSCMD::ScannerSCMD(const std::string &name, int argc, char *argv[])
       ->add_option("--seed", seed_,
                    "random number seed (defaults to time * PID)")
       ->capture_default_str();
+  scan_->add_option("--prescreen-margin", preScreenMargin,
+                    "margin in Delta chisq of the approximate Higgs "
+                    "pre-screen, required if --HiggsPreScreen is not skip");
+  scan_
+      ->add_flag("--surrogate", surrogate_.enabled,
+                 "skip the Higgs constraint for points that an online "
+                 "classifier predicts to fail")
+      ->group("Surrogate");
+  scan_
+      ->add_option("--surrogate-confidence", surrogate_.confidence,
+                   "minimal fraction of failing neighbours to skip a point")
+      ->capture_default_str()
+      ->group("Surrogate");
+  scan_
+      ->add_option("--surrogate-audit", surrogate_.auditFraction,
+                   "fraction of skipped points that are evaluated anyway")
+      ->capture_default_str()
+      ->group("Surrogate");
+  scan_
+      ->add_option("--surrogate-k", surrogate_.k,
+                   "number of nearest neighbours")
+      ->capture_default_str()
+      ->group("Surrogate");
+  scan_
+      ->add_option("--surrogate-min-training", surrogate_.minTraining,
+                   "number of evaluated points before any point is skipped")
+      ->capture_default_str()
+      ->group("Surrogate");
+  scan_
+      ->add_option("--surrogate-max-training", surrogate_.maxTraining,
+                   "maximal number of stored training points")
+      ->capture_default_str()
+      ->group("Surrogate");
+  app_.add_option("--higgs-cache", higgsCacheSize,
+                  "number of HiggsBounds/HiggsSignals results to cache "
+                  "(0 disables the cache)")
+      ->capture_default_str()
+      ->group("HiggsBounds/HiggsSignals");
+  app_.add_option("--higgs-cache-quantization", higgsCacheQuantization,
+                  "relative precision to which the cached Higgs inputs have "
+                  "to agree (0 for exact matches)")
+      ->capture_default_str()
+      ->group("HiggsBounds/HiggsSignals");
+  app_.add_option("--hb-experiments", hbExperiments,
+                  "HiggsBounds analyses to load: LEP and hadron colliders "
+                  "(LandH), only LEP (onlyL) or only hadron colliders (onlyH)")
+      ->capture_default_str()
+      ->check(CLI::IsMember({"LandH", "onlyL", "onlyH"}))
+      ->group("HiggsBounds/HiggsSignals");
+  app_.add_option("--lilith-dir", lilithDir,
+                  "Lilith directory with the grids and the experimental input, "
+                  "only read if a Lilith based constraint is used")
+      ->capture_default_str()
+      ->check(CLI::ExistingDirectory);
   check_->add_option("infile", infile, "input file (tsv format)")
       ->required()
       ->check(CLI::ExistingFile);
@@ -42,43 +103,71 @@ ScannerSCMD::ScannerSCMD(const std::string &name, int argc, char *argv[])
 void ScannerSCMD::AddParameters(const std::vector<std::string> &parNames) {
   for (const auto &name : parNames)
     scan_
-        ->add_option("--" + name, paramRanges_[name],
-                     "min and max for parameter " + name)
+        ->add_option("--" + name, paramSpecs_[name],
+                     "prior for parameter " + name + ", eg min and max")
         ->required()
+        ->expected(1, CLI::detail::expected_max_vector_size)
         ->group("Parameters")
         ->ignore_case();
 }
 
-std::uniform_int_distribution<int>
-ScannerSCMD::GetIntParameter(const std::string &name) {
-  if (paramRanges_.count(name) != 1)
+Tools::Prior &ScannerSCMD::GetPrior(const std::string &name, bool integer) {
+  if (paramSpecs_.count(name) != 1)
     throw std::runtime_error(
         "You did not call AddParameters for the parameter " + name);
-  auto range = paramRanges_[name];
-  if (range.first <= range.second)
-    return std::uniform_int_distribution<int>(range.first, range.second);
-  else
-    throw std::runtime_error(
-        "Invalid parameter range [" + std::to_string(range.first) + ", " +
-        std::to_string(range.second) + "] for parameter " + name);
+  if (auto existing = priors_.find(name); existing != priors_.end()) {
+    if (existing->second.Integer() != integer)
+      throw std::runtime_error("The parameter " + name +
+                               " is requested as both an integer and a "
+                               "floating point parameter");
+    return existing->second;
+  }
+  auto &prior =
+      priors_.try_emplace(name, name, paramSpecs_.at(name), integer)
+          .first->second;
+  // references are only connected once both parameters have been requested,
+  // such that each prior is created with its own integer flag
+  for (auto &[otherName, other] : priors_) {
+    if (other.ReferenceName() == name)
+      other.SetReference(prior);
+    if (prior.ReferenceName() == otherName)
+      prior.SetReference(other);
+  }
+  return prior;
 }
 
-std::uniform_real_distribution<double>
+Tools::ParameterDistribution<int>
+ScannerSCMD::GetIntParameter(const std::string &name) {
+  return Tools::ParameterDistribution<int>{GetPrior(name, true)};
+}
+
+Tools::ParameterDistribution<double>
 ScannerSCMD::GetDoubleParameter(const std::string &name) {
-  if (paramRanges_.count(name) != 1)
-    throw std::runtime_error(
-        "You did not call AddParameters for the parameter " + name);
-  auto range = paramRanges_[name];
-  if (range.first <= range.second)
-    return std::uniform_real_distribution(range.first, range.second);
-  else
-    throw std::runtime_error(
-        "Invalid parameter range [" + std::to_string(range.first) + ", " +
-        std::to_string(range.second) + "] for parameter " + name);
+  return Tools::ParameterDistribution<double>{GetPrior(name, false)};
+}
+
+void ScannerSCMD::StoreJacobian(DataMap &data) const {
+  StoreJacobian(data, Jacobian());
 }
 
-void ScannerSCMD::ConstraintSeverity(const std::string &name) {
-  severities_[name] = Constraints::Severity::apply;
+void ScannerSCMD::StoreJacobian(DataMap &data, double jacobian) const {
+  if (std::all_of(priors_.begin(), priors_.end(),
+                  [](const auto &p) { return p.second.Flat(); }))
+    return;
+  data.Store("jacobian", jacobian);
+}
+
+double ScannerSCMD::Jacobian() const {
+  double jacobian = 1.;
+  for (const auto &[name, prior] : priors_)
+    if (prior.Draws() > 0)
+      jacobian *= prior.Jacobian();
+  return jacobian;
+}
+
+void ScannerSCMD::ConstraintSeverity(const std::string &name,
+                                     Constraints::Severity defaultSeverity) {
+  severities_[name] = defaultSeverity;
   static const std::map<std::string, Constraints::Severity> severityMap{
       {"apply", Constraints::Severity::apply},
       {"ignore", Constraints::Severity::ignore},
@@ -90,11 +179,15 @@ void ScannerSCMD::ConstraintSeverity(const std::string &name) {
       ->transform(CLI::CheckedTransformer(severityMap, CLI::ignore_case));
 }
 
+Tools::Surrogate ScannerSCMD::GetSurrogate() const {
+  return Tools::Surrogate{surrogate_};
+}
+
 RunMode ScannerSCMD::Parse() {
   try {
     app_.parse(argc_, argv_);
   } catch (const CLI::ParseError &e) {
-    exit(app_.exit(e));
+    throw RunExit{app_.exit(e)};
   }
   rGen.seed(seed_);
   if (scan_->parsed())
@@ -0,0 +1,32 @@
+// Compiles the experimental input of a Lilith .list file into a binary
+// database that is loaded without parsing any XML or solving for any
+// parameters, see ScannerS::Interfaces::Lilith::WriteDatabase().
+#include "ScannerS/Interfaces/Lilith.hpp"
+
+#include <exception>
+#include <stdexcept>
+#include <iostream>
+
+int main(int argc, char *argv[]) {
+  using namespace ScannerS::Interfaces::Lilith;
+  if (argc != 3) {
+    std::cerr << "Usage: " << argv[0] << " input.list output.ldb" << std::endl;
+    return 1;
+  }
+  try {
+    const auto likelihood = Likelihood::FromList(argv[1]);
+    WriteDatabase(likelihood, argv[2]);
+    // make sure the result can be loaded again
+    const auto check = Likelihood::FromDatabase(argv[2]);
+    const auto mu = SignalStrengths::SMLike();
+    if (check(mu) != likelihood(mu))
+      throw(std::runtime_error("The database does not reproduce the input"));
+    std::cout << "Wrote " << likelihood.Measurements().size()
+              << " measurements with " << likelihood.NObservables()
+              << " observables to " << argv[2] << std::endl;
+  } catch (const std::exception &e) {
+    std::cerr << e.what() << std::endl;
+    return 1;
+  }
+  return 0;
+}
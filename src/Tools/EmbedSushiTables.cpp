@@ -0,0 +1,70 @@
+// Build tool that converts data/ggH_bbH.dat into a source file defining the
+// spline coefficients declared in ScannerS/Tools/SushiTablesData.hpp.
+#include "ScannerS/Tools/UniformSpline.hpp"
+
+#include <cstddef>
+#include <exception>
+#include <fstream>
+#include <ios>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+std::vector<std::vector<double>> ReadTable(const std::string &filename) {
+  std::ifstream file{filename};
+  if (!file.good())
+    throw(std::runtime_error("Could not open cross section table " + filename));
+  std::vector<std::vector<double>> lines;
+  std::string line;
+  while (std::getline(file, line)) {
+    std::istringstream values{line};
+    auto &row = lines.emplace_back();
+    for (double value; values >> value;)
+      row.push_back(value);
+  }
+  if (lines.size() < 2)
+    throw(std::runtime_error("No cross sections in " + filename));
+  return lines;
+}
+} // namespace
+
+int main(int argc, char *argv[]) {
+  using ScannerS::Tools::UniformGrid;
+  using ScannerS::Tools::UniformSpline;
+  if (argc != 3) {
+    std::cerr << "Usage: " << argv[0] << " ggH_bbH.dat output.cpp" << std::endl;
+    return 1;
+  }
+  try {
+    const auto lines = ReadTable(argv[1]);
+    const auto grid = UniformGrid{lines[0]};
+
+    std::ofstream out{argv[2]};
+    out << std::hexfloat;
+    out << "// generated by EmbedSushiTables from " << argv[1] << "\n"
+        << "#include \"ScannerS/Tools/SushiTablesData.hpp\"\n\n"
+        << "namespace ScannerS::Tools::SushiTablesData {\n"
+        << "const std::size_t nPoints = " << lines[0].size() << ";\n"
+        << "const std::size_t nSplines = " << lines.size() - 1 << ";\n"
+        << "const double masses[] = {\n";
+    for (double m : lines[0])
+      out << "    " << m << ",\n";
+    out << "};\n"
+        << "const UniformSpline::Coefficients coefficients[] = {\n";
+    for (std::size_t i = 1; i != lines.size(); ++i)
+      for (const auto &c : UniformSpline{grid, lines[i]}.AllCoefficients())
+        out << "    {" << c.y << ", " << c.c << ", " << c.b << ", " << c.a
+            << "},\n";
+    out << "};\n"
+        << "} // namespace ScannerS::Tools::SushiTablesData\n";
+    if (!out.good())
+      throw(std::runtime_error("Could not write " + std::string{argv[2]}));
+  } catch (const std::exception &e) {
+    std::cerr << e.what() << std::endl;
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,160 @@
+#include "ScannerS/Tools/LambdaBasis.hpp"
+
+#include "ScannerS/Utilities.hpp"
+#include <Eigen/Core>
+#include <Eigen/Eigenvalues>
+#include <cmath>
+
+namespace ScannerS::Tools::LambdaBasis {
+
+namespace {
+// CP-even mass matrix in the (rho1, rho2) basis
+Eigen::Matrix2d R2HDMMassMatrix(const Models::R2HDM::LambdaInput &in) {
+  const auto &L = in.L;
+  const double beta = std::atan(in.tbeta);
+  const double sb = std::sin(beta);
+  const double cb = std::cos(beta);
+  const double vsq = in.v * in.v;
+  const double Msq = in.m12sq / sb / cb;
+
+  Eigen::Matrix2d massMat;
+  massMat << Msq * sb * sb + L[0] * vsq * cb * cb,
+      ((L[2] + L[3] + L[4]) * vsq - Msq) * sb * cb,
+      ((L[2] + L[3] + L[4]) * vsq - Msq) * sb * cb,
+      Msq * cb * cb + L[1] * vsq * sb * sb;
+  return massMat;
+}
+
+// neutral mass matrix in the (rho1, rho2, rho3) basis
+Eigen::Matrix3d C2HDMMassMatrix(const Models::C2HDM::LambdaInput &in) {
+  const auto &L = in.L;
+  const double beta = std::atan(in.tbeta);
+  const double sb = std::sin(beta);
+  const double cb = std::cos(beta);
+  const double vsq = in.v * in.v;
+  const double Msq = in.re_m12sq / sb / cb;
+
+  Eigen::Matrix3d massMat;
+  massMat(0, 0) = Msq * sb * sb + L[0] * vsq * cb * cb;
+  massMat(1, 1) = Msq * cb * cb + L[1] * vsq * sb * sb;
+  massMat(2, 2) = Msq - L[4] * vsq;
+  massMat(0, 1) = ((L[2] + L[3] + L[4]) * vsq - Msq) * sb * cb;
+  massMat(0, 2) = -L[5] * vsq * sb / 2.;
+  massMat(1, 2) = -L[5] * vsq * cb / 2.;
+  massMat(1, 0) = massMat(0, 1);
+  massMat(2, 0) = massMat(0, 2);
+  massMat(2, 1) = massMat(1, 2);
+  return massMat;
+}
+
+// Shift of L[0] such that mhsq is an eigenvalue of the mass matrix. The
+// determinant of massMat - mhsq is linear in the (0, 0) entry, which depends
+// on L[0] through L[0] v^2 cos(beta)^2.
+template <int n>
+std::optional<double> L1Shift(Eigen::Matrix<double, n, n> massMat,
+                              double mhsq, double tbeta, double v) {
+  massMat.diagonal().array() -= mhsq;
+  const double minor =
+      massMat.template bottomRightCorner<n - 1, n - 1>().determinant();
+  const double diag = massMat(0, 0);
+  massMat(0, 0) = 0.;
+  const double required = -massMat.determinant() / minor;
+  const double cb = std::cos(std::atan(tbeta));
+  const double shift = (required - diag) / (v * v * cb * cb);
+  if (!std::isfinite(shift))
+    return std::nullopt;
+  return shift;
+}
+} // namespace
+
+std::optional<Models::R2HDM::AngleInput>
+R2HDMInput(const Models::R2HDM::LambdaInput &in) {
+  const auto &L = in.L;
+  const double beta = std::atan(in.tbeta);
+  const double sb = std::sin(beta);
+  const double cb = std::cos(beta);
+  const double vsq = in.v * in.v;
+  const double Msq = in.m12sq / sb / cb;
+
+  const double mHpsq = Msq - (L[3] + L[4]) * vsq / 2.;
+  const double mAsq = Msq - L[4] * vsq;
+
+  const auto massMat = R2HDMMassMatrix(in);
+  const auto es = Eigen::SelfAdjointEigenSolver<Eigen::Matrix2d>{massMat};
+  const auto &mHsq = es.eigenvalues();
+  if (mHsq(0) <= 0 || mAsq <= 0 || mHpsq <= 0)
+    return std::nullopt;
+
+  // H = cos(alpha) rho1 + sin(alpha) rho2
+  Eigen::Vector2d heavy = es.eigenvectors().col(1);
+  if (heavy(0) < 0)
+    heavy *= -1;
+  const double alpha = std::atan2(heavy(1), heavy(0));
+
+  return Models::R2HDM::AngleInput{std::sqrt(mHsq(1)),
+                                   std::sqrt(mHsq(0)),
+                                   std::sqrt(mAsq),
+                                   std::sqrt(mHpsq),
+                                   alpha,
+                                   in.tbeta,
+                                   in.m12sq,
+                                   in.type,
+                                   in.v};
+}
+
+std::optional<Models::C2HDM::AngleInput>
+C2HDMInput(const Models::C2HDM::LambdaInput &in) {
+  const auto &L = in.L;
+  const double beta = std::atan(in.tbeta);
+  const double sb = std::sin(beta);
+  const double cb = std::cos(beta);
+  const double vsq = in.v * in.v;
+  const double Msq = in.re_m12sq / sb / cb;
+
+  const double mHpsq = Msq - (L[3] + L[4]) * vsq / 2.;
+
+  const auto massMat = C2HDMMassMatrix(in);
+  const auto es = Eigen::SelfAdjointEigenSolver<Eigen::Matrix3d>{massMat};
+  const auto &mHsq = es.eigenvalues();
+  if (mHsq(0) <= 0 || mHpsq <= 0)
+    return std::nullopt;
+
+  Eigen::Matrix3d R = es.eigenvectors().transpose();
+  Utilities::MixMatNormalForm3d(R);
+  const auto alpha = Utilities::MixMatAngles3d(R);
+
+  return Models::C2HDM::AngleInput{std::sqrt(mHsq(0)),
+                                   std::sqrt(mHsq(1)),
+                                   std::sqrt(mHpsq),
+                                   alpha[0],
+                                   alpha[1],
+                                   alpha[2],
+                                   in.tbeta,
+                                   in.re_m12sq,
+                                   in.type,
+                                   in.v};
+}
+
+std::optional<Models::R2HDM::LambdaInput>
+SolveL1(Models::R2HDM::LambdaInput in, double mh) {
+  const auto shift = L1Shift(R2HDMMassMatrix(in), mh * mh, in.tbeta, in.v);
+  if (!shift)
+    return std::nullopt;
+  in.L[0] += *shift;
+  if (!R2HDMInput(in))
+    return std::nullopt;
+  return in;
+}
+
+std::optional<Models::C2HDM::LambdaInput>
+SolveL1(Models::C2HDM::LambdaInput in, double mh) {
+  const auto shift = L1Shift(C2HDMMassMatrix(in), mh * mh, in.tbeta, in.v);
+  if (!shift)
+    return std::nullopt;
+  in.L[0] += *shift;
+  if (!C2HDMInput(in))
+    return std::nullopt;
+  return in;
+}
+
+} // namespace ScannerS::Tools::LambdaBasis
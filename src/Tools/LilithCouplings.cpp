@@ -0,0 +1,355 @@
+#include "ScannerS/Tools/LilithCouplings.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace ScannerS::Tools {
+
+namespace {
+using Coupling = LilithCouplings::Coupling;
+namespace L = Interfaces::Lilith;
+
+constexpr auto T = Coupling::tt;
+constexpr auto B = Coupling::bb;
+constexpr auto C = Coupling::cc;
+constexpr auto Ta = Coupling::tautau;
+constexpr auto W = Coupling::WW;
+constexpr auto Z = Coupling::ZZ;
+
+// the pairs of couplings multiplying the form factors in the columns of the
+// grid files, like in `reducedcouplingsnnlo.py`
+using Pair = std::array<Coupling, 2>;
+constexpr std::array<Pair, 15> loopPairs{
+    {{T, T},
+     {C, C},
+     {T, C},
+     {B, B},
+     {W, W},
+     {Ta, Ta},
+     {T, B},
+     {C, B},
+     {T, W},
+     {C, W},
+     {B, W},
+     {T, Ta},
+     {C, Ta},
+     {B, Ta},
+     {Ta, W}}};
+constexpr std::array<Pair, 6> ggDecayPairs{
+    {{T, T}, {C, C}, {T, C}, {B, B}, {T, B}, {C, B}}};
+constexpr std::array<Pair, 3> ggProdPairs{{{T, T}, {B, B}, {T, B}}};
+constexpr std::array<Pair, 3> VBFPairs{{{W, W}, {Z, Z}, {W, Z}}};
+
+// the couplings of the visible decays in the order of L::Decay
+constexpr std::array<Coupling, L::nDecays - 1> decayCouplings{
+    Coupling::gammagamma, Coupling::ZZ,     Coupling::WW,
+    Coupling::bb,         Coupling::tautau, Coupling::ggDecay,
+    Coupling::cc,         Coupling::mumu,   Coupling::Zgamma};
+
+// the couplings of the production modes in the order of L::Production for
+// each L::Energy
+constexpr std::array<std::array<Coupling, L::nProductions>, L::nEnergies>
+    prodCouplings{{{Coupling::ggProdLHC8, Coupling::VBF, Coupling::WH,
+                    Coupling::qqZH, Coupling::ggZH, Coupling::tt,
+                    Coupling::tHq, Coupling::tHW, Coupling::bb},
+                   {Coupling::ggProdLHC13, Coupling::VBF13, Coupling::WH,
+                    Coupling::qqZH, Coupling::ggZH13, Coupling::tt,
+                    Coupling::tHq13, Coupling::tHW13, Coupling::bb}}};
+
+const std::array<std::string, LilithCouplings::nRequired> requiredNames{
+    "tt", "bb", "cc", "tautau", "mumu", "WW", "ZZ"};
+
+//! the numeric lines of a grid file, other lines (eg headers) are skipped
+std::vector<std::vector<double>> ReadRows(const std::string &path,
+                                          std::size_t nColumns) {
+  std::ifstream in{path};
+  if (!in)
+    throw(std::runtime_error("Cannot open the Lilith grid " + path));
+  auto result = std::vector<std::vector<double>>{};
+  std::string line;
+  while (std::getline(in, line)) {
+    std::istringstream ls{line};
+    auto values = std::vector<double>{};
+    double v;
+    while (ls >> v)
+      values.push_back(v);
+    if (values.empty())
+      continue;
+    if (values.size() < nColumns)
+      throw(std::runtime_error("Invalid line in " + path + ": " + line));
+    result.push_back(std::move(values));
+  }
+  return result;
+}
+
+//! the mass grid in the first column
+UniformGrid MassGrid(const std::vector<std::vector<double>> &rows) {
+  auto x = std::vector<double>{};
+  for (const auto &r : rows)
+    x.push_back(r[0]);
+  return UniformGrid{std::move(x)};
+}
+
+//! not-a-knot splines of the given columns
+std::vector<UniformSpline>
+Interpolate(const UniformGrid &grid,
+            const std::vector<std::vector<double>> &rows,
+            const std::vector<std::size_t> &columns) {
+  auto result = std::vector<UniformSpline>{};
+  for (auto col : columns) {
+    auto y = std::vector<double>{};
+    for (const auto &r : rows)
+      y.push_back(r[col]);
+    result.emplace_back(grid, y, UniformSpline::Boundary::notAKnot);
+  }
+  return result;
+}
+
+//! the columns 1 to n
+std::vector<std::size_t> FirstColumns(std::size_t n) {
+  auto result = std::vector<std::size_t>(n);
+  for (std::size_t i = 0; i != n; ++i)
+    result[i] = i + 1;
+  return result;
+}
+
+bool SameGrid(const UniformGrid &a, const UniformGrid &b) {
+  return a.Points() == b.Points();
+}
+
+//! \f$ \sqrt{\sum_k f_k c_{a_k} c_{b_k} / \sum_k f_k} \f$ for form factors f
+template <std::size_t n>
+double FormFactorCoupling(const std::vector<UniformSpline> &formFactors,
+                          const std::array<Pair, n> &pairs,
+                          const UniformGrid::Location &loc,
+                          const LilithCouplings::Higgs &h) {
+  double numerator = 0.;
+  double denominator = 0.;
+  for (std::size_t k = 0; k != n; ++k) {
+    const double ff = formFactors[k](loc);
+    numerator += ff * h(pairs[k][0]) * h(pairs[k][1]);
+    denominator += ff;
+  }
+  return std::sqrt(std::max(numerator, 0.) / denominator);
+}
+
+double SqrtPositive(double x) { return std::sqrt(std::max(x, 0.)); }
+
+void Check(const LilithCouplings::Higgs &h) {
+  for (std::size_t i = 0; i != LilithCouplings::nRequired; ++i)
+    if (std::isnan(h.c[i]))
+      throw(std::runtime_error("LilithCouplings: the reduced coupling to " +
+                               requiredNames[i] + " is missing"));
+  if (!(h.m >= LilithCouplings::minMass && h.m <= LilithCouplings::maxMass))
+    throw(std::runtime_error("LilithCouplings: the mass " +
+                             std::to_string(h.m) +
+                             " GeV is outside of the Lilith grids"));
+}
+} // namespace
+
+LilithCouplings::Higgs LilithCouplings::Higgs::SMLike(double m) noexcept {
+  auto result = Higgs{};
+  for (std::size_t i = 0; i != nRequired; ++i)
+    result.c[i] = 1.;
+  result.m = m;
+  return result;
+}
+
+LilithCouplings::LilithCouplings(const std::string &lilithDir) {
+  const std::string dir = lilithDir + "/lilith/internal/Grids/";
+
+  // brsm.py
+  const auto fermions = ReadRows(dir + "BR_fermions.dat", 14);
+  const auto gauge = ReadRows(dir + "BR_gauge.dat", 14);
+  brSM_.grid = MassGrid(fermions);
+  if (!SameGrid(brSM_.grid, MassGrid(gauge)))
+    throw(std::runtime_error("Different mass grids of the Lilith BR grids"));
+  // the columns of the visible decays in the order of L::Decay
+  const auto brColumns = std::array<
+      std::pair<const std::vector<std::vector<double>> *, std::size_t>,
+      L::nDecays - 1>{{{&gauge, 4},
+                       {&gauge, 13},
+                       {&gauge, 10},
+                       {&fermions, 1},
+                       {&fermions, 4},
+                       {&gauge, 1},
+                       {&fermions, 10},
+                       {&fermions, 7},
+                       {&gauge, 7}}};
+  for (const auto &[rows, column] : brColumns)
+    brSM_.columns.push_back(Interpolate(brSM_.grid, *rows, {column}).front());
+
+  // reducedcouplingsnnlo.py
+  auto read = [&dir](Table &table, const std::string &file,
+                     std::size_t nColumns, bool vbf = false) {
+    auto rows = ReadRows(dir + file, nColumns + 1);
+    if (vbf) // the WZ interference from the total cross section
+      for (auto &r : rows)
+        r[3] = r[3] - r[1] - r[2];
+    table.grid = MassGrid(rows);
+    table.columns = Interpolate(table.grid, rows, FirstColumns(nColumns));
+  };
+  read(gammagamma_, "GaGa_grid.dat", loopPairs.size());
+  read(Zgamma_, "ZGa_grid.dat", loopPairs.size());
+  read(ggDecay_, "GG_grid.dat", ggDecayPairs.size());
+  read(ggProdLHC8_, "ggF_NNLO_LHC8_grid.dat", ggProdPairs.size());
+  read(ggProdLHC13_, "ggF_NNLO_LHC13_grid.dat", ggProdPairs.size());
+  read(VBF_, "VBF_NLO8_grid.dat", VBFPairs.size(), true);
+  read(VBF13_, "VBF_NLO13_grid.dat", VBFPairs.size(), true);
+  // allows to locate the mass once for each group of tables
+  if (!SameGrid(gammagamma_.grid, Zgamma_.grid) ||
+      !SameGrid(gammagamma_.grid, ggDecay_.grid) ||
+      !SameGrid(ggProdLHC8_.grid, ggProdLHC13_.grid) ||
+      !SameGrid(ggProdLHC8_.grid, VBF_.grid) ||
+      !SameGrid(ggProdLHC8_.grid, VBF13_.grid))
+    throw(std::runtime_error(
+        "Different mass grids of the Lilith form factor grids"));
+}
+
+LilithCouplings::Higgs LilithCouplings::Complete(const Higgs &higgs) const {
+  Check(higgs);
+  auto result = higgs;
+  CompleteChecked(result);
+  return result;
+}
+
+void LilithCouplings::CompleteChecked(Higgs &h) const {
+  auto unset = [&h](Coupling c) { return std::isnan(h(c)); };
+
+  // the defaults of the Lilith user input
+  if (unset(Coupling::WH))
+    h(Coupling::WH) = h(W);
+  if (unset(Coupling::qqZH))
+    h(Coupling::qqZH) = h(Z);
+  if (unset(Coupling::VBF) && std::abs(h(W) - h(Z)) < 1e-6)
+    h(Coupling::VBF) = h(W);
+
+  // computereducedcouplings.py
+  const auto loopLoc = gammagamma_.grid.Locate(h.m);
+  const auto prodLoc = ggProdLHC8_.grid.Locate(h.m);
+  if (unset(Coupling::gammagamma))
+    h(Coupling::gammagamma) =
+        FormFactorCoupling(gammagamma_.columns, loopPairs, loopLoc, h);
+  if (unset(Coupling::Zgamma))
+    h(Coupling::Zgamma) =
+        FormFactorCoupling(Zgamma_.columns, loopPairs, loopLoc, h);
+  if (unset(Coupling::ggDecay))
+    h(Coupling::ggDecay) =
+        FormFactorCoupling(ggDecay_.columns, ggDecayPairs, loopLoc, h);
+  if (unset(Coupling::ggProdLHC8))
+    h(Coupling::ggProdLHC8) =
+        FormFactorCoupling(ggProdLHC8_.columns, ggProdPairs, prodLoc, h);
+  if (unset(Coupling::ggProdLHC13))
+    h(Coupling::ggProdLHC13) =
+        FormFactorCoupling(ggProdLHC13_.columns, ggProdPairs, prodLoc, h);
+  if (unset(Coupling::VBF))
+    h(Coupling::VBF) = FormFactorCoupling(VBF_.columns, VBFPairs, prodLoc, h);
+  if (unset(Coupling::VBF13))
+    h(Coupling::VBF13) =
+        FormFactorCoupling(VBF13_.columns, VBFPairs, prodLoc, h);
+
+  // the fixed quadratic forms of reducedcouplingsnnlo.py
+  const double ct = h(T);
+  const double cb = h(B);
+  const double cw = h(W);
+  const double cz = h(Z);
+  if (unset(Coupling::tHq))
+    h(Coupling::tHq) =
+        SqrtPositive(2.984 * ct * ct + 3.886 * cw * cw - 5.870 * ct * cw);
+  if (unset(Coupling::tHq13))
+    h(Coupling::tHq13) =
+        SqrtPositive(2.633 * ct * ct + 3.578 * cw * cw - 5.211 * ct * cw);
+  if (unset(Coupling::tHW))
+    h(Coupling::tHW) =
+        SqrtPositive(2.426 * ct * ct + 1.818 * cw * cw - 3.244 * ct * cw);
+  if (unset(Coupling::tHW13))
+    h(Coupling::tHW13) =
+        SqrtPositive(2.909 * ct * ct + 2.310 * cw * cw - 4.220 * ct * cw);
+  if (unset(Coupling::ggZH))
+    h(Coupling::ggZH) = SqrtPositive(
+        0.372 * ct * ct + 0.0004 * cb * cb + 2.302 * cz * cz +
+        0.003 * ct * cb - 1.663 * ct * cz - 0.013 * cb * cz);
+  if (unset(Coupling::ggZH13))
+    h(Coupling::ggZH13) = SqrtPositive(
+        0.456 * ct * ct + 0.0004 * cb * cb + 2.455 * cz * cz +
+        0.003 * ct * cb - 1.902 * ct * cz - 0.011 * cb * cz);
+}
+
+void LilithCouplings::Mu(const Higgs *higgs, L::SignalStrengths *result,
+                         std::size_t n) const {
+  for (std::size_t j = 0; j != n; ++j) {
+    Check(higgs[j]);
+    auto h = higgs[j];
+    CompleteChecked(h);
+
+    // computemufromreducedcouplings.py
+    const auto loc = brSM_.grid.Locate(h.m);
+    std::array<double, L::nDecays> redBR;
+    double width = 0.;
+    double widthSM = 0.;
+    for (std::size_t d = 0; d != decayCouplings.size(); ++d) {
+      const double br = brSM_.columns[d](loc);
+      const double c = h(decayCouplings[d]);
+      redBR[d] = c * c;
+      width += br * c * c;
+      widthSM += br;
+    }
+    const double scale =
+        (1. - h.brInvisible - h.brUndetected) / (width / widthSM);
+    for (std::size_t d = 0; d != decayCouplings.size(); ++d)
+      redBR[d] *= scale;
+    redBR[static_cast<std::size_t>(L::Decay::invisible)] = h.brInvisible;
+
+    auto *mu = result[j].mu.data();
+    for (const auto &couplings : prodCouplings)
+      for (auto coupling : couplings) {
+        const double c = h(coupling);
+        for (std::size_t d = 0; d != L::nDecays; ++d)
+          *mu++ = c * c * redBR[d];
+      }
+  }
+}
+
+std::vector<L::SignalStrengths>
+LilithCouplings::Mu(const std::vector<Higgs> &higgs) const {
+  auto result = std::vector<L::SignalStrengths>(higgs.size());
+  Mu(higgs.data(), result.data(), higgs.size());
+  return result;
+}
+
+L::SignalStrengths LilithCouplings::TotalMu(const Higgs *higgs,
+                                            std::size_t n) const {
+  auto result = L::SignalStrengths{};
+  for (std::size_t j = 0; j != n; ++j) {
+    L::SignalStrengths mu;
+    Mu(higgs + j, &mu, 1);
+    result += mu;
+  }
+  return result;
+}
+
+L::SignalStrengths
+LilithCouplings::TotalMu(const std::vector<Higgs> &higgs) const {
+  return TotalMu(higgs.data(), higgs.size());
+}
+
+const LilithCouplings &SharedLilithCouplings(const std::string &lilithDir) {
+  static std::mutex mutex;
+  static std::map<std::string, std::unique_ptr<const LilithCouplings>>
+      instances;
+  const auto lock = std::lock_guard{mutex};
+  auto &instance = instances[lilithDir];
+  if (!instance)
+    instance = std::make_unique<const LilithCouplings>(lilithDir);
+  return *instance;
+}
+
+} // namespace ScannerS::Tools
@@ -0,0 +1,178 @@
+#include "ScannerS/Tools/Prior.hpp"
+
+#include "ScannerS/Constants.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+
+namespace ScannerS::Tools {
+
+namespace {
+double Phi(double x) { return 0.5 * std::erfc(-x / std::sqrt(2.)); }
+} // namespace
+
+Prior::Prior(std::string name, const std::vector<std::string> &spec,
+             bool integer)
+    : name_{std::move(name)}, integer_{integer} {
+  auto tok = spec.begin();
+  auto invalid = [this, &spec](const std::string &reason) {
+    std::string specStr;
+    for (const auto &s : spec)
+      specStr += " " + s;
+    return std::runtime_error("Invalid prior" + specStr + " for parameter " +
+                              name_ + ": " + reason);
+  };
+
+  if (tok != spec.end() && (*tok == "diff" || *tok == "ratio")) {
+    relation_ = *tok == "diff" ? Relation::difference : Relation::ratio;
+    if (++tok == spec.end())
+      throw(invalid("missing reference parameter"));
+    referenceName_ = *tok++;
+    if (referenceName_ == name_)
+      throw(invalid("a parameter cannot be derived from itself"));
+    if (integer_)
+      throw(invalid("integer parameters cannot be derived"));
+  }
+
+  size_t nMin = 2;
+  size_t nMax = 2;
+  if (tok != spec.end()) {
+    if (*tok == "uniform") {
+      ++tok;
+    } else if (*tok == "log") {
+      shape_ = Shape::logUniform;
+      ++tok;
+    } else if (*tok == "normal") {
+      shape_ = Shape::normal;
+      nMax = 4;
+      ++tok;
+    } else if (*tok == "set") {
+      shape_ = Shape::discrete;
+      nMin = 1;
+      nMax = spec.size();
+      ++tok;
+    }
+  }
+  if (integer_ && (shape_ == Shape::logUniform || shape_ == Shape::normal))
+    throw(invalid("only uniform and set priors are allowed for integer "
+                  "parameters"));
+
+  for (; tok != spec.end(); ++tok) {
+    try {
+      size_t pos;
+      par_.push_back(std::stod(*tok, &pos));
+      if (pos != tok->size())
+        throw std::invalid_argument(*tok);
+    } catch (const std::logic_error &) {
+      throw(invalid("could not convert " + *tok + " to a number"));
+    }
+  }
+  if (par_.size() < nMin || par_.size() > nMax ||
+      (shape_ == Shape::normal && par_.size() == 3))
+    throw(invalid("wrong number of values"));
+  if (integer_ && std::any_of(par_.begin(), par_.end(),
+                              [](double x) { return std::floor(x) != x; }))
+    throw(invalid("integer parameters require integer values"));
+
+  switch (shape_) {
+  case Shape::uniform:
+    if (!(par_[0] <= par_[1]))
+      throw(invalid("min > max"));
+    break;
+  case Shape::logUniform:
+    if (!(0 < par_[0] && par_[0] <= par_[1]))
+      throw(invalid("requires 0 < min <= max"));
+    break;
+  case Shape::normal:
+    if (!(par_[1] > 0))
+      throw(invalid("the width has to be positive"));
+    if (par_.size() == 4) {
+      if (!(par_[2] < par_[3]))
+        throw(invalid("min >= max"));
+      normalization_ = Phi((par_[3] - par_[0]) / par_[1]) -
+                       Phi((par_[2] - par_[0]) / par_[1]);
+      // rejection sampling becomes too inefficient far out in the tails
+      if (normalization_ < 1e-6)
+        throw(invalid("truncation range too far in the tails"));
+    }
+    break;
+  case Shape::discrete:
+    break;
+  }
+}
+
+void Prior::SetReference(const Prior &reference) {
+  if (reference.name_ != referenceName_)
+    throw(std::runtime_error("Wrong reference " + reference.name_ +
+                             " for parameter " + name_ + " derived from " +
+                             referenceName_));
+  reference_ = &reference;
+}
+
+void Prior::CheckReference() const {
+  if (!reference_)
+    throw(std::runtime_error("Reference parameter " + referenceName_ +
+                             " of " + name_ + " not set"));
+  if (reference_->draws_ <= draws_)
+    throw(std::runtime_error(
+        "The parameter " + name_ + " is derived from " + referenceName_ +
+        ", which has to be drawn first for every parameter point"));
+}
+
+bool Prior::Flat() const {
+  return relation_ != Relation::ratio &&
+         (shape_ == Shape::uniform || shape_ == Shape::discrete);
+}
+
+double Prior::BaseJacobian(double x) const {
+  switch (shape_) {
+  case Shape::uniform:
+    if (integer_)
+      return par_[1] - par_[0] + 1;
+    return par_[0] < par_[1] ? par_[1] - par_[0] : 1.;
+  case Shape::logUniform:
+    return par_[0] < par_[1] ? x * std::log(par_[1] / par_[0]) : 1.;
+  case Shape::normal: {
+    const double z = (x - par_[0]) / par_[1];
+    return normalization_ * par_[1] * std::sqrt(2 * Constants::pi) *
+           std::exp(z * z / 2.);
+  }
+  case Shape::discrete:
+    return static_cast<double>(par_.size()) /
+           static_cast<double>(std::count(par_.begin(), par_.end(), x));
+  }
+  return 1.;
+}
+
+double Prior::Min() const {
+  if (relation_ != Relation::none ||
+      (shape_ == Shape::normal && par_.size() == 2))
+    throw(std::runtime_error("The prior of " + name_ +
+                             " does not have a bounded range"));
+  switch (shape_) {
+  case Shape::normal:
+    return par_[2];
+  case Shape::discrete:
+    return *std::min_element(par_.begin(), par_.end());
+  default:
+    return par_[0];
+  }
+}
+
+double Prior::Max() const {
+  if (relation_ != Relation::none ||
+      (shape_ == Shape::normal && par_.size() == 2))
+    throw(std::runtime_error("The prior of " + name_ +
+                             " does not have a bounded range"));
+  switch (shape_) {
+  case Shape::normal:
+    return par_[3];
+  case Shape::discrete:
+    return *std::max_element(par_.begin(), par_.end());
+  default:
+    return par_[1];
+  }
+}
+
+} // namespace ScannerS::Tools
@@ -0,0 +1,119 @@
+#include "ScannerS/Tools/Surrogate.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <ostream>
+#include <stdexcept>
+#include <utility>
+
+namespace ScannerS::Tools {
+
+Surrogate::Surrogate(Settings settings) : settings_{settings} {
+  if (!(settings_.confidence > 0 && settings_.confidence <= 1))
+    throw(std::runtime_error("The surrogate confidence has to be in (0, 1]"));
+  if (!(settings_.auditFraction >= 0 && settings_.auditFraction <= 1))
+    throw(std::runtime_error(
+        "The surrogate audit fraction has to be in [0, 1]"));
+  if (settings_.k == 0 || settings_.minTraining < settings_.k ||
+      settings_.maxTraining < settings_.minTraining)
+    throw(std::runtime_error(
+        "The surrogate requires 0 < k <= minTraining <= maxTraining"));
+}
+
+bool Surrogate::PredictFail() {
+  if (features_.size() < settings_.minTraining ||
+      current_.size() != mean_.size())
+    return false;
+
+  invSigma_.resize(mean_.size());
+  for (size_t i = 0; i != mean_.size(); ++i) {
+    const double var = m2_[i] / static_cast<double>(nMoments_ - 1);
+    // constant features do not contribute
+    invSigma_[i] = var > 0 ? 1. / std::sqrt(var) : 0.;
+  }
+
+  neighbours_.clear();
+  for (size_t j = 0; j != features_.size(); ++j) {
+    double distSq = 0;
+    for (size_t i = 0; i != current_.size(); ++i) {
+      const double d = (features_[j][i] - current_[i]) * invSigma_[i];
+      distSq += d * d;
+    }
+    neighbours_.emplace_back(distSq, labels_[j]);
+  }
+  std::nth_element(
+      neighbours_.begin(), neighbours_.begin() + settings_.k - 1,
+      neighbours_.end(),
+      [](const auto &a, const auto &b) { return a.first < b.first; });
+  const auto nFail = std::count_if(
+      neighbours_.begin(), neighbours_.begin() + settings_.k,
+      [](const auto &n) { return !n.second; });
+  return static_cast<double>(nFail) >=
+         settings_.confidence * static_cast<double>(settings_.k);
+}
+
+bool Surrogate::Record(bool passed) {
+  if (!settings_.enabled)
+    return passed;
+  ++stats_.evaluated;
+  if (passed)
+    ++stats_.passed;
+  if (auditing_) {
+    ++stats_.audited;
+    if (passed)
+      ++stats_.falseRejections;
+    auditing_ = false;
+  }
+  Train(passed);
+  return passed;
+}
+
+void Surrogate::Train(bool passed) {
+  if (mean_.empty()) {
+    mean_.assign(current_.size(), 0.);
+    m2_.assign(current_.size(), 0.);
+  }
+  if (current_.size() != mean_.size())
+    return;
+
+  ++nMoments_;
+  for (size_t i = 0; i != current_.size(); ++i) {
+    const double delta = current_[i] - mean_[i];
+    mean_[i] += delta / static_cast<double>(nMoments_);
+    m2_[i] += delta * (current_[i] - mean_[i]);
+  }
+
+  if (features_.size() < settings_.maxTraining) {
+    features_.push_back(std::move(current_));
+    labels_.push_back(passed);
+  } else {
+    // the replaced features provide the storage of the next prediction
+    std::swap(features_[next_], current_);
+    labels_[next_] = passed;
+    next_ = (next_ + 1) % settings_.maxTraining;
+  }
+  current_.clear();
+}
+
+double Surrogate::FalseRejectionRate() const {
+  return stats_.audited > 0 ? static_cast<double>(stats_.falseRejections) /
+                                  static_cast<double>(stats_.audited)
+                            : 0.;
+}
+
+void Surrogate::PrintStatistics(std::ostream &out) const {
+  if (!settings_.enabled)
+    return;
+  out << "Surrogate statistics: " << stats_.evaluated << " points evaluated ("
+      << stats_.passed << " passed), " << stats_.skipped
+      << " skipped as predicted failures, " << stats_.audited
+      << " predicted failures audited of which " << stats_.falseRejections
+      << " passed.\nEstimated false rejection rate: " << std::setprecision(3)
+      << FalseRejectionRate() << " (~"
+      << std::lround(FalseRejectionRate() *
+                     static_cast<double>(stats_.skipped))
+      << " skipped points would have passed)" << std::endl;
+}
+
+} // namespace ScannerS::Tools
@@ -0,0 +1,70 @@
+#include "ScannerS/Tools/SushiTables.hpp"
+
+#include "ScannerS/Tools/SushiTablesData.hpp"
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+namespace ScannerS::Tools {
+
+SushiTables::SushiTables() {
+  namespace Data = SushiTablesData;
+  constexpr std::size_t nContributions = 8;
+  if (Data::nSplines != splines_.size() * nContributions)
+    throw(std::runtime_error("Unexpected number of embedded cross sections"));
+
+  grid_ = UniformGrid{
+      std::vector<double>(Data::masses, Data::masses + Data::nPoints)};
+  // the contributions in the order of the data file, each for all colliders
+  const auto contributions = std::array<UniformSpline Splines::*,
+                                        nContributions>{
+      &Splines::bbh_bbe, &Splines::bbh_bbo, &Splines::ggh_bbe,
+      &Splines::ggh_bbo, &Splines::ggh_tte, &Splines::ggh_tto,
+      &Splines::ggh_tbe, &Splines::ggh_tbo};
+  const auto *coefficients = Data::coefficients;
+  for (auto contribution : contributions)
+    for (auto &splines : splines_) {
+      const auto *end = coefficients + Data::nPoints + 1;
+      splines.*contribution = UniformSpline{
+          grid_, std::vector<UniformSpline::Coefficients>(coefficients, end)};
+      coefficients = end;
+    }
+}
+
+const SushiTables &SharedSushiTables() {
+  static const SushiTables tables{};
+  return tables;
+}
+
+double SushiTables::GG(double m, double cte, double cbe, double cto,
+                       double cbo, Collider coll) const {
+  return GGe(m, cte, cbe, coll) + GGo(m, cto, cbo, coll);
+}
+
+double SushiTables::GGe(double m, double ct, double cb, Collider coll) const {
+  const auto &s = splines_[static_cast<std::size_t>(coll)];
+  const auto loc = grid_.Locate(m);
+  return ct * ct * s.ggh_tte(loc) + cb * cb * s.ggh_bbe(loc) +
+         ct * cb * s.ggh_tbe(loc);
+}
+
+double SushiTables::GGo(double m, double ct, double cb, Collider coll) const {
+  const auto &s = splines_[static_cast<std::size_t>(coll)];
+  const auto loc = grid_.Locate(m);
+  return ct * ct * s.ggh_tto(loc) + cb * cb * s.ggh_bbo(loc) +
+         ct * cb * s.ggh_tbo(loc);
+}
+
+double SushiTables::BB(double m, double cbe, double cbo, Collider coll) const {
+  return BBe(m, cbe, coll) + BBo(m, cbo, coll);
+}
+
+double SushiTables::BBe(double m, double cb, Collider coll) const {
+  return cb * cb * splines_[static_cast<std::size_t>(coll)].bbh_bbe(m);
+}
+
+double SushiTables::BBo(double m, double cb, Collider coll) const {
+  return cb * cb * splines_[static_cast<std::size_t>(coll)].bbh_bbo(m);
+}
+
+} // namespace ScannerS::Tools
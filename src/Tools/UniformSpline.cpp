@@ -0,0 +1,232 @@
+#include "ScannerS/Tools/UniformSpline.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace ScannerS::Tools {
+
+namespace {
+//! relative difference up to which two steps are considered equal
+constexpr double stepTolerance = 1e-9;
+
+//! solves the tridiagonal system for the unknowns 1 to n-2 in place using the
+//! Thomas algorithm, the diagonal and the rhs are overwritten
+void SolveTridiagonal(const std::vector<double> &lower,
+                      std::vector<double> &diag,
+                      const std::vector<double> &upper,
+                      std::vector<double> &rhs) {
+  const std::size_t n = diag.size();
+  for (std::size_t i = 2; i + 1 < n; ++i) {
+    const double w = lower[i] / diag[i - 1];
+    diag[i] -= w * upper[i - 1];
+    rhs[i] -= w * rhs[i - 1];
+  }
+  rhs[n - 2] /= diag[n - 2];
+  for (std::size_t i = n - 2; i-- > 1;)
+    rhs[i] = (rhs[i] - upper[i] * rhs[i + 1]) / diag[i];
+}
+
+//! quadratic coefficients of the natural spline
+std::vector<double> NaturalQuadratic(const std::vector<double> &x,
+                                     const std::vector<double> &y) {
+  const std::size_t n = x.size();
+  // solve the tridiagonal system for the quadratic coefficients with the
+  // Thomas algorithm
+  auto b = std::vector<double>(n, 0.);
+  auto upper = std::vector<double>(n, 0.);
+  for (std::size_t i = 1; i + 1 < n; ++i) {
+    const double hl = x[i] - x[i - 1];
+    const double hr = x[i + 1] - x[i];
+    const double lower = hl / 3.;
+    const double diag = 2. / 3. * (x[i + 1] - x[i - 1]) - lower * upper[i - 1];
+    upper[i] = hr / 3. / diag;
+    const double rhs = (y[i + 1] - y[i]) / hr - (y[i] - y[i - 1]) / hl;
+    b[i] = (rhs - lower * b[i - 1]) / diag;
+  }
+  for (std::size_t i = n - 2; i > 0; --i)
+    b[i] -= upper[i] * b[i + 1];
+  return b;
+}
+
+//! quadratic coefficients of the not-a-knot spline
+std::vector<double> NotAKnotQuadratic(const std::vector<double> &x,
+                                      const std::vector<double> &y) {
+  const std::size_t n = x.size();
+  auto lower = std::vector<double>(n, 0.);
+  auto diag = std::vector<double>(n, 0.);
+  auto upper = std::vector<double>(n, 0.);
+  auto b = std::vector<double>(n, 0.);
+  for (std::size_t i = 1; i + 1 < n; ++i) {
+    const double hl = x[i] - x[i - 1];
+    const double hr = x[i + 1] - x[i];
+    lower[i] = hl / 3.;
+    diag[i] = 2. / 3. * (x[i + 1] - x[i - 1]);
+    upper[i] = hr / 3.;
+    b[i] = (y[i + 1] - y[i]) / hr - (y[i] - y[i - 1]) / hl;
+  }
+  // equal cubic coefficients in the first two and last two intervals,
+  // eliminate b[0] and b[n-1] from the first and last equation
+  const double rFirst = (x[1] - x[0]) / (x[2] - x[1]);
+  diag[1] += lower[1] * (1 + rFirst);
+  upper[1] -= lower[1] * rFirst;
+  const double rLast = (x[n - 1] - x[n - 2]) / (x[n - 2] - x[n - 3]);
+  diag[n - 2] += upper[n - 2] * (1 + rLast);
+  lower[n - 2] -= upper[n - 2] * rLast;
+
+  SolveTridiagonal(lower, diag, upper, b);
+  b[0] = (1 + rFirst) * b[1] - rFirst * b[2];
+  b[n - 1] = (1 + rLast) * b[n - 2] - rLast * b[n - 3];
+  return b;
+}
+} // namespace
+
+UniformGrid::UniformGrid(std::vector<double> x) : x_{std::move(x)} {
+  if (x_.size() < 2)
+    throw(std::runtime_error("A grid needs at least two points"));
+  for (std::size_t i = 0; i + 1 < x_.size(); ++i)
+    if (!(x_[i + 1] > x_[i]))
+      throw(std::runtime_error("The grid points have to be increasing"));
+
+  std::size_t first = 0;
+  while (first + 1 < x_.size()) {
+    const double step = x_[first + 1] - x_[first];
+    std::size_t last = first + 1;
+    while (last + 1 < x_.size() &&
+           std::abs(x_[last + 1] - x_[last] - step) < stepTolerance * step)
+      ++last;
+    blocks_.push_back({x_[first], x_[last],
+                       (last - first) / (x_[last] - x_[first]), first,
+                       last - 1});
+    first = last;
+  }
+}
+
+UniformSpline::UniformSpline(UniformGrid grid, const std::vector<double> &y,
+                             Boundary boundary)
+    : grid_{std::move(grid)} {
+  const auto &x = grid_.Points();
+  const std::size_t n = x.size();
+  if (y.size() != n)
+    throw(std::runtime_error("The number of values " +
+                             std::to_string(y.size()) +
+                             " does not match the grid size " +
+                             std::to_string(n)));
+  if (boundary == Boundary::notAKnot && n < 4)
+    throw(std::runtime_error("A not-a-knot spline needs at least four points"));
+
+  const auto b = boundary == Boundary::natural ? NaturalQuadratic(x, y)
+                                               : NotAKnotQuadratic(x, y);
+
+  coefficients_.resize(n + 1);
+  for (std::size_t i = 0; i + 1 < n; ++i) {
+    const double h = x[i + 1] - x[i];
+    const double c = (y[i + 1] - y[i]) / h - (2 * b[i] + b[i + 1]) * h / 3.;
+    coefficients_[i + 1] = {y[i], c, b[i], (b[i + 1] - b[i]) / 3. / h};
+  }
+  const auto &prev = coefficients_[n - 1];
+  const double h = x[n - 1] - x[n - 2];
+  const double slope = (3 * prev.a * h + 2 * prev.b) * h + prev.c;
+  if (boundary == Boundary::natural) {
+    coefficients_[n] = {y[n - 1], slope, b[n - 1], 0.};
+    coefficients_[0] = {y[0], coefficients_[1].c, b[0], 0.};
+  } else {
+    coefficients_[n] = {y[n - 1], slope, b[n - 1], prev.a};
+    coefficients_[0] = coefficients_[1];
+  }
+}
+
+UniformSpline::UniformSpline(UniformGrid grid,
+                             std::vector<Coefficients> coefficients)
+    : grid_{std::move(grid)}, coefficients_{std::move(coefficients)} {
+  if (coefficients_.size() != grid_.Points().size() + 1)
+    throw(std::runtime_error("The number of spline coefficients does not "
+                             "match the grid size"));
+}
+
+void UniformSpline::Evaluate(const double *x, double *result,
+                             std::size_t n) const noexcept {
+  for (std::size_t i = 0; i != n; ++i)
+    result[i] = (*this)(x[i]);
+}
+
+std::vector<double>
+UniformSpline::Evaluate(const std::vector<double> &x) const {
+  auto result = std::vector<double>(x.size());
+  Evaluate(x.data(), result.data(), x.size());
+  return result;
+}
+
+UniformSpline2D::UniformSpline2D(UniformGrid x, UniformGrid y,
+                                 const std::vector<double> &z,
+                                 UniformSpline::Boundary boundary)
+    : x_{std::move(x)}, y_{std::move(y)} {
+  const std::size_t nx = x_.Points().size();
+  const std::size_t ny = y_.Points().size();
+  if (z.size() != nx * ny)
+    throw(std::runtime_error("The number of values " +
+                             std::to_string(z.size()) +
+                             " does not match the grid size " +
+                             std::to_string(nx) + "x" + std::to_string(ny)));
+
+  // splines in x for every y grid point, as [y point][x location]
+  auto inX = std::vector<std::vector<UniformSpline::Coefficients>>{};
+  inX.reserve(ny);
+  auto column = std::vector<double>(nx);
+  for (std::size_t j = 0; j != ny; ++j) {
+    for (std::size_t i = 0; i != nx; ++i)
+      column[i] = z[i * ny + j];
+    inX.push_back(UniformSpline{x_, column, boundary}.AllCoefficients());
+  }
+
+  // splines in y of each coefficient of the splines in x
+  coefficients_.resize((nx + 1) * (ny + 1));
+  auto row = std::vector<double>(ny);
+  for (std::size_t i = 0; i != nx + 1; ++i) {
+    for (std::size_t k = 0; k != 4; ++k) {
+      for (std::size_t j = 0; j != ny; ++j) {
+        const auto &co = inX[j][i];
+        row[j] = std::array{co.y, co.c, co.b, co.a}[k];
+      }
+      const auto spline = UniformSpline{y_, row, boundary};
+      const auto &inY = spline.AllCoefficients();
+      for (std::size_t j = 0; j != ny + 1; ++j) {
+        auto *c = &coefficients_[i * (ny + 1) + j][4 * k];
+        c[0] = inY[j].y;
+        c[1] = inY[j].c;
+        c[2] = inY[j].b;
+        c[3] = inY[j].a;
+      }
+    }
+  }
+}
+
+UniformSpline2D::UniformSpline2D(UniformGrid x, UniformGrid y,
+                                 std::vector<Coefficients> coefficients)
+    : x_{std::move(x)}, y_{std::move(y)},
+      coefficients_{std::move(coefficients)} {
+  if (coefficients_.size() !=
+      (x_.Points().size() + 1) * (y_.Points().size() + 1))
+    throw(std::runtime_error("The number of spline coefficients does not "
+                             "match the grid size"));
+}
+
+double UniformSpline2D::operator()(double x, double y) const noexcept {
+  const auto &px = x_.Points();
+  const auto &py = y_.Points();
+  const auto lx = x_.Locate(std::clamp(x, px.front(), px.back()));
+  const auto ly = y_.Locate(std::clamp(y, py.front(), py.back()));
+  const auto &c = coefficients_[lx.index * (py.size() + 1) + ly.index];
+  double result = 0.;
+  for (std::size_t k = 4; k-- > 0;) {
+    const double *ck = c.data() + 4 * k;
+    result = result * lx.h +
+             ((ck[3] * ly.h + ck[2]) * ly.h + ck[1]) * ly.h + ck[0];
+  }
+  return result;
+}
+
+} // namespace ScannerS::Tools
@@ -0,0 +1,88 @@
+#include "ScannerS/Campaign.hpp"
+
+#include "catch.hpp"
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace ScannerS;
+using Catch::Matchers::Contains;
+
+TEST_CASE("Campaign argument splitting", "[unit][campaign]") {
+  CHECK(SplitArguments("out.tsv --config a.ini scan -n 10") ==
+        std::vector<std::string>{"out.tsv", "--config", "a.ini", "scan", "-n",
+                                 "10"});
+  CHECK(SplitArguments("  out.tsv\t\"my config.ini\"  # comment") ==
+        std::vector<std::string>{"out.tsv", "my config.ini"});
+  CHECK(SplitArguments("; only a comment").empty());
+  CHECK(SplitArguments("\"\" x") == std::vector<std::string>{"", "x"});
+  CHECK_THROWS_WITH(SplitArguments("a \"b"), Contains("Unterminated"));
+}
+
+TEST_CASE("Running a campaign", "[unit][campaign]") {
+  std::vector<std::vector<std::string>> calls;
+  auto run = [&calls](int argc, char *argv[]) {
+    calls.emplace_back(argv, argv + argc);
+    if (calls.size() == 2)
+      throw std::runtime_error("failed run");
+    return 0;
+  };
+  char exe[] = "Model";
+
+  SECTION("single run") {
+    char arg[] = "out.tsv";
+    char *argv[] = {exe, arg, nullptr};
+    REQUIRE(RunCampaign(2, argv, run) == 0);
+    REQUIRE(calls.size() == 1);
+    CHECK(calls[0] == std::vector<std::string>{"Model", "out.tsv"});
+  }
+
+  SECTION("campaign file") {
+    const std::string filename = "T_Campaign_test.txt";
+    {
+      std::ofstream file{filename};
+      file << "# two runs\n"
+           << "a.tsv --config a.ini scan -n 1\n\n"
+           << "b.tsv check a.tsv\n"
+           << "c.tsv check b.tsv\n";
+    }
+    char mode[] = "campaign";
+    char *argv[] = {exe, mode, const_cast<char *>(filename.c_str()), nullptr};
+    REQUIRE(RunCampaign(3, argv, run) == 1);
+    REQUIRE(calls.size() == 3);
+    CHECK(calls[0] == std::vector<std::string>{"Model", "a.tsv", "--config",
+                                               "a.ini", "scan", "-n", "1"});
+    CHECK(calls[2] ==
+          std::vector<std::string>{"Model", "c.tsv", "check", "b.tsv"});
+    std::remove(filename.c_str());
+  }
+
+  SECTION("exit requests") {
+    auto exitRun = [&calls](int argc, char *argv[]) -> int {
+      calls.emplace_back(argv, argv + argc);
+      throw RunExit{calls.size() == 1 ? 0 : 109};
+    };
+    char arg[] = "--help";
+    char *single[] = {exe, arg, nullptr};
+    CHECK(RunCampaign(2, single, exitRun) == 0);
+
+    const std::string filename = "T_Campaign_exit.txt";
+    {
+      std::ofstream file{filename};
+      file << "a.tsv --unknown\n"
+           << "b.tsv --unknown\n";
+    }
+    char mode[] = "campaign";
+    char *argv[] = {exe, mode, const_cast<char *>(filename.c_str()), nullptr};
+    CHECK(RunCampaign(3, argv, exitRun) == 1);
+    CHECK(calls.size() == 3);
+    std::remove(filename.c_str());
+  }
+
+  SECTION("missing campaign file") {
+    CHECK_THROWS_WITH(ReadCampaign("does/not/exist"),
+                      Contains("Could not open"));
+  }
+}
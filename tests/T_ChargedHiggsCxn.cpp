@@ -3,7 +3,7 @@
 
 #include "catch.hpp"
 
-TEST_CASE("Hpt cxn interpolation", "[unit][interp]") {
+TEST_CASE("Hpt cxn interpolation", "[unit][interp][HBdata]") {
   ScannerS::Interfaces::HiggsBoundsSignals::HiggsBoundsSignals<1, 0> hbhs{};
 
   using ScannerS::Models::TwoHDM;
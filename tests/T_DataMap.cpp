@@ -1,5 +1,9 @@
 #include "ScannerS/DataMap.hpp"
 #include "catch.hpp"
+#include <array>
+#include <string>
+#include <thread>
+#include <vector>
 
 using Catch::Matchers::Contains;
 
@@ -13,6 +17,8 @@ TEST_CASE("DataMap", "[datamap][unit]") {
 
     REQUIRE(m["test"] == Approx(2));
     REQUIRE(m["test1"] == Approx(-0.1));
+    REQUIRE(m.Contains("test"));
+    REQUIRE_FALSE(m.Contains("test2"));
 
     size_t i = 0;
     for (auto [key, value] : m) {
@@ -27,6 +33,38 @@ TEST_CASE("DataMap", "[datamap][unit]") {
     m.Merge(std::move(map));
   }
 
+  SECTION("Registered keys") {
+    static const auto slotKey = ScannerS::DataMap::Key{"t_slot"};
+    static const auto otherKey = ScannerS::DataMap::Key{"t_other"};
+    REQUIRE(ScannerS::DataMap::Key{"t_slot"}.Slot() == slotKey.Slot());
+    REQUIRE(slotKey.Name() == "t_slot");
+
+    m.Store(slotKey, 1.5);
+    m.Store("t_other", 3);
+    m.Store("t_plain", 4);
+    REQUIRE(m[slotKey] == Approx(1.5));
+    REQUIRE(m["t_slot"] == Approx(1.5));
+    REQUIRE(m[otherKey] == Approx(3));
+    REQUIRE(m.Contains(otherKey));
+    REQUIRE_THROWS_WITH(m.Store(slotKey, 2), Contains("t_slot already exists"));
+    REQUIRE_THROWS_WITH(m.Store("t_other", 2),
+                        Contains("t_other already exists"));
+
+    // a key registered after it was stored by name
+    static const auto lateKey = ScannerS::DataMap::Key{"t_plain"};
+    REQUIRE(m[lateKey] == Approx(4));
+    REQUIRE_THROWS_WITH(m.Store(lateKey, 2),
+                        Contains("t_plain already exists"));
+
+    // iteration is in alphabetical order for both kinds of keys
+    m.Store("t_a", 0);
+    std::vector<std::string> keys;
+    for (const auto &[key, value] : m)
+      keys.push_back(key);
+    REQUIRE(keys == std::vector<std::string>{"t_a", "t_other", "t_plain",
+                                             "t_slot"});
+  }
+
   SECTION("Errors") {
     REQUIRE_THROWS_WITH(m["unknown_key"], "Unknown key unknown_key");
 
@@ -40,3 +78,29 @@ TEST_CASE("DataMap", "[datamap][unit]") {
                             Contains("can't be merged. Exists with value 2"));
   }
 }
+
+TEST_CASE("Concurrent DataMap key registration", "[datamap][unit]") {
+  using ScannerS::DataMap;
+  constexpr std::size_t nThreads = 4;
+  constexpr std::size_t nKeys = 200;
+  std::array<std::vector<std::size_t>, nThreads> slots;
+  std::vector<std::thread> threads;
+  for (std::size_t t = 0; t != nThreads; ++t)
+    threads.emplace_back([t, &slots]() {
+      for (std::size_t i = 0; i != nKeys; ++i) {
+        const auto name = "t_concurrent_" + std::to_string(i);
+        const auto key = DataMap::Key{name};
+        auto m = DataMap{};
+        m.Store(key, static_cast<double>(i));
+        if (m[name] != static_cast<double>(i) || key.Name() != name)
+          return;
+        slots[t].push_back(key.Slot());
+      }
+    });
+  for (auto &thread : threads)
+    thread.join();
+  for (const auto &s : slots) {
+    REQUIRE(s.size() == nKeys);
+    REQUIRE(s == slots[0]);
+  }
+}
@@ -1,13 +1,17 @@
 #include "ScannerS/Constants.hpp"
 #include "ScannerS/Constraints/Higgs.hpp"
+#include "ScannerS/DataMap.hpp"
 #include "ScannerS/Interfaces/HiggsBoundsSignals.hpp"
 #include "ScannerS/Models/C2HDM.hpp"
 #include "ScannerS/Models/R2HDM.hpp"
 #include "ScannerS/Utilities.hpp"
 #include "ScannerS/config.h"
 #include "catch.hpp"
+#include <array>
+#include <cstddef>
+#include <stdexcept>
 
-TEST_CASE("Getting SM values", "[unit][HB][HS]") {
+TEST_CASE("Getting SM values", "[unit][HB][HS][HBdata]") {
   using namespace ScannerS::Interfaces::HiggsBoundsSignals;
   HiggsBoundsSignals<1, 0> hbhs{};
   auto br = hbhs.GetSMBRs(125);
@@ -46,6 +50,188 @@ TEST_CASE("HS SM reference", "[unit][HB][HS]") {
   CHECK(res.chisqMu == Approx(Higgs::chisqMuSM));
 }
 
+TEST_CASE("HiggsBounds delta input", "[unit][HB][HS]") {
+  using namespace ScannerS::Interfaces::HiggsBoundsSignals;
+  using Neut1 = HBInputEffC<2, 0>::Neut1;
+  HiggsBoundsSignals<2, 0> hbhs{};
+
+  HBInputEffC<2, 0> sm;
+  sm.Mh << 125.09, 400;
+  sm.SetSMlikeScaled(Neut1::Constant(1.));
+  HBInputEffC<2, 0> scaled = sm;
+  scaled.SetSMlikeScaled(Neut1::Constant(0.8));
+  HBInputEffC<2, 0> heavy = sm;
+  heavy.Mh(1) = 600;
+
+  const auto resSM = hbhs.RunHBHS(sm);
+  const auto resScaled = hbhs.RunHBHS(scaled);
+  CHECK(resScaled.chisqMu != Approx(resSM.chisqMu));
+  CHECK(hbhs.RunHBHS(sm).chisqMu == Approx(resSM.chisqMu));
+  CHECK(hbhs.RunHBHS(sm).obsratio == resSM.obsratio);
+
+  const auto resHeavy = hbhs.RunHBHS(heavy);
+  CHECK(resHeavy.obsratio[2] != Approx(resSM.obsratio[2]));
+  CHECK(hbhs.RunHBHS(sm).obsratio == resSM.obsratio);
+
+  SECTION("another instance in between") {
+    HiggsBoundsSignals<2, 0> other{};
+    other.RunHBHS(scaled);
+    CHECK(hbhs.RunHBHS(sm).chisqMu == Approx(resSM.chisqMu));
+  }
+  SECTION("manual reset") {
+    hbhs.ResetInputCache();
+    CHECK(hbhs.RunHBHS(sm).chisqMu == Approx(resSM.chisqMu));
+  }
+}
+
+TEST_CASE("HiggsBounds result cache", "[unit][HB][HS]") {
+  using namespace ScannerS::Interfaces::HiggsBoundsSignals;
+  HiggsBoundsSignals<1, 0> hbhs{};
+  HBInputEffC<1, 0> in;
+  in.Mh(0) = 125.09;
+  in.SetSMlikeScaled(HBInputEffC<1, 0>::Neut1::Constant(1.));
+  HBInputEffC<1, 0> shifted = in;
+  shifted.Mh(0) *= 1 + 1e-9;
+
+  SECTION("exact") {
+    hbhs.SetResultCache({10, 0.});
+    const auto res = hbhs.RunHBHS(in);
+    CHECK(hbhs.ResultCacheStatistics().misses == 2);
+    const auto cached = hbhs.RunHBHS(in);
+    CHECK(hbhs.ResultCacheStatistics().hits == 2);
+    CHECK(cached.chisq == res.chisq);
+    CHECK(cached.obsratio == res.obsratio);
+    CHECK(cached.mu_gaga == res.mu_gaga);
+    hbhs.RunHBHS(shifted);
+    CHECK(hbhs.ResultCacheStatistics().hits == 2);
+    CHECK(hbhs.ResultCacheStatistics().misses == 4);
+  }
+
+  SECTION("quantized") {
+    hbhs.SetResultCache({10, 1e-6});
+    hbhs.RunHBHS(in);
+    hbhs.RunHBHS(shifted);
+    CHECK(hbhs.ResultCacheStatistics().hits == 2);
+    CHECK(hbhs.ResultCacheStatistics().misses == 2);
+  }
+
+  SECTION("full cache is cleared") {
+    hbhs.SetResultCache({1, 0.});
+    hbhs.RunHBHS(in);
+    hbhs.RunHBHS(shifted);
+    hbhs.RunHBHS(in);
+    CHECK(hbhs.ResultCacheStatistics().hits == 0);
+    CHECK(hbhs.ResultCacheStatistics().misses == 6);
+  }
+
+  SECTION("disabled") {
+    hbhs.RunHBHS(in);
+    hbhs.RunHBHS(in);
+    CHECK(hbhs.ResultCacheStatistics().hits == 0);
+    CHECK(hbhs.ResultCacheStatistics().misses == 0);
+  }
+}
+
+TEST_CASE("HiggsBounds analysis subsets", "[unit][HB][HS]") {
+  using namespace ScannerS::Interfaces::HiggsBoundsSignals;
+  CHECK(HBExperimentsFromString("onlyL") == HBExperiments::onlyL);
+  CHECK(HBExperimentsFromString("onlyH") == HBExperiments::onlyH);
+  CHECK(HBExperimentsFromString("LandH") == HBExperiments::LandH);
+  CHECK_THROWS_AS(HBExperimentsFromString("LHC13"), std::runtime_error);
+
+  HiggsBoundsSignals<1, 0> hbhs{{HBExperiments::onlyL, false}};
+  CHECK(hbhs.Analyses().hbExperiments == HBExperiments::onlyL);
+  CHECK_FALSE(hbhs.Analyses().hs);
+  HBInputEffC<1, 0> in;
+  in.Mh(0) = 125.09;
+  in.SetSMlikeScaled(HBInputEffC<1, 0>::Neut1::Constant(1.));
+  hbhs.SetInput(in);
+  CHECK(hbhs.RunHB().result[0] == 1);
+  CHECK_THROWS_AS(hbhs.RunHS(), std::runtime_error);
+
+  hbhs.Initialize({});
+  CHECK(hbhs.Analyses().hbExperiments == HBExperiments::LandH);
+  CHECK(hbhs.Analyses().hs);
+  const auto res = hbhs.RunHBHS(in);
+  CHECK(res.result[0] == 1);
+  CHECK(res.chisqMu > 0);
+}
+
+namespace {
+struct SMLikeModel {
+  static constexpr std::size_t nHzero = 1;
+  static constexpr std::size_t nHplus = 0;
+  static constexpr std::array namesHzero{"H"};
+  static constexpr std::array<const char *, 0> namesHplus{};
+  struct ParameterPoint {
+    double mH;
+    ScannerS::DataMap data;
+  };
+  static auto HiggsBoundsInput(
+      const ParameterPoint &p,
+      const ScannerS::Interfaces::HiggsBoundsSignals::HiggsBoundsSignals<1, 0>
+          &) {
+    using ScannerS::Interfaces::HiggsBoundsSignals::HBInputEffC;
+    HBInputEffC<1, 0> in;
+    in.Mh(0) = p.mH;
+    in.SetSMlikeScaled(HBInputEffC<1, 0>::Neut1::Constant(1.));
+    return in;
+  }
+};
+} // namespace
+
+TEST_CASE("Higgs constraint stages", "[unit][HB][HS]") {
+  using namespace ScannerS::Constraints;
+  using Stage = Higgs<SMLikeModel>::Stage;
+  auto sm = SMLikeModel::ParameterPoint{125.09, {}};
+  // excluded by LEP
+  auto light = SMLikeModel::ParameterPoint{50., {}};
+
+  SECTION("HiggsSignals is skipped for excluded points") {
+    auto higgs = Higgs<SMLikeModel>{Severity::apply, 6.18};
+    CHECK(higgs(sm));
+    CHECK_FALSE(higgs(light));
+    CHECK(higgs.Statistics(Stage::HiggsBounds).runs == 2);
+    CHECK(higgs.Statistics(Stage::HiggsSignals).runs == 1);
+    CHECK(higgs.SkippedHS() == 1);
+    CHECK(light.data.Contains("hb_result"));
+    CHECK_FALSE(light.data.Contains("hs_chisqMu"));
+  }
+
+  SECTION("HiggsSignals output for ignored constraint") {
+    auto higgs = Higgs<SMLikeModel>{Severity::ignore, 6.18};
+    CHECK(higgs(light));
+    CHECK(light.data["valid_Higgs"] == 0);
+    CHECK(light.data.Contains("hs_chisqMu"));
+    CHECK(higgs.SkippedHS() == 0);
+  }
+
+  SECTION("stage severities") {
+    auto higgs = Higgs<SMLikeModel>{
+        Severity::apply, {Severity::ignore, Severity::skip}, 6.18};
+    CHECK(higgs(light));
+    CHECK(light.data["valid_HiggsBounds"] == 0);
+    CHECK_FALSE(light.data.Contains("hs_chisqMu"));
+    CHECK(higgs.Statistics(Stage::HiggsSignals).runs == 0);
+    CHECK(light.data["hs_loaded"] == 0);
+    CHECK_THROWS_AS(
+        higgs.SetStageSeverity(Stage::HiggsSignals, Severity::apply),
+        std::runtime_error);
+  }
+
+  SECTION("initialized once for the same analyses") {
+    using namespace ScannerS::Interfaces::HiggsBoundsSignals;
+    auto higgs = Higgs<SMLikeModel>{Severity::apply, 6.18};
+    const auto nInit = Detail::nInitializations;
+    auto other = Higgs<SMLikeModel>{Severity::apply, 6.18};
+    CHECK(Detail::nInitializations == nInit);
+    CHECK(other(sm));
+    CHECK(sm.data["hb_experiments"] ==
+          static_cast<int>(HBExperiments::LandH));
+    CHECK(sm.data["hs_loaded"] == 1);
+  }
+}
+
 TEST_CASE("HiggsBounds Input", "[unit]") {
   using namespace ScannerS::Interfaces::HiggsBoundsSignals;
 
@@ -117,7 +303,8 @@ TEST_CASE("HiggsBounds Input", "[unit]") {
   REQUIRE_NOTHROW(hbhs.RunHBHS(hbinput));
 }
 
-TEST_CASE("R2HDM HBHS with hdecay", "[functional][R2HDM][HB][HS][hdecay]") {
+TEST_CASE("R2HDM HBHS with hdecay",
+          "[functional][R2HDM][HB][HS][hdecay][HBdata]") {
   using namespace ScannerS;
 
   Interfaces::HiggsBoundsSignals::HiggsBoundsSignals<Models::R2HDM::nHzero,
@@ -142,7 +329,7 @@ TEST_CASE("R2HDM HBHS with hdecay", "[functional][R2HDM][HB][HS][hdecay]") {
   CHECK(result.chisqMu == Approx(88.4332949635));
 }
 
-TEST_CASE("HS Hadr SM", "[functional][HB][HS]") {
+TEST_CASE("HS Hadr SM", "[functional][HB][HS][HBdata]") {
   using namespace ScannerS::Interfaces::HiggsBoundsSignals;
   using HBHS = ScannerS::Constraints::Higgs<ScannerS::Models::R2HDM>;
   HiggsBoundsSignals<1, 0> hbhs{};
@@ -0,0 +1,128 @@
+#include "ScannerS/Constraints/HiggsPreScreen.hpp"
+
+#include "ScannerS/Constraints/Constraint.hpp"
+#include "ScannerS/DataMap.hpp"
+#include "ScannerS/Interfaces/Lilith.hpp"
+#include "ScannerS/Tools/LilithCouplings.hpp"
+#include "catch.hpp"
+#include <array>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+using namespace ScannerS::Constraints;
+using namespace ScannerS::Interfaces::Lilith;
+using namespace std::string_literals;
+
+namespace {
+SignalStrengths Mu(const HiggsPreScreenDetail::Kappas &k, double mh) {
+  return HiggsPreScreenDetail::Mu(ScannerS::Tools::SharedLilithCouplings(), k,
+                                  mh);
+}
+
+double DeltaChisq(const HiggsPreScreenDetail::Kappas &k, double mh = 125.09) {
+  const auto &likelihood = SharedLikelihood();
+  return likelihood(Mu(k, mh)) - likelihood(SignalStrengths::SMLike());
+}
+} // namespace
+
+TEST_CASE("Approximate Higgs rates", "[unit][higgs]") {
+  const auto sm = Mu({1, 1, 0, 1, 0, 1, 0}, 125.09);
+  CHECK(sm(Production::ggH, Decay::gammagamma, Energy::lhc13) ==
+        Approx(1).margin(1e-6));
+  CHECK(sm(Production::ttH, Decay::bb, Energy::lhc13) ==
+        Approx(1).margin(1e-6));
+  // Lilith's quadratic forms do not add up to exactly one
+  CHECK(DeltaChisq({1, 1, 0, 1, 0, 1, 0}) == Approx(0).margin(0.01));
+
+  // suppressed gauge couplings enhance h->bb and reduce everything else
+  const auto lowV = Mu({0.8, 1, 0, 1, 0, 1, 0}, 125.09);
+  CHECK(lowV(Production::VBF, Decay::WW, Energy::lhc13) < 0.5);
+  CHECK(lowV(Production::ggH, Decay::bb, Energy::lhc13) > 1);
+  CHECK(DeltaChisq({0.8, 1, 0, 1, 0, 1, 0}) > 20);
+
+  // masses outside of the Lilith grids are clamped
+  CHECK(DeltaChisq({1, 1, 0, 1, 0, 1, 0}, 130.) ==
+        Approx(DeltaChisq({1, 1, 0, 1, 0, 1, 0}, 128.)));
+  // a large CP-odd top coupling strongly enhances gluon fusion
+  const auto cpOdd = Mu({1, 1, 1, 1, 0, 1, 0}, 125.09);
+  CHECK(cpOdd(Production::ggH, Decay::ZZ, Energy::lhc13) /
+            cpOdd(Production::VBF, Decay::ZZ, Energy::lhc13) >
+        3);
+}
+
+namespace {
+struct TestModel {
+  static constexpr std::array namesHzero{"H1", "H2"};
+  struct ParameterPoint {
+    std::array<double, 2> mHi;
+    ScannerS::DataMap data;
+  };
+  static std::array<double, 2> MassesHzero(const ParameterPoint &p) {
+    return p.mHi;
+  }
+};
+
+TestModel::ParameterPoint Point(double cVV) {
+  auto p = TestModel::ParameterPoint{{125.09, 500.}, {}};
+  p.data.Store("c_H1VV", cVV);
+  p.data.Store("c_H1uu_e", 1.);
+  p.data.Store("c_H1dd_e", 1.);
+  p.data.Store("c_H1ll_e", 1.);
+  p.data.Store("c_H2VV", 0.);
+  p.data.Store("c_H2uu_e", 1.);
+  p.data.Store("c_H2dd_e", 1.);
+  p.data.Store("c_H2ll_e", 1.);
+  return p;
+}
+} // namespace
+
+TEST_CASE("Higgs pre-screen constraint", "[unit][higgs]") {
+  auto prescreen = HiggsPreScreen<TestModel>{Severity::apply, 6.18, 5.};
+
+  auto smLike = Point(1.);
+  REQUIRE(prescreen(smLike));
+  CHECK(smLike.data["prescreen_deltaChisq"] == Approx(0).margin(0.01));
+
+  auto slightlyOff = Point(0.97);
+  REQUIRE(prescreen(slightlyOff));
+
+  auto excluded = Point(0.7);
+  REQUIRE_FALSE(prescreen(excluded));
+  CHECK(excluded.data["prescreen_deltaChisq"] > 11.18);
+
+  auto ignored = HiggsPreScreen<TestModel>{Severity::ignore, 6.18, 5.};
+  auto p = Point(0.7);
+  REQUIRE(ignored(p));
+  CHECK(p.data["valid_HiggsPreScreen"] == 0);
+
+  // two degenerate scalars that share the SM rates are combined
+  auto split = TestModel::ParameterPoint{{125.09, 126.}, {}};
+  for (const auto *name : {"H1", "H2"})
+    for (const auto *c : {"VV", "uu_e", "dd_e", "ll_e"})
+      split.data.Store("c_"s + name + c, std::sqrt(0.5));
+  REQUIRE(prescreen(split));
+  CHECK(split.data["prescreen_deltaChisq"] < 1);
+
+  // the couplings are required
+  auto noCouplings = TestModel::ParameterPoint{{125.09, 500.}, {}};
+  CHECK_THROWS_AS(prescreen(noCouplings), std::runtime_error);
+
+  // there is no default margin
+  constexpr double noMargin = std::numeric_limits<double>::quiet_NaN();
+  CHECK(HiggsPreScreen<TestModel>::defaultSeverity == Severity::skip);
+  CHECK_THROWS_AS((HiggsPreScreen<TestModel>{Severity::apply, 6.18, noMargin}),
+                  std::runtime_error);
+  auto skipped = HiggsPreScreen<TestModel>{Severity::skip, 6.18, noMargin};
+  auto q = Point(0.7);
+  REQUIRE(skipped(q));
+  CHECK_FALSE(q.data.Contains("prescreen_deltaChisq"));
+
+  // the Lilith data is only read if the pre-screen is used
+  CHECK_NOTHROW(
+      HiggsPreScreen<TestModel>{Severity::skip, 6.18, 5., "nonexistent"});
+  CHECK_THROWS_AS(
+      (HiggsPreScreen<TestModel>{Severity::apply, 6.18, 5., "nonexistent"}),
+      std::runtime_error);
+}
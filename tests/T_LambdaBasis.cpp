@@ -0,0 +1,213 @@
+#include "ScannerS/Tools/LambdaBasis.hpp"
+
+#include "ScannerS/Constants.hpp"
+#include "ScannerS/Models/C2HDM.hpp"
+#include "ScannerS/Models/R2HDM.hpp"
+#include "ScannerS/Tools/HitAndRun.hpp"
+#include "catch.hpp"
+#include <random>
+
+TEST_CASE("Hit-and-run sampling", "[unit][sampling]") {
+  using ScannerS::Tools::HitAndRun;
+  HitAndRun<2> disk{[](const std::array<double, 2> &x) {
+                      return x[0] * x[0] + x[1] * x[1] < 1;
+                    },
+                    {-2, -2},
+                    {2, 2}};
+  std::mt19937 rGen{123};
+  constexpr size_t n = 100000;
+  double mean = 0;
+  double meanRsq = 0;
+  for (size_t i = 0; i != n; ++i) {
+    auto x = disk(rGen);
+    REQUIRE(x[0] * x[0] + x[1] * x[1] < 1);
+    mean += x[0] + x[1];
+    meanRsq += x[0] * x[0] + x[1] * x[1];
+  }
+  CHECK(mean / n == Approx(0).margin(0.02));
+  CHECK(meanRsq / n == Approx(0.5).margin(0.01));
+
+  HitAndRun<2> empty{[](const std::array<double, 2> &) { return false; },
+                     {0, 0},
+                     {1, 1},
+                     100};
+  REQUIRE_THROWS(empty(rGen));
+
+  HitAndRun<2> annulus{[](const std::array<double, 2> &x) {
+                         const double rsq = x[0] * x[0] + x[1] * x[1];
+                         return rsq < 1 && rsq > 0.25;
+                       },
+                       {-1, -1},
+                       {1, 1},
+                       1000,
+                       1e-6,
+                       false};
+  double meanX = 0;
+  meanRsq = 0;
+  for (size_t i = 0; i != n; ++i) {
+    auto x = annulus(rGen);
+    const double rsq = x[0] * x[0] + x[1] * x[1];
+    REQUIRE(rsq < 1);
+    REQUIRE(rsq > 0.25);
+    meanX += x[0];
+    meanRsq += rsq;
+  }
+  CHECK(meanX / n == Approx(0).margin(0.02));
+  // <r^2> = (1 - 0.5^4) / (2 (1 - 0.5^2))
+  CHECK(meanRsq / n == Approx(0.625).margin(0.01));
+}
+
+TEST_CASE("R2HDM lambda basis", "[unit][R2HDM]") {
+  using namespace ScannerS::Models;
+  using ScannerS::Tools::LambdaBasis::R2HDMInput;
+  SECTION("Reference point") {
+    auto in = R2HDMInput({{6.69060770e-01, 2.72715608e-01, 1.30684681e+00,
+                           -5.64127725e-01, -5.64127725e-01},
+                          2.5,
+                          2000,
+                          R2HDM::Yuk::typeI,
+                          ScannerS::Constants::vEW});
+    REQUIRE(in);
+    CHECK(in->mHa == Approx(125.09));
+    CHECK(in->mHb == Approx(100));
+    CHECK(in->mA == Approx(200));
+    CHECK(in->mHp == Approx(200));
+    CHECK(in->alpha == Approx(1.24031081));
+  }
+
+  SECTION("Solve for L1") {
+    using ScannerS::Tools::LambdaBasis::SolveL1;
+    const R2HDM::LambdaInput in{{0, 2.72715608e-01, 1.30684681e+00,
+                                 -5.64127725e-01, -5.64127725e-01},
+                                2.5,
+                                2000,
+                                R2HDM::Yuk::typeI,
+                                ScannerS::Constants::vEW};
+    // the reference values of the masses are rounded
+    for (double mh : {125.09, 100.}) {
+      auto solved = SolveL1(in, mh);
+      REQUIRE(solved);
+      CHECK(solved->L[0] == Approx(6.69060770e-01).epsilon(1e-3));
+    }
+    for (double mh : {90., 140., 300.}) {
+      auto solved = SolveL1(in, mh);
+      REQUIRE(solved);
+      auto res = R2HDMInput(*solved);
+      REQUIRE(res);
+      CHECK((res->mHa == Approx(mh) || res->mHb == Approx(mh)));
+    }
+  }
+
+  SECTION("Fixed mass sampler") {
+    auto sampler = ScannerS::Tools::LambdaBasis::FixedMassSampler<R2HDM>{
+        {0, 0, -10, -15, -15}, {10, 10, 20, 15, 15}, {0.8, 25}, {1e-3, 5e5}};
+    std::mt19937 rGen{42};
+    for (size_t i = 0; i != 100; ++i) {
+      const auto lin = sampler(rGen, R2HDM::Yuk::typeII);
+      REQUIRE(lin.type == R2HDM::Yuk::typeII);
+      REQUIRE(R2HDM::BFB(lin.L));
+      REQUIRE(R2HDM::MaxUnitarityEV(lin.L) < 8 * ScannerS::Constants::pi);
+      auto in = R2HDMInput(lin);
+      REQUIRE(in);
+      CHECK((in->mHa == Approx(125.09) || in->mHb == Approx(125.09)));
+    }
+  }
+
+  SECTION("Tachyonic") {
+    REQUIRE_FALSE(R2HDMInput({{1, 1, 1, 1, 5},
+                              2.5,
+                              100,
+                              R2HDM::Yuk::typeI,
+                              ScannerS::Constants::vEW}));
+  }
+
+  SECTION("Round trip") {
+    auto sampler =
+        ScannerS::Tools::LambdaBasis::AllowedRegionSampler<R2HDM, 5>(
+            {0, 0, -10, -15, -15}, {10, 10, 20, 15, 15});
+    std::mt19937 rGen{42};
+    for (size_t i = 0; i != 100; ++i) {
+      const auto L = sampler(rGen);
+      REQUIRE(R2HDM::BFB(L));
+      REQUIRE(R2HDM::MaxUnitarityEV(L) < 8 * ScannerS::Constants::pi);
+      auto in = R2HDMInput({L, 3., 1e5, R2HDM::Yuk::typeII,
+                            ScannerS::Constants::vEW});
+      if (!in)
+        continue;
+      R2HDM::ParameterPoint p{*in};
+      for (size_t j = 0; j != L.size(); ++j)
+        CHECK(p.L[j] == Approx(L[j]).margin(1e-8));
+    }
+  }
+}
+
+TEST_CASE("C2HDM lambda basis", "[unit][C2HDM]") {
+  using namespace ScannerS::Models;
+  using ScannerS::Tools::LambdaBasis::C2HDMInput;
+  SECTION("Reference point") {
+    auto in = C2HDMInput({{0.634227, 0.251456, 0.32359099999999996, -0.467578,
+                           -0.0792753, 0.200982},
+                          12.0654,
+                          992.864,
+                          C2HDM::Yuk::typeI,
+                          ScannerS::Constants::vEW});
+    REQUIRE(in);
+    CHECK(in->mHa == Approx(86.7419));
+    CHECK(in->mHb == Approx(125.09));
+    CHECK(in->mHp == Approx(169.227));
+    CHECK(in->a1 == Approx(0.307239));
+    CHECK(in->a2 == Approx(0.566229));
+    CHECK(in->a3 == Approx(-0.311308));
+  }
+
+  SECTION("Solve for L1") {
+    using ScannerS::Tools::LambdaBasis::SolveL1;
+    auto solved = SolveL1({{0, 0.251456, 0.32359099999999996, -0.467578,
+                            -0.0792753, 0.200982},
+                           12.0654,
+                           992.864,
+                           C2HDM::Yuk::typeI,
+                           ScannerS::Constants::vEW},
+                          125.09);
+    REQUIRE(solved);
+    CHECK(solved->L[0] == Approx(0.634227).epsilon(5e-3));
+    auto res = C2HDMInput(*solved);
+    REQUIRE(res);
+    CHECK(res->mHb == Approx(125.09));
+  }
+
+  SECTION("Fixed mass sampler") {
+    auto sampler = ScannerS::Tools::LambdaBasis::FixedMassSampler<C2HDM>{
+        {0, 0, -10, -15, -15, -15},
+        {10, 10, 20, 15, 15, 15},
+        {0.8, 20},
+        {1e-3, 5e5}};
+    std::mt19937 rGen{42};
+    for (size_t i = 0; i != 100; ++i) {
+      auto in = C2HDMInput(sampler(rGen, C2HDM::Yuk::typeII));
+      REQUIRE(in);
+      C2HDM::ParameterPoint p{*in};
+      REQUIRE(C2HDM::Valid(p));
+      CHECK((p.mHi[0] == Approx(125.09) || p.mHi[1] == Approx(125.09) ||
+             p.mHi[2] == Approx(125.09)));
+    }
+  }
+
+  SECTION("Round trip") {
+    auto sampler =
+        ScannerS::Tools::LambdaBasis::AllowedRegionSampler<C2HDM, 6>(
+            {0, 0, -10, -15, -15, -15}, {10, 10, 20, 15, 15, 15});
+    std::mt19937 rGen{42};
+    for (size_t i = 0; i != 100; ++i) {
+      const auto L = sampler(rGen);
+      auto in = C2HDMInput({L, 3., 1e5, C2HDM::Yuk::typeII,
+                            ScannerS::Constants::vEW});
+      if (!in)
+        continue;
+      C2HDM::ParameterPoint p{*in};
+      REQUIRE(C2HDM::Valid(p));
+      for (size_t j = 0; j != L.size(); ++j)
+        CHECK(p.L[j] == Approx(L[j]).margin(1e-6));
+    }
+  }
+}
@@ -0,0 +1,197 @@
+#include "ScannerS/Constraints/Constraint.hpp"
+#include "ScannerS/Constraints/Lilith.hpp"
+#include "ScannerS/DataMap.hpp"
+#include "ScannerS/Interfaces/Lilith.hpp"
+#include "ScannerS/Tools/LilithCouplings.hpp"
+#include "ScannerS/config.h"
+
+#include "catch.hpp"
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+using namespace ScannerS::Interfaces::Lilith;
+
+// a deterministic non-SM set of signal strengths
+SignalStrengths Pattern(double scale) {
+  auto mu = SignalStrengths{};
+  for (std::size_t i = 0; i != nProductions; ++i)
+    for (std::size_t j = 0; j != nDecays; ++j) {
+      const auto decay = static_cast<Decay>(j);
+      mu.Set(static_cast<Production>(i), decay,
+             scale * (decay == Decay::invisible
+                          ? std::fmod(0.05 * (i + 2 * j), 0.5)
+                          : 0.6 + 0.09 * ((3 * i + 5 * j) % 11)));
+    }
+  return mu;
+}
+
+// Lilith3/userinput/example_mu_multiH.xml
+SignalStrengths ExampleMultiH() {
+  auto heavy = SignalStrengths::SMLike();
+  for (auto decay : {Decay::gammagamma, Decay::WW, Decay::ZZ, Decay::bb,
+                     Decay::tautau}) {
+    heavy.Set(Production::ggH, decay, 0.1);
+    for (auto prod : {Production::VBF, Production::WH, Production::qqZH,
+                      Production::ggZH, Production::ttH})
+      heavy.Set(prod, decay, 0.);
+  }
+  auto total = SignalStrengths::SMLike();
+  total += heavy;
+  return total;
+}
+
+struct LilithModel {
+  struct ParameterPoint {
+    double scale;
+    ScannerS::DataMap data;
+  };
+  static SignalStrengths
+  LilithSignalStrengths(const ParameterPoint &p,
+                        const ScannerS::Tools::LilithCouplings &) {
+    return p.scale == 1. ? SignalStrengths::SMLike() : Pattern(p.scale);
+  }
+};
+} // namespace
+
+TEST_CASE("Lilith likelihood", "[unit][Lilith]") {
+  const auto &lilith = SharedLikelihood();
+  REQUIRE(&lilith == &SharedLikelihood(DefaultList()));
+  CHECK(lilith.Measurements().size() == 29);
+  CHECK(lilith.NObservables() == 66);
+
+  // reference values from the Python implementation
+  SECTION("userinput examples") {
+    CHECK(lilith(SignalStrengths::SMLike()) == Approx(54.783324));
+    CHECK(lilith(ExampleMultiH()) == Approx(53.540421));
+  }
+
+  SECTION("all likelihood types") {
+    CHECK(lilith(Pattern(1.)) == Approx(113.3967383505078).epsilon(1e-10));
+    CHECK(lilith(Pattern(0.7)) == Approx(159.56275122963746).epsilon(1e-10));
+    const auto run1 =
+        Likelihood::FromList(SCANNERS_LILITH_DIR "/data/finalRun1.list");
+    CHECK(run1(SignalStrengths::SMLike()) ==
+          Approx(25.94823884578758).epsilon(1e-10));
+    CHECK(run1(Pattern(1.)) == Approx(51.71131244141119).epsilon(1e-10));
+  }
+
+  SECTION("contributions") {
+    const auto mu = Pattern(0.9);
+    const auto contributions = lilith.Contributions(mu);
+    REQUIRE(contributions.size() == lilith.Measurements().size());
+    double sum = 0.;
+    for (std::size_t i = 0; i != contributions.size(); ++i) {
+      CHECK(contributions[i] == lilith.Measurements()[i](mu));
+      sum += contributions[i];
+    }
+    CHECK(sum == Approx(lilith(mu)));
+  }
+
+  SECTION("signal strengths") {
+    auto mu = SignalStrengths::SMLike();
+    CHECK(mu(Production::ttH, Decay::bb, Energy::lhc13) == 1.);
+    CHECK(mu(Production::VBF, Decay::invisible, Energy::run1) == 0.);
+    mu.Set(Production::VBF, Decay::invisible, 0.3);
+    CHECK(mu(Production::VBF, Decay::invisible, Energy::run1) == 0.3);
+    CHECK(mu(Production::VBF, Decay::invisible, Energy::lhc13) == 0.3);
+  }
+
+  CHECK_THROWS_AS(ReadMeasurement("nonexistent.xml"), std::runtime_error);
+  CHECK_THROWS_AS(Likelihood::FromList(SCANNERS_LILITH_DIR "/README"),
+                  std::runtime_error);
+}
+
+TEST_CASE("Lilith database", "[unit][Lilith]") {
+  using Catch::Matchers::Contains;
+  const auto &lilith = SharedLikelihood();
+  const std::string filename = "T_Lilith_test.ldb";
+  WriteDatabase(lilith, filename);
+  REQUIRE(IsDatabase(filename));
+  CHECK_FALSE(IsDatabase(DefaultList()));
+
+  SECTION("reproduces the input") {
+    const auto db = Likelihood::FromDatabase(filename);
+    REQUIRE(db.Measurements().size() == lilith.Measurements().size());
+    CHECK(db.NObservables() == lilith.NObservables());
+    for (double scale : {0.5, 1., 1.3}) {
+      const auto mu = Pattern(scale);
+      CHECK(db.Contributions(mu) == lilith.Contributions(mu));
+    }
+    const auto run1 = Likelihood::FromList(SCANNERS_LILITH_DIR
+                                           "/data/finalRun1.list");
+    WriteDatabase(run1, filename);
+    CHECK(SharedLikelihood(filename)(Pattern(1.)) == run1(Pattern(1.)));
+  }
+
+  SECTION("invalid databases") {
+    std::filesystem::resize_file(filename, 4096);
+    CHECK_THROWS_WITH(Likelihood::FromDatabase(filename), Contains("size"));
+    {
+      std::ofstream file{filename, std::ios::binary | std::ios::in};
+      file.seekp(8);
+      file.put(char{99});
+    }
+    CHECK_THROWS_WITH(Likelihood::FromDatabase(filename), Contains("version"));
+    CHECK_THROWS_AS(Likelihood::FromDatabase(DefaultList()),
+                    std::runtime_error);
+    CHECK_THROWS_AS(Likelihood::FromDatabase("nonexistent.ldb"),
+                    std::runtime_error);
+  }
+
+  SECTION("mismatching dimension") {
+    auto words = std::vector<std::uint64_t>(
+        std::filesystem::file_size(filename) / sizeof(std::uint64_t));
+    {
+      std::ifstream file{filename, std::ios::binary};
+      file.read(reinterpret_cast<char *>(words.data()),
+                static_cast<std::streamsize>(words.size() * 8));
+    }
+    // type and number of axes of the first record after the 4 header words
+    const auto first = words[4];
+    REQUIRE(words[first + 3] < 3);
+    words[first] = LikelihoodType{NormalND{}}.index();
+    {
+      std::ofstream file{filename, std::ios::binary};
+      file.write(reinterpret_cast<const char *>(words.data()),
+                 static_cast<std::streamsize>(words.size() * 8));
+    }
+    CHECK_THROWS_WITH(Likelihood::FromDatabase(filename),
+                      Contains("dimension"));
+  }
+  std::remove(filename.c_str());
+}
+
+TEST_CASE("Lilith constraint", "[unit][Lilith]") {
+  using namespace ScannerS::Constraints;
+  auto constr = Lilith<LilithModel>{Severity::apply, 6.18};
+  CHECK(constr.ChisqSM() == Approx(54.783324));
+
+  auto sm = LilithModel::ParameterPoint{1., {}};
+  CHECK(constr(sm));
+  CHECK(sm.data["lilith_chisq"] == Approx(54.783324));
+
+  auto off = LilithModel::ParameterPoint{0.7, {}};
+  CHECK_FALSE(constr(off));
+  CHECK(off.data["lilith_chisq"] == Approx(159.56275122963746));
+
+  auto ignored = Lilith<LilithModel>{Severity::ignore, 6.18};
+  auto offIgnored = LilithModel::ParameterPoint{0.7, {}};
+  CHECK(ignored(offIgnored));
+  CHECK(offIgnored.data["valid_Lilith"] == 0);
+
+  // skipped by default without reading the Lilith data
+  CHECK(Lilith<LilithModel>::defaultSeverity == Severity::skip);
+  auto skipped = Lilith<LilithModel>{Severity::skip, 6.18, "nonexistent",
+                                     "nonexistent"};
+  auto offSkipped = LilithModel::ParameterPoint{0.7, {}};
+  CHECK(skipped(offSkipped));
+  CHECK_FALSE(offSkipped.data.Contains("lilith_chisq"));
+}
@@ -0,0 +1,137 @@
+#include "ScannerS/Interfaces/Lilith.hpp"
+#include "ScannerS/Tools/LilithCouplings.hpp"
+
+#include "catch.hpp"
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+using ScannerS::Tools::LilithCouplings;
+using ScannerS::Tools::SharedLilithCouplings;
+using Coupling = LilithCouplings::Coupling;
+using namespace ScannerS::Interfaces::Lilith;
+
+LilithCouplings::Higgs State(const std::vector<double> &required, double m) {
+  auto h = LilithCouplings::Higgs{};
+  for (std::size_t i = 0; i != required.size(); ++i)
+    h.c[i] = required[i];
+  h.m = m;
+  return h;
+}
+
+// equal couplings to W and Z bosons
+LilithCouplings::Higgs StateA() {
+  auto h = State({1.1, 0.9, 1.05, 0.92, 1.0, 0.95, 0.95}, 124.3);
+  h.brInvisible = 0.05;
+  h.brUndetected = 0.02;
+  return h;
+}
+
+// different couplings to W and Z bosons and a given coupling to photons
+LilithCouplings::Higgs StateB() {
+  auto h = State({-0.9, 1.15, 0.8, 1.1, 0.7, 1.02, 0.93}, 126.7);
+  h(Coupling::gammagamma) = 1.2;
+  h.brUndetected = 0.1;
+  return h;
+}
+} // namespace
+
+// reference values from lilith/internal/batch.py
+TEST_CASE("Lilith reduced couplings", "[unit][Lilith]") {
+  const auto &lc = SharedLilithCouplings();
+
+  SECTION("computed couplings") {
+    const auto a = lc.Complete(StateA());
+    CHECK(a(Coupling::tt) == 1.1);
+    CHECK(a(Coupling::gammagamma) == Approx(0.9094068169777745));
+    CHECK(a(Coupling::Zgamma) == Approx(0.9410458066807953));
+    CHECK(a(Coupling::ggDecay) == Approx(1.1108003074068762));
+    CHECK(a(Coupling::ggProdLHC8) == Approx(1.1050134390611268));
+    CHECK(a(Coupling::ggProdLHC13) == Approx(1.1045358422357603));
+    CHECK(a(Coupling::VBF) == 0.95);
+    CHECK(a(Coupling::VBF13) == Approx(0.95));
+    CHECK(a(Coupling::WH) == 0.95);
+    CHECK(a(Coupling::qqZH) == 0.95);
+    CHECK(a(Coupling::tHq) == Approx(0.9917686222098382));
+    CHECK(a(Coupling::tHW13) == Approx(1.0930530636707447));
+    CHECK(a(Coupling::ggZH) == Approx(0.884318381579847));
+    CHECK(a(Coupling::ggZH13) == Approx(0.8796001932696471));
+
+    const auto b = lc.Complete(StateB());
+    CHECK(b(Coupling::gammagamma) == 1.2);
+    CHECK(b(Coupling::Zgamma) == Approx(1.1327093164377315));
+    CHECK(b(Coupling::ggDecay) == Approx(1.0425963929320086));
+    CHECK(b(Coupling::ggProdLHC8) == Approx(0.9635535310222106));
+    CHECK(b(Coupling::WH) == 1.02);
+    CHECK(b(Coupling::qqZH) == 0.93);
+    CHECK(b(Coupling::tHq13) == Approx(3.261744809147399));
+    CHECK(b(Coupling::ggZH13) == Approx(2.017504151172929));
+    // Lilith smooths the VBF grids instead of interpolating them
+    CHECK(b(Coupling::VBF) == Approx(0.9983598056357552).epsilon(1e-4));
+    CHECK(b(Coupling::VBF13) == Approx(0.9982726635255859).epsilon(1e-4));
+  }
+
+  SECTION("invalid input") {
+    auto h = StateA();
+    h(Coupling::mumu) = std::nan("");
+    REQUIRE_THROWS_AS(lc.Complete(h), std::runtime_error);
+    REQUIRE_THROWS_AS(lc.Mu(std::vector{StateB(), h}), std::runtime_error);
+    h = StateA();
+    h.m = 130.;
+    REQUIRE_THROWS_AS(lc.Complete(h), std::runtime_error);
+    REQUIRE_THROWS_AS(lc.TotalMu(std::vector{h}), std::runtime_error);
+  }
+}
+
+TEST_CASE("Lilith signal strengths from reduced couplings",
+          "[unit][Lilith]") {
+  const auto &lc = SharedLilithCouplings();
+  const auto mu = lc.Mu(std::array{StateA(), StateB()});
+
+  SECTION("signal strengths") {
+    const auto &a = mu[0];
+    CHECK(a(Production::ggH, Decay::gammagamma, Energy::run1) ==
+          Approx(1.0686174993004982));
+    CHECK(a(Production::VBF, Decay::ZZ, Energy::lhc13) ==
+          Approx(0.8619164557240596));
+    CHECK(a(Production::ttH, Decay::bb, Energy::run1) ==
+          Approx(1.0371489700111582));
+    CHECK(a(Production::ggZH, Decay::invisible, Energy::lhc13) ==
+          Approx(0.038684825000000034));
+
+    const auto &b = mu[1];
+    CHECK(b(Production::tHq, Decay::tautau, Energy::lhc13) ==
+          Approx(9.699794484638941));
+    CHECK(b(Production::bbH, Decay::mumu, Energy::lhc13) ==
+          Approx(0.48828003081908683));
+    CHECK(b(Production::ggH, Decay::invisible, Energy::run1) == 0.);
+    CHECK(b(Production::VBF, Decay::WW, Energy::run1) ==
+          Approx(0.7813609841924505).epsilon(1e-4));
+  }
+
+  SECTION("total signal strengths") {
+    const auto total = lc.TotalMu(std::vector{StateA(), StateB()});
+    for (std::size_t i = 0; i != total.mu.size(); ++i)
+      CHECK(total.mu[i] == Approx(mu[0].mu[i] + mu[1].mu[i]));
+  }
+
+  SECTION("SM") {
+    const auto sm = lc.TotalMu(std::array{LilithCouplings::Higgs::SMLike()});
+    const auto expected = SignalStrengths::SMLike();
+    for (std::size_t i = 0; i != nProductions; ++i)
+      for (std::size_t j = 0; j != nDecays; ++j) {
+        const auto prod = static_cast<Production>(i);
+        const auto decay = static_cast<Decay>(j);
+        // some quadratic forms of Lilith do not add up to exactly one
+        const bool rounded =
+            prod == Production::ggZH || prod == Production::tHW;
+        const double eps = rounded ? 2e-3 : 1e-12;
+        for (auto energy : {Energy::run1, Energy::lhc13})
+          CHECK(sm(prod, decay, energy) ==
+                Approx(expected(prod, decay, energy)).epsilon(eps));
+      }
+  }
+}
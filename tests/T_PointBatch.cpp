@@ -0,0 +1,72 @@
+#include "ScannerS/Tools/PointBatch.hpp"
+
+#include "ScannerS/Constants.hpp"
+#include "ScannerS/Models/R2HDM.hpp"
+#include "catch.hpp"
+#include <cmath>
+#include <vector>
+
+using ScannerS::Models::R2HDM;
+
+TEST_CASE("R2HDM point batch", "[unit][R2HDM]") {
+  const auto v = ScannerS::Constants::vEW;
+  const auto in = std::vector<R2HDM::AngleInput>{
+      {125.09, 100, 200, 200, 1.24031081, 2.5, 2000, R2HDM::Yuk::typeI, v},
+      {100, 125.09, 200, 200, -0.330486, 2.5, 2000, R2HDM::Yuk::typeII, v},
+      {125.09, 600, 650, 650, 0.5, 5, 1e5, R2HDM::Yuk::typeI, v}};
+  auto batch = ScannerS::Tools::PointBatch<R2HDM>{in};
+  REQUIRE(batch.size() == 3);
+  REQUIRE(batch.Survivors() == std::vector<size_t>{0, 1, 2});
+
+  const auto &cols = batch.Columns();
+  for (size_t i = 0; i != 2; ++i) {
+    CHECK(cols.mHl[i] == 100);
+    CHECK(cols.mHh[i] == 125.09);
+    CHECK(cols.alpha[i] == Approx(1.24031081));
+    CHECK(cols.L[0][i] == Approx(6.69060770e-01));
+    CHECK(cols.L[1][i] == Approx(2.72715608e-01));
+    CHECK(cols.L[2][i] == Approx(1.30684681e+00));
+    CHECK(cols.L[3][i] == Approx(-5.64127725e-01));
+    CHECK(cols.L[4][i] == Approx(-5.64127725e-01));
+    CHECK(cols.m11sq[i] == Approx(-2464.1668706409));
+    CHECK(cols.m22sq[i] == Approx(-7073.0991108036));
+  }
+  CHECK(cols.type[1] == R2HDM::Yuk::typeII);
+  CHECK(cols.mHl[2] == 125.09);
+
+  // FillBatch and the constructor share R2HDM::PotentialParameters
+  for (size_t i = 0; i != batch.size(); ++i) {
+    const auto p = batch.Materialize(i);
+    CHECK(cols.mHl[i] == p.mHl);
+    CHECK(cols.alpha[i] == Approx(p.alpha));
+    for (size_t j = 0; j != p.L.size(); ++j)
+      CHECK(cols.L[j][i] == Approx(p.L[j]));
+    CHECK(cols.m11sq[i] == Approx(p.m11sq));
+    CHECK(cols.m22sq[i] == Approx(p.m22sq));
+  }
+
+  REQUIRE(batch.Filter([](const auto &c, size_t i) {
+    return c.type[i] == R2HDM::Yuk::typeI;
+  }) == 2);
+  REQUIRE(batch.Survivors() == std::vector<size_t>{0, 2});
+  REQUIRE(batch.Filter([](const auto &c, size_t i) {
+    return c.mHh[i] > 500;
+  }) == 1);
+  REQUIRE(batch.Survivors() == std::vector<size_t>{2});
+  CHECK(batch.Input(2).mHb == 600);
+
+  SECTION("physical input") {
+    const auto phys = std::vector<R2HDM::PhysicalInput>{
+        {125.09, 100, 200, 200, -0.05, 2.5, 2000, R2HDM::Yuk::typeI, v},
+        {100, 125.09, 200, 200, 9.98749218e-01, 2.5, 2000, R2HDM::Yuk::typeI,
+         v}};
+    batch.Assign(phys);
+    REQUIRE(batch.Survivors() == std::vector<size_t>{0, 1});
+    for (size_t i = 0; i != 2; ++i) {
+      CHECK(batch.Columns().alpha[i] == Approx(1.24031081));
+      CHECK(std::sin(std::atan(batch.Columns().tbeta[i]) -
+                     batch.Columns().alpha[i]) == Approx(-0.05));
+      CHECK(batch.Columns().L[2][i] == Approx(1.30684681e+00));
+    }
+  }
+}
@@ -0,0 +1,142 @@
+#include "ScannerS/Tools/Prior.hpp"
+
+#include "catch.hpp"
+#include <random>
+#include <string>
+#include <vector>
+
+using Catch::Matchers::Contains;
+using ScannerS::Tools::Prior;
+
+namespace {
+// weighted mean of the parameter values, weighted by the Jacobian
+template <class RNG> double ReweightedMean(Prior &prior, RNG &rGen) {
+  constexpr size_t n = 200000;
+  double sumW = 0;
+  double sumWx = 0;
+  for (size_t i = 0; i != n; ++i) {
+    const double x = prior(rGen);
+    sumW += prior.Jacobian();
+    sumWx += prior.Jacobian() * x;
+  }
+  return sumWx / sumW;
+}
+} // namespace
+
+TEST_CASE("Prior distributions", "[unit][sampling]") {
+  std::mt19937 rGen{321};
+
+  SECTION("uniform") {
+    auto prior = Prior("x", {"-1", "3"});
+    REQUIRE(prior.Flat());
+    REQUIRE(prior.Min() == -1);
+    REQUIRE(prior.Max() == 3);
+    const double x = prior(rGen);
+    REQUIRE(x >= -1);
+    REQUIRE(x <= 3);
+    REQUIRE(prior.Jacobian() == Approx(4));
+
+    auto fixed = Prior("x", {"uniform", "125.09", "125.09"});
+    REQUIRE(fixed(rGen) == 125.09);
+    REQUIRE(fixed.Jacobian() == 1);
+
+    auto type = Prior("type", {"1", "4"}, true);
+    for (size_t i = 0; i != 100; ++i) {
+      const double t = type(rGen);
+      REQUIRE(t == static_cast<int>(t));
+      REQUIRE(t >= 1);
+      REQUIRE(t <= 4);
+    }
+    REQUIRE(type.Jacobian() == 4);
+  }
+
+  SECTION("log-uniform") {
+    auto prior = Prior("m12sq", {"log", "1", "100"});
+    REQUIRE_FALSE(prior.Flat());
+    double below10 = 0;
+    for (size_t i = 0; i != 10000; ++i)
+      below10 += prior(rGen) < 10;
+    CHECK(below10 / 10000 == Approx(0.5).margin(0.02));
+    CHECK(ReweightedMean(prior, rGen) == Approx(50.5).margin(0.5));
+  }
+
+  SECTION("normal") {
+    auto prior = Prior("x", {"normal", "1", "2"});
+    REQUIRE_THROWS_WITH(prior.Min(), Contains("does not have a bounded range"));
+
+    auto truncated = Prior("x", {"normal", "0", "0.5", "0", "1"});
+    for (size_t i = 0; i != 1000; ++i) {
+      const double x = truncated(rGen);
+      REQUIRE(x >= 0);
+      REQUIRE(x <= 1);
+    }
+    CHECK(ReweightedMean(truncated, rGen) == Approx(0.5).margin(0.01));
+  }
+
+  SECTION("set") {
+    auto prior = Prior("type", {"set", "1", "2", "2", "4"}, true);
+    REQUIRE(prior.Min() == 1);
+    REQUIRE(prior.Max() == 4);
+    size_t n2 = 0;
+    for (size_t i = 0; i != 10000; ++i) {
+      const double t = prior(rGen);
+      REQUIRE((t == 1 || t == 2 || t == 4));
+      if (t == 2) {
+        ++n2;
+        REQUIRE(prior.Jacobian() == 2);
+      } else {
+        REQUIRE(prior.Jacobian() == 4);
+      }
+    }
+    CHECK(n2 / 10000. == Approx(0.5).margin(0.02));
+  }
+
+  SECTION("derived") {
+    auto mA = Prior("mA", {"100", "200"});
+    auto mHp = Prior("mHp", {"diff", "mA", "-10", "10"});
+    auto ratio = Prior("mH", {"ratio", "mA", "log", "1", "2"});
+    REQUIRE(mHp.ReferenceName() == "mA");
+    REQUIRE_THROWS_WITH(mHp.Min(), Contains("does not have a bounded range"));
+    mHp.SetReference(mA);
+    ratio.SetReference(mA);
+    REQUIRE_THROWS_WITH(mHp.SetReference(ratio), Contains("Wrong reference"));
+    REQUIRE_THROWS_WITH(mHp(rGen), Contains("has to be drawn first"));
+
+    for (size_t i = 0; i != 1000; ++i) {
+      const double a = mA(rGen);
+      const double hp = mHp(rGen);
+      const double h = ratio(rGen);
+      REQUIRE(std::abs(hp - a) <= 10);
+      REQUIRE(h / a >= 1);
+      REQUIRE(h / a <= 2);
+      REQUIRE(mHp.Jacobian() == Approx(20));
+      REQUIRE(ratio.Jacobian() == Approx(h * std::log(2)));
+    }
+    REQUIRE(mHp.Flat());
+    REQUIRE_FALSE(ratio.Flat());
+  }
+
+  SECTION("errors") {
+    REQUIRE_THROWS_WITH(Prior("x", {"2", "1"}), Contains("min > max"));
+    REQUIRE_THROWS_WITH(Prior("x", {"1"}), Contains("wrong number of values"));
+    REQUIRE_THROWS_WITH(Prior("x", {"1", "2", "3"}),
+                        Contains("wrong number of values"));
+    REQUIRE_THROWS_WITH(Prior("x", {"log", "0", "1"}),
+                        Contains("requires 0 < min <= max"));
+    REQUIRE_THROWS_WITH(Prior("x", {"normal", "0", "-1"}),
+                        Contains("width has to be positive"));
+    REQUIRE_THROWS_WITH(Prior("x", {"normal", "0", "1", "20", "30"}),
+                        Contains("too far in the tails"));
+    REQUIRE_THROWS_WITH(Prior("x", {"cauchy", "0", "1"}),
+                        Contains("could not convert cauchy"));
+    REQUIRE_THROWS_WITH(Prior("x", {"diff", "x", "0", "1"}),
+                        Contains("cannot be derived from itself"));
+    REQUIRE_THROWS_WITH(Prior("type", {"log", "1", "2"}, true),
+                        Contains("only uniform and set priors"));
+    REQUIRE_THROWS_WITH(Prior("type", {"0.5", "4"}, true),
+                        Contains("require integer values"));
+    REQUIRE_THROWS_WITH(Prior("type", {"set", "1", "2.5"}, true),
+                        Contains("require integer values"));
+    REQUIRE_NOTHROW(Prior("type", {"1e0", "4"}, true));
+  }
+}
@@ -1,9 +1,16 @@
 #include "ScannerS/Constants.hpp"
 #include "ScannerS/Constraints/STU.hpp"
+#include "ScannerS/DataMap.hpp"
 #include "ScannerS/Models/N2HDMBroken.hpp"
 #include "ScannerS/Models/R2HDM.hpp"
+#include "ScannerS/Tools/PointBatch.hpp"
 #include "catch.hpp"
 #include <Eigen/Core>
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <limits>
+#include <vector>
 
 TEST_CASE("Loop functions", "[STU][unit]") {
   using ScannerS::Constraints::STUDetail::F;
@@ -246,3 +253,242 @@ TEST_CASE("STU 2HDMC", "[unit][stu][r2hdm]") {
   CHECK(p.data["T"] == Approx(4.21066e-01).epsilon(0.04));
   CHECK(p.data["U"] == Approx(2.36319e-03).epsilon(0.04));
 }
+
+namespace {
+template <class Parameters> struct STUTestModel {
+  static constexpr int nHzero = 3;
+  static constexpr int nHplus = 1;
+  struct ParameterPoint {
+    Parameters in;
+    ScannerS::DataMap data;
+  };
+  static Parameters STUInput(const ParameterPoint &p) { return p.in; }
+  static bool EWPValid(const ParameterPoint &) { return true; }
+};
+
+// the 2HDMC point from above in the Higgs basis conventions of 0802.4353
+template <class Parameters> Parameters TwoHDMParameters() {
+  const double ca = std::cos(0.1), sa = std::sin(0.1);
+  const double cb = std::cos(1.), sb = std::sin(1.);
+  const auto I = std::complex<double>{0, 1};
+  Parameters in;
+  in.mV.resize(2, 4);
+  in.mV << I * cb, -sa, ca, -I * sb, I * sb, ca, sa, I * cb;
+  in.mU.resize(2, 2);
+  in.mU << cb, -sb, sb, cb;
+  in.mHzero = {125.09, 300, 400};
+  in.mHcharged = {500};
+  return in;
+}
+} // namespace
+
+TEST_CASE("STU fixed size input", "[unit][stu]") {
+  using namespace ScannerS::Constraints;
+  using Fixed = STUDetail::FixedSTUParameters<2, 4, 2>;
+  using Dynamic = STUDetail::STUParameters;
+
+  STU<STUTestModel<Fixed>> stuFixed{Severity::apply};
+  STU<STUTestModel<Dynamic>> stuDynamic{Severity::apply};
+  STUTestModel<Fixed>::ParameterPoint pFixed{TwoHDMParameters<Fixed>(), {}};
+  STUTestModel<Dynamic>::ParameterPoint pDynamic{TwoHDMParameters<Dynamic>(),
+                                                 {}};
+  stuFixed(pFixed);
+  stuDynamic(pDynamic);
+  for (auto par : {"S", "T", "U"})
+    CHECK(pFixed.data[par] == Approx(pDynamic.data[par]).epsilon(1e-12));
+  CHECK(pFixed.data["S"] == Approx(2.40759e-03).epsilon(0.04));
+  CHECK(pFixed.data["T"] == Approx(4.21066e-01).epsilon(0.04));
+  CHECK(pFixed.data["U"] == Approx(2.36319e-03).epsilon(0.04));
+
+  Dynamic wrongSize = TwoHDMParameters<Dynamic>();
+  wrongSize.mHzero.pop_back();
+  STUTestModel<Dynamic>::ParameterPoint pWrong{wrongSize, {}};
+  CHECK_THROWS(stuDynamic(pWrong));
+}
+
+TEST_CASE("STU R2HDM batch columns", "[unit][stu][r2hdm]") {
+  using namespace ScannerS::Constraints;
+  using ScannerS::Models::R2HDM;
+  using Fixed = STUDetail::FixedSTUParameters<2, 4, 2>;
+
+  // the 2HDMC point with the CP-even states in both input orders
+  const auto in = std::vector<R2HDM::AngleInput>{
+      {300, 125.09, 400, 500, 0.1, std::tan(1.), 1000, R2HDM::Yuk::typeI,
+       ScannerS::Constants::vEW},
+      {125.09, 300, 400, 500, 0.1 - ScannerS::Constants::pi / 2., std::tan(1.),
+       1000, R2HDM::Yuk::typeI, ScannerS::Constants::vEW}};
+  auto cols = R2HDM::BatchColumns{};
+  R2HDM::FillBatch(in, cols);
+
+  STU<STUTestModel<Fixed>> stu{Severity::apply};
+  STUTestModel<Fixed>::ParameterPoint ref{TwoHDMParameters<Fixed>(), {}};
+  stu(ref);
+  for (size_t i = 0; i != in.size(); ++i) {
+    STUTestModel<Fixed>::ParameterPoint p{R2HDM::STUInput(cols, i), {}};
+    stu(p);
+    for (auto par : {"S", "T", "U"})
+      CHECK(p.data[par] == Approx(ref.data[par]).epsilon(1e-12));
+  }
+}
+
+TEST_CASE("Vectorized loop functions", "[STU][unit]") {
+  namespace STUDetail = ScannerS::Constraints::STUDetail;
+
+  SECTION("Atan") {
+    Eigen::ArrayXd x(12);
+    x << 0., 1e-10, 0.3, -0.5, 0.66, 0.7, 1., -2.4, 2.5, 30., -1e8,
+        std::numeric_limits<double>::infinity();
+    const Eigen::ArrayXd res = STUDetail::Atan(x);
+    for (Eigen::Index i = 0; i != x.size(); ++i)
+      CHECK(res[i] == Approx(std::atan(x[i])).epsilon(1e-15));
+  }
+
+  Eigen::ArrayXd I(6), J(6), Q(6);
+  I << 100, 200, 300, 1e4, 125.09 * 125.09, 8e4;
+  J << 100.0001, 120, 290, 1e4 + 1e-5, 300 * 300, 1e3;
+  Q << 91.1876 * 91.1876, 10, 500, 80.379 * 80.379, 91.1876 * 91.1876, 8e4;
+  SECTION("F") {
+    const Eigen::ArrayXd res = STUDetail::F(I, J);
+    for (Eigen::Index i = 0; i != I.size(); ++i)
+      CHECK(res[i] == Approx(STUDetail::F(I[i], J[i])).epsilon(1e-12));
+  }
+  SECTION("FuncF") {
+    Eigen::ArrayXd r(6);
+    r << 70, 1e-5, -123, -1e-5, 1e6, -1e6;
+    const Eigen::ArrayXd res = STUDetail::FuncF(I, r);
+    for (Eigen::Index i = 0; i != I.size(); ++i)
+      CHECK(res[i] == Approx(STUDetail::FuncF(I[i], r[i])).epsilon(1e-12));
+  }
+  SECTION("G") {
+    const Eigen::ArrayXd res = STUDetail::G(I, J, Q);
+    for (Eigen::Index i = 0; i != I.size(); ++i)
+      CHECK(res[i] == Approx(STUDetail::G(I[i], J[i], Q[i])).epsilon(1e-12));
+  }
+  SECTION("G2") {
+    const Eigen::ArrayXd res = STUDetail::G2(I, Q);
+    for (Eigen::Index i = 0; i != I.size(); ++i)
+      CHECK(res[i] == Approx(STUDetail::G2(I[i], Q[i])).epsilon(1e-12));
+  }
+}
+
+TEST_CASE("STU batch", "[unit][stu]") {
+  using namespace ScannerS::Constraints;
+  using Parameters = STUDetail::FixedSTUParameters<2, 4, 2>;
+  using Model = STUTestModel<Parameters>;
+
+  auto points = std::vector<Model::ParameterPoint>{};
+  for (double mHp : {90., 300., 500., 800.}) {
+    auto in = TwoHDMParameters<Parameters>();
+    in.mHcharged = {mHp};
+    points.push_back({in, {}});
+  }
+  auto reference = points;
+
+  SECTION("apply") {
+    STU<Model> stu{Severity::apply};
+    const auto result = stu.ApplyBatch(points);
+    REQUIRE(result.size() == points.size());
+    for (size_t i = 0; i != points.size(); ++i) {
+      CHECK(result[i] == stu(reference[i]));
+      for (auto par : {"S", "T", "U", "STU_chisq"})
+        CHECK(points[i].data[par] ==
+              Approx(reference[i].data[par]).epsilon(1e-8));
+    }
+  }
+
+  SECTION("ignore") {
+    STU<Model> stu{Severity::ignore};
+    const auto result = stu.ApplyBatch(points);
+    for (size_t i = 0; i != points.size(); ++i) {
+      CHECK(result[i]);
+      stu(reference[i]);
+      CHECK(points[i].data["valid_STU"] == reference[i].data["valid_STU"]);
+    }
+  }
+
+  SECTION("skip") {
+    STU<Model> stu{Severity::skip};
+    const auto result = stu.ApplyBatch(points);
+    CHECK(result == std::vector<bool>(points.size(), true));
+    CHECK_FALSE(points.front().data.Contains("S"));
+  }
+}
+
+namespace {
+// a model with PointBatch support, whose points differ in the charged mass
+struct STUBatchModel {
+  static constexpr int nHzero = 3;
+  static constexpr int nHplus = 1;
+  using Parameters =
+      ScannerS::Constraints::STUDetail::FixedSTUParameters<2, 4, 2>;
+  struct AngleInput {
+    double mHp;
+  };
+  struct ParameterPoint {
+    explicit ParameterPoint(const AngleInput &in) : mHp{in.mHp} {}
+    double mHp;
+    ScannerS::DataMap data;
+  };
+  struct BatchColumns {
+    std::vector<double> mHp;
+  };
+  static void FillBatch(const std::vector<AngleInput> &in,
+                        BatchColumns &cols) {
+    cols.mHp.clear();
+    for (const auto &x : in)
+      cols.mHp.push_back(x.mHp);
+  }
+  static Parameters STUInput(double mHp) {
+    auto in = TwoHDMParameters<Parameters>();
+    in.mHcharged = {mHp};
+    return in;
+  }
+  static Parameters STUInput(const ParameterPoint &p) {
+    return STUInput(p.mHp);
+  }
+  static Parameters STUInput(const BatchColumns &cols, size_t i) {
+    return STUInput(cols.mHp[i]);
+  }
+  static bool EWPValid(const ParameterPoint &) { return true; }
+};
+} // namespace
+
+TEST_CASE("STU point batch", "[unit][stu]") {
+  using namespace ScannerS::Constraints;
+  using Model = STUBatchModel;
+  const auto inputs =
+      std::vector<Model::AngleInput>{{90.}, {300.}, {500.}, {800.}, {1200.}};
+  auto batch = ScannerS::Tools::PointBatch<Model>{inputs};
+  // the first candidate was removed by an earlier filter
+  batch.Filter([](const auto &, size_t i) { return i != 0; });
+
+  for (auto severity : {Severity::apply, Severity::ignore, Severity::skip}) {
+    auto current = batch;
+    STU<Model> stu{severity};
+    STU<Model> reference{severity};
+    const auto nKept = stu.ApplyBatch(current);
+    REQUIRE(nKept == current.Survivors().size());
+
+    size_t nPassed = 0;
+    for (auto i : batch.Survivors()) {
+      auto ref = Model::ParameterPoint{inputs[i]};
+      const bool passed = reference(ref);
+      nPassed += passed;
+      const auto &kept = current.Survivors();
+      if (std::find(kept.begin(), kept.end(), i) == kept.end()) {
+        CHECK_FALSE(passed);
+        continue;
+      }
+      auto p = current.Materialize(i);
+      CHECK(stu.BatchResult(p, i) == passed);
+      for (auto par : {"S", "T", "U", "STU_chisq", "valid_STU"}) {
+        REQUIRE(p.data.Contains(par) == ref.data.Contains(par));
+        if (ref.data.Contains(par))
+          CHECK(p.data[par] == Approx(ref.data[par]).epsilon(1e-8));
+      }
+    }
+    CHECK(nKept == nPassed);
+    if (severity == Severity::apply)
+      CHECK(nKept < batch.Survivors().size());
+  }
+}
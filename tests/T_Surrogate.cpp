@@ -0,0 +1,149 @@
+#include "ScannerS/Tools/Surrogate.hpp"
+
+#include "ScannerS/Constraints/Constraint.hpp"
+#include "ScannerS/DataMap.hpp"
+#include "catch.hpp"
+#include <Eigen/Core>
+#include <array>
+#include <complex>
+#include <limits>
+#include <random>
+#include <sstream>
+#include <vector>
+
+using Catch::Matchers::Contains;
+using ScannerS::Tools::Surrogate;
+
+namespace {
+struct TestModel {
+  struct ParameterPoint {
+    double x;
+    double y;
+  };
+  static void SurrogateFeatures(const ParameterPoint &p,
+                                std::vector<double> &features) {
+    ScannerS::Tools::AssignFeatures(features, p.x, p.y);
+  }
+};
+using TestPoint = TestModel::ParameterPoint;
+bool Passes(const TestPoint &p) { return p.x < 0.2; }
+
+struct ConstraintModel {
+  struct ParameterPoint {
+    TestPoint point;
+    ScannerS::DataMap data;
+  };
+  static void SurrogateFeatures(const ParameterPoint &p,
+                                std::vector<double> &features) {
+    TestModel::SurrogateFeatures(p.point, features);
+  }
+};
+template <class Model>
+class TestConstraint
+    : public ScannerS::Constraints::Constraint<TestConstraint, Model> {
+public:
+  static constexpr auto constraintId = "SurrogateTest";
+  explicit TestConstraint(ScannerS::Constraints::Severity severity)
+      : ScannerS::Constraints::Constraint<TestConstraint, Model>{severity} {}
+  bool Apply(typename Model::ParameterPoint &p) { return Passes(p.point); }
+};
+enum class TestEnum { a, b, c };
+} // namespace
+
+TEST_CASE("Surrogate feature assignment", "[unit][surrogate]") {
+  auto data = ScannerS::DataMap{};
+  data.Store("surrogate_test_b", 4.);
+  data.Store("surrogate_test_a", 3.);
+  Eigen::Matrix2d mat;
+  mat << 5., 6., 7., 8.;
+
+  auto features = std::vector<double>{42., 43.};
+  features.reserve(16);
+  const auto *storage = features.data();
+  ScannerS::Tools::AssignFeatures(
+      features, 1.5, std::numeric_limits<double>::quiet_NaN(), TestEnum::c,
+      std::complex<double>{-1., 2.}, std::array<double, 2>{9., 10.}, mat);
+  REQUIRE(features == std::vector<double>{1.5, 0., 2., -1., 2., 9., 10., 5., 6.,
+                                          7., 8.});
+  CHECK(features.data() == storage);
+
+  ScannerS::Tools::AssignFeatures(features, data);
+  CHECK(features == std::vector<double>{3., 4.});
+  CHECK(features.data() == storage);
+}
+
+TEST_CASE("Surrogate classifier", "[unit][surrogate]") {
+  std::mt19937 rGen{42};
+  auto uniform = std::uniform_real_distribution<double>{0, 1};
+
+  SECTION("disabled") {
+    auto surrogate = Surrogate{Surrogate::Settings{}};
+    const auto state = rGen;
+    for (size_t i = 0; i != 1000; ++i) {
+      auto p = TestPoint{0.9, 0.5};
+      REQUIRE(surrogate.Evaluate<TestModel>(p, rGen));
+      REQUIRE_FALSE(surrogate.Record(Passes(p)));
+    }
+    REQUIRE(rGen == state);
+    REQUIRE(surrogate.Stats().evaluated == 0);
+  }
+
+  SECTION("skips predicted failures") {
+    auto settings = Surrogate::Settings{};
+    settings.enabled = true;
+    settings.minTraining = 200;
+    settings.maxTraining = 1000;
+    settings.auditFraction = 0.1;
+    auto surrogate = Surrogate{settings};
+
+    size_t nPassed = 0;
+    size_t nTrue = 0;
+    for (size_t i = 0; i != 10000; ++i) {
+      auto p = TestPoint{uniform(rGen), uniform(rGen)};
+      nTrue += Passes(p);
+      if (!surrogate.Evaluate<TestModel>(p, rGen))
+        continue;
+      nPassed += surrogate.Record(Passes(p));
+    }
+    const auto &stats = surrogate.Stats();
+    REQUIRE(stats.evaluated + stats.skipped == 10000);
+    REQUIRE(stats.passed == nPassed);
+    // most of the failing points are skipped
+    CHECK(stats.skipped > 6000);
+    CHECK(static_cast<double>(stats.audited) /
+              static_cast<double>(stats.audited + stats.skipped) ==
+          Approx(0.1).margin(0.02));
+    // and almost all valid points are kept
+    CHECK(nPassed > 0.97 * nTrue);
+    CHECK(surrogate.FalseRejectionRate() < 0.03);
+
+    auto os = std::ostringstream{};
+    surrogate.PrintStatistics(os);
+    CHECK_THAT(os.str(), Contains("Surrogate statistics"));
+  }
+
+  SECTION("records the results of ignored constraints") {
+    auto settings = Surrogate::Settings{};
+    settings.enabled = true;
+    auto surrogate = Surrogate{settings};
+    auto constraint = TestConstraint<ConstraintModel>{
+        ScannerS::Constraints::Severity::ignore};
+    for (double x : {0.1, 0.5, 0.9}) {
+      auto p = ConstraintModel::ParameterPoint{{x, 0.5}, {}};
+      REQUIRE(surrogate.Evaluate<ConstraintModel>(p, rGen));
+      REQUIRE(surrogate.Record(constraint, p));
+      CHECK(p.data["valid_SurrogateTest"] == Passes(p.point));
+    }
+    CHECK(surrogate.Stats().evaluated == 3);
+    CHECK(surrogate.Stats().passed == 1);
+  }
+
+  SECTION("invalid settings") {
+    auto settings = Surrogate::Settings{};
+    settings.confidence = 0;
+    REQUIRE_THROWS_WITH(Surrogate{settings}, Contains("confidence"));
+    settings = Surrogate::Settings{};
+    settings.k = 1000;
+    REQUIRE_THROWS_WITH(Surrogate{settings}, Contains("k <= minTraining"));
+  }
+}
@@ -1,6 +1,14 @@
 #include "ScannerS/Tools/SushiTables.hpp"
+#include "ScannerS/Tools/SushiTablesData.hpp"
+#include "ScannerS/Tools/UniformSpline.hpp"
+#include "ScannerS/config.h"
 
 #include "catch.hpp"
+#include <cstddef>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
 
 TEST_CASE("SusHiTables", "[unit][cxn]") {
   using ScannerS::Tools::SushiTables;
@@ -77,3 +85,33 @@ TEST_CASE("SusHiTables", "[unit][cxn]") {
             Approx(cxns.BBo(33, 0.7, SushiTables::Collider::TEV)));
   }
 }
+
+TEST_CASE("embedded SusHi tables", "[unit][cxn]") {
+  using namespace ScannerS::Tools;
+  REQUIRE(&SharedSushiTables() == &SharedSushiTables());
+  CHECK(SharedSushiTables().GGe(125.09, 1, 1, SushiTables::Collider::LHC13) ==
+        Approx(43.765292327836285));
+
+  std::ifstream file{SCANNERS_DATA_DIR "/ggH_bbH.dat"};
+  REQUIRE(file.good());
+  std::vector<std::vector<double>> lines;
+  for (std::string line; std::getline(file, line);) {
+    std::istringstream values{line};
+    auto &row = lines.emplace_back();
+    for (double value; values >> value;)
+      row.push_back(value);
+  }
+  REQUIRE(lines.size() == SushiTablesData::nSplines + 1);
+  REQUIRE(lines[0].size() == SushiTablesData::nPoints);
+  const auto grid = UniformGrid{lines[0]};
+  for (std::size_t i = 0; i != SushiTablesData::nSplines; ++i) {
+    const auto spline = UniformSpline{grid, lines[i + 1]};
+    const auto *embedded =
+        SushiTablesData::coefficients + i * (SushiTablesData::nPoints + 1);
+    for (const auto &c : spline.AllCoefficients()) {
+      CHECK(c.y == embedded->y);
+      CHECK(c.a == embedded->a);
+      ++embedded;
+    }
+  }
+}
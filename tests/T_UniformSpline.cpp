@@ -0,0 +1,157 @@
+#include "ScannerS/Tools/Spline.hpp"
+#include "ScannerS/Tools/UniformSpline.hpp"
+
+#include "catch.hpp"
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+// the mass grid of the SusHi tables
+std::vector<double> SushiGrid() {
+  auto x = std::vector<double>{};
+  for (double m = 10; m < 150; m += 2.5)
+    x.push_back(m);
+  for (double m = 150; m < 500; m += 5)
+    x.push_back(m);
+  for (double m = 500; m <= 3000; m += 25)
+    x.push_back(m);
+  return x;
+}
+} // namespace
+
+TEST_CASE("UniformGrid", "[unit][spline]") {
+  using ScannerS::Tools::UniformGrid;
+  const auto grid = UniformGrid{SushiGrid()};
+  REQUIRE(grid.Points().size() == 227);
+  CHECK(grid.NBlocks() == 3);
+
+  CHECK(grid.Locate(5).index == 0);
+  CHECK(grid.Locate(5).h == Approx(-5));
+  CHECK(grid.Locate(10).index == 1);
+  CHECK(grid.Locate(11).index == 1);
+  CHECK(grid.Locate(11).h == Approx(1));
+  CHECK(grid.Locate(152).index == 57);
+  CHECK(grid.Locate(152).h == Approx(2));
+  CHECK(grid.Locate(3000).index == 227);
+  CHECK(grid.Locate(3100).index == 227);
+  CHECK(grid.Locate(3100).h == Approx(100));
+
+  CHECK_THROWS_AS(UniformGrid({1.}), std::runtime_error);
+  CHECK_THROWS_AS(UniformGrid({1., 3., 2.}), std::runtime_error);
+}
+
+TEST_CASE("UniformSpline", "[unit][spline]") {
+  using ScannerS::Tools::UniformGrid;
+  using ScannerS::Tools::UniformSpline;
+
+  const auto x = SushiGrid();
+  auto y = std::vector<double>{};
+  for (double m : x)
+    y.push_back(1e3 * std::exp(-m / 80.) + std::sin(m / 20.) / m);
+
+  auto reference = tk::spline{};
+  reference.set_points(x, y);
+  const auto spline = UniformSpline{UniformGrid{x}, y};
+
+  SECTION("matches tk::spline") {
+    auto points = std::vector<double>{1., 9.99};
+    for (double m = 10; m <= 3100; m += 0.37)
+      points.push_back(m);
+    points.insert(points.end(), x.begin(), x.end());
+    for (double m : points)
+      CHECK(spline(m) == Approx(reference(m)).epsilon(1e-12).margin(1e-12));
+  }
+
+  SECTION("batch evaluation") {
+    const auto points = std::vector<double>{3., 10., 125.09, 333.3, 2999.};
+    const auto result = spline.Evaluate(points);
+    REQUIRE(result.size() == points.size());
+    for (std::size_t i = 0; i != points.size(); ++i)
+      CHECK(result[i] == spline(points[i]));
+  }
+
+  SECTION("precomputed coefficients") {
+    const auto copy = UniformSpline{spline.Grid(), spline.AllCoefficients()};
+    CHECK(copy(412.3) == spline(412.3));
+    CHECK_THROWS_AS(
+        UniformSpline(UniformGrid{{1., 2., 3.}}, spline.AllCoefficients()),
+        std::runtime_error);
+  }
+
+  SECTION("exact for linear functions") {
+    const auto line = UniformSpline{UniformGrid{{0., 1., 2., 4., 6., 8.}},
+                                    {1., 3., 5., 9., 13., 17.}};
+    for (double v : {-1., 0.5, 2.5, 7., 10.})
+      CHECK(line(v) == Approx(2 * v + 1));
+  }
+
+  CHECK_THROWS_AS(UniformSpline(UniformGrid{x}, std::vector<double>(3, 1.)),
+                  std::runtime_error);
+}
+
+TEST_CASE("not-a-knot UniformSpline", "[unit][spline]") {
+  using ScannerS::Tools::UniformGrid;
+  using ScannerS::Tools::UniformSpline;
+  using ScannerS::Tools::UniformSpline2D;
+  constexpr auto notAKnot = UniformSpline::Boundary::notAKnot;
+
+  SECTION("matches scipy UnivariateSpline") {
+    const auto x = std::vector<double>{0, 0.5, 1, 2, 3, 3.5, 5, 6};
+    auto y = std::vector<double>{};
+    for (double v : x)
+      y.push_back(std::sin(v) + 0.1 * v * v);
+    const auto spline = UniformSpline{UniformGrid{x}, y, notAKnot};
+    // scipy.interpolate.UnivariateSpline(x, y, k=3, s=0)
+    CHECK(spline(-1.) == Approx(-0.772086000266178));
+    CHECK(spline(0.3) == Approx(0.30459625929257));
+    CHECK(spline(1.7) == Approx(1.27744705075558));
+    CHECK(spline(4.2) == Approx(0.926207734782259));
+    CHECK(spline(5.9) == Approx(3.0860439630741));
+    CHECK(spline(7.) == Approx(6.44454089487497));
+  }
+
+  SECTION("exact for cubic polynomials") {
+    auto cubic = [](double v) { return ((0.3 * v - 1.) * v + 2.) * v - 4.; };
+    const auto x = std::vector<double>{-2., -1., 0.5, 1., 3., 3.2};
+    auto y = std::vector<double>{};
+    for (double v : x)
+      y.push_back(cubic(v));
+    const auto spline = UniformSpline{UniformGrid{x}, y, notAKnot};
+    for (double v : {-3., -1.5, 0., 2., 3.1, 5.})
+      CHECK(spline(v) == Approx(cubic(v)));
+  }
+
+  SECTION("matches scipy RectBivariateSpline") {
+    const auto x = std::vector<double>{0, 1, 2, 3, 4};
+    const auto y = std::vector<double>{0, 0.5, 1, 2, 2.5, 3};
+    auto z = std::vector<double>{};
+    for (double a : x)
+      for (double b : y)
+        z.push_back(std::exp(-a * b / 4) + a * 0.3 - b * b * 0.1);
+    const auto spline =
+        UniformSpline2D{UniformGrid{x}, UniformGrid{y}, z, notAKnot};
+    // scipy.interpolate.RectBivariateSpline(x, y, z)
+    CHECK(spline(0.3, 0.7) == Approx(0.98987388638637));
+    CHECK(spline(2.5, 2.2) == Approx(0.518804353727207));
+    CHECK(spline(3.9, 0.1) == Approx(2.07682722842273));
+    // outside of the grid
+    CHECK(spline(5., 4.) == Approx(0.349787068367864));
+    CHECK(spline(-1., 1.3) == Approx(0.831));
+
+    const auto copy = UniformSpline2D{spline.GridX(), spline.GridY(),
+                                      spline.AllCoefficients()};
+    CHECK(copy(2.5, 2.2) == spline(2.5, 2.2));
+    CHECK_THROWS_AS(UniformSpline2D(spline.GridX(), spline.GridX(),
+                                    spline.AllCoefficients()),
+                    std::runtime_error);
+    CHECK_THROWS_AS(UniformSpline2D(UniformGrid{x}, UniformGrid{y},
+                                    std::vector<double>(29, 1.)),
+                    std::runtime_error);
+  }
+
+  CHECK_THROWS_AS(UniformSpline(UniformGrid{{1., 2., 3.}}, {1., 2., 3.},
+                                notAKnot),
+                  std::runtime_error);
+}
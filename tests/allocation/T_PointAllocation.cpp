@@ -0,0 +1,122 @@
+#include "ScannerS/Constants.hpp"
+#include "ScannerS/Constraints/Constraint.hpp"
+#include "ScannerS/Constraints/STU.hpp"
+#include "ScannerS/Constraints/Unitarity.hpp"
+#include "ScannerS/DataMap.hpp"
+#include "ScannerS/Models/R2HDM.hpp"
+#include "ScannerS/Tools/PointBatch.hpp"
+#include "catch.hpp"
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <random>
+#include <vector>
+
+namespace {
+std::atomic<std::size_t> nAllocations{0};
+}
+
+void *operator new(std::size_t size) {
+  ++nAllocations;
+  if (auto ptr = std::malloc(size == 0 ? 1 : size))
+    return ptr;
+  throw std::bad_alloc{};
+}
+void operator delete(void *ptr) noexcept { std::free(ptr); }
+void operator delete(void *ptr, std::size_t) noexcept { std::free(ptr); }
+
+namespace {
+struct TestModel {
+  struct ParameterPoint {
+    const std::array<double, 5> L;
+    ScannerS::DataMap data;
+  };
+  static double MaxUnitarityEV(const std::array<double, 5> &L) {
+    return L[0] + L[1];
+  }
+};
+} // namespace
+
+TEST_CASE("Allocation free DataMap reuse", "[unit][datamap]") {
+  using ScannerS::DataMap;
+  using namespace ScannerS::Constraints;
+  static const auto keyA = DataMap::Key{"alloc_a"};
+  static const auto keyB = DataMap::Key{"alloc_b"};
+  auto uni = Unitarity<TestModel>{Severity::ignore, 1.};
+
+  double sum = 0;
+  auto candidate = [&](size_t i) {
+    TestModel::ParameterPoint p{{0.1 * i, -0.5, 0, 0, 0}, {}};
+    uni(p);
+    p.data.Store(keyA, 1.);
+    p.data.Store(keyB, p.data[keyA] + 1);
+    sum += p.data[keyB] + p.data["valid_Uni"];
+  };
+  for (size_t i = 0; i != 10; ++i) // warm up
+    candidate(i);
+
+  const std::size_t before = nAllocations;
+  for (size_t i = 0; i != 1000; ++i)
+    candidate(i);
+  const std::size_t allocations = nAllocations - before;
+  REQUIRE(allocations == 0);
+  REQUIRE(sum > 0);
+
+  // unregistered keys still work but allocate
+  auto p = TestModel::ParameterPoint{{}, {}};
+  const std::size_t beforeUnregistered = nAllocations;
+  p.data.Store("alloc_unregistered_key_with_a_long_name", 1.);
+  REQUIRE(nAllocations > beforeUnregistered);
+}
+
+TEST_CASE("Allocation free R2HDM candidate screening", "[unit][r2hdm]") {
+  using namespace ScannerS;
+  using Model = Models::R2HDM;
+  using Constraints::Severity;
+  auto uni = Constraints::Unitarity<Model>{Severity::apply};
+  auto stu = Constraints::STU<Model>{Severity::apply};
+
+  // the candidate loop of ScannerS_R2HDM: blocks of inputs are screened on
+  // the columns of the batch and only survivors would be materialized
+  constexpr size_t blockSize = 256;
+  auto rGen = std::mt19937{42};
+  auto uniform = [&rGen](double a, double b) {
+    return std::uniform_real_distribution<double>{a, b}(rGen);
+  };
+  auto inputs = std::vector<Model::PhysicalInput>{};
+  auto batch = Tools::PointBatch<Model>{};
+  auto fill = [&]() {
+    inputs.clear();
+    for (size_t i = 0; i != blockSize; ++i)
+      inputs.push_back({125.09, uniform(400, 600), uniform(400, 600),
+                        uniform(400, 600), uniform(-0.1, 0.1), uniform(1, 5),
+                        uniform(3e4, 7e4), Model::Yuk::typeI,
+                        Constants::vEW});
+    batch.Assign(inputs);
+  };
+  auto screen = [&]() {
+    fill();
+    batch.Filter([&uni](const Model::BatchColumns &cols, size_t i) {
+      const auto L = cols.LAt(i);
+      return Model::BFB(L) && Model::MaxUnitarityEV(L) < uni.Limit();
+    });
+    return stu.ApplyBatch(batch);
+  };
+
+  // warm up with a block where STU is evaluated for every candidate, such
+  // that all storage has the capacity of a full block
+  fill();
+  stu.ApplyBatch(batch);
+  screen();
+
+  size_t nSurvivors = 0;
+  const std::size_t before = nAllocations;
+  for (size_t block = 0; block != 50; ++block)
+    nSurvivors += screen();
+  const std::size_t allocations = nAllocations - before;
+  REQUIRE(allocations == 0);
+  REQUIRE(nSurvivors > 0);
+  REQUIRE(nSurvivors < 50 * blockSize);
+}